@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace tonalcpp {
+namespace bench {
+
+/**
+ * A benchmark body. It must run the measured operation `iterations` times.
+ */
+using BenchmarkFunction = std::function<void(std::size_t iterations)>;
+
+/**
+ * A registered benchmark
+ */
+struct Benchmark {
+    std::string name;
+    BenchmarkFunction fn;
+};
+
+/**
+ * Get all registered benchmarks, in registration order
+ */
+std::vector<Benchmark>& registry();
+
+/**
+ * Register a benchmark (used by the TONAL_BENCHMARK macro)
+ * @return Always true, so it can initialize a static variable
+ */
+bool registerBenchmark(const std::string& name, BenchmarkFunction fn);
+
+/**
+ * Prevent the compiler from optimizing away a computed value
+ */
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static const void* volatile sink;
+    sink = &value;
+#endif
+}
+
+} // namespace bench
+} // namespace tonalcpp
+
+#define TONAL_BENCH_CONCAT_IMPL(a, b) a##b
+#define TONAL_BENCH_CONCAT(a, b) TONAL_BENCH_CONCAT_IMPL(a, b)
+#define TONAL_BENCHMARK_IMPL(name, fn)                                                     \
+    static void fn(std::size_t iterations);                                                \
+    static const bool TONAL_BENCH_CONCAT(fn, Registered) =                                 \
+        ::tonalcpp::bench::registerBenchmark(name, fn);                                    \
+    static void fn(std::size_t iterations)
+
+/**
+ * Define a benchmark. The body receives the number of `iterations` to run.
+ *
+ * @example
+ * TONAL_BENCHMARK("note/midi") {
+ *     for (std::size_t i = 0; i < iterations; i++) {
+ *         bench::doNotOptimize(note::midi("C4"));
+ *     }
+ * }
+ */
+#define TONAL_BENCHMARK(name) TONAL_BENCHMARK_IMPL(name, TONAL_BENCH_CONCAT(tonalBenchmark, __LINE__))
@@ -0,0 +1,51 @@
+#include "bench.h"
+#include "tonalcpp/chart.h"
+#include <string>
+#include <vector>
+
+using namespace tonalcpp;
+
+// 8192 lines of four bars of a jazz corpus: about 160 distinct symbols
+static const std::string& benchChart() {
+    static const std::string text = [] {
+        const std::vector<std::string> roots = {"C", "Db", "D", "Eb", "E", "F", "F#", "G", "Ab", "A", "Bb", "B"};
+        std::string result;
+        for (std::size_t line = 0; line < 8192; line++) {
+            const std::string& a = roots[line % 12];
+            const std::string& b = roots[(line + 5) % 12];
+            const std::string& c = roots[(line * 7) % 12];
+            result += "| " + a + "m7 " + b + "7 | " + c + "maj7 % | " + a + "m7b5 " + b + "7b9 | " + c + "6 |\n";
+        }
+        return result;
+    }();
+    return text;
+}
+
+static std::size_t chordCount() {
+    static const std::size_t count = chart::parse(benchChart()).events.size();
+    return count;
+}
+
+TONAL_BENCHMARK("chart/chord::get (per symbol)") {
+    const std::vector<std::string> symbols = {"Dm7", "G7", "Cmaj7", "F#m7b5", "B7b9", "Em6"};
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(chord::get(symbols[i % symbols.size()]));
+    }
+}
+
+TONAL_BENCHMARK("chart/parse (per chord)") {
+    const std::string& text = benchChart();
+    const std::size_t count = chordCount();
+    for (std::size_t i = 0; i < iterations; i += count) {
+        bench::doNotOptimize(chart::parse(text));
+    }
+}
+
+TONAL_BENCHMARK("chart/parse in parallel (per chord)") {
+    static thread_pool::ThreadPool pool;
+    const std::string& text = benchChart();
+    const std::size_t count = chordCount();
+    for (std::size_t i = 0; i < iterations; i += count) {
+        bench::doNotOptimize(chart::parse(text, {}, pool));
+    }
+}
@@ -0,0 +1,111 @@
+#include "bench.h"
+#include "tonalcpp/chord.h"
+#include "tonalcpp/chord_type.h"
+#include "tonalcpp/chord_detect.h"
+#include "tonalcpp/pcset.h"
+#include "tonalcpp/pitch_interval.h"
+#include "tonalcpp/pitch_note.h"
+#include "tonalcpp/scale.h"
+#include <string>
+#include <vector>
+
+using namespace tonalcpp;
+
+// See bench_pitch.cpp about the warm and cold variants
+
+static const std::vector<std::string> CHORDS = {"Cmaj7", "Dm7b5", "G7#9", "F#m11", "Bb13#11", "Eb/G", "Asus4", "x"};
+static const std::vector<std::vector<std::string>> CHORD_NOTES = {
+    {"C", "E", "G", "B"}, {"D", "F", "Ab", "C"}, {"E", "G", "C"}, {"F#", "A", "C#", "E", "B"}};
+static const std::vector<std::vector<std::string>> SCALE_NOTES = {
+    {"C", "D", "E", "F", "G", "A", "B"}, {"D", "E", "F", "G", "A", "Bb", "C#"}, {"C", "D", "E", "G", "A"}};
+
+static void clearCaches() {
+    pitch_note::clearCache();
+    pitch_interval::clearCache();
+    pcset::clearCache();
+}
+
+TONAL_BENCHMARK("chord/get (warm)") {
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(chord::get(CHORDS[i % CHORDS.size()]));
+    }
+}
+
+TONAL_BENCHMARK("chord/get (cold)") {
+    for (std::size_t i = 0; i < iterations; i++) {
+        clearCaches();
+        bench::doNotOptimize(chord::get(CHORDS[i % CHORDS.size()]));
+    }
+}
+
+TONAL_BENCHMARK("chord_detect/detect (warm)") {
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(chord_detect::detect(CHORD_NOTES[i % CHORD_NOTES.size()]));
+    }
+}
+
+TONAL_BENCHMARK("chord_detect/detect (cold)") {
+    for (std::size_t i = 0; i < iterations; i++) {
+        clearCaches();
+        bench::doNotOptimize(chord_detect::detect(CHORD_NOTES[i % CHORD_NOTES.size()]));
+    }
+}
+
+TONAL_BENCHMARK("scale/detect (warm)") {
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(scale::detect(SCALE_NOTES[i % SCALE_NOTES.size()]));
+    }
+}
+
+TONAL_BENCHMARK("scale/detect (cold)") {
+    for (std::size_t i = 0; i < iterations; i++) {
+        clearCaches();
+        bench::doNotOptimize(scale::detect(SCALE_NOTES[i % SCALE_NOTES.size()]));
+    }
+}
+
+// A vocabulary of 10240 chords: every pitch class set with a root, five times
+// with different names
+static const std::vector<chord_type::Definition>& vocabulary() {
+    static const std::vector<chord_type::Definition> definitions = [] {
+        const std::vector<std::string> intervals = {"2m", "2M", "3m", "3M", "4P", "4A", "5P", "6m", "6M", "7m", "7M"};
+        std::vector<chord_type::Definition> result;
+        for (int copy = 0; copy < 5; copy++) {
+            for (int set = 0; set < 2048; set++) {
+                chord_type::Definition definition;
+                definition.intervals.push_back("1P");
+                for (int i = 0; i < 11; i++) {
+                    if (set & (1 << i)) {
+                        definition.intervals.push_back(intervals[i]);
+                    }
+                }
+                const std::string name = std::to_string(copy) + "-" + std::to_string(set);
+                definition.name = "chord " + name;
+                definition.aliases = {"c" + name, "k" + name};
+                result.push_back(definition);
+            }
+        }
+        return result;
+    }();
+    return definitions;
+}
+
+TONAL_BENCHMARK("chord_type/addAll (10240 chords)") {
+    const auto& definitions = vocabulary();
+    for (std::size_t i = 0; i < iterations; i++) {
+        chord_type::removeAll();
+        bench::doNotOptimize(chord_type::addAll(definitions));
+    }
+    chord_type::initChordTypes();
+}
+
+TONAL_BENCHMARK("chord_type/add (10240 chords)") {
+    const auto& definitions = vocabulary();
+    for (std::size_t i = 0; i < iterations; i++) {
+        chord_type::removeAll();
+        for (const auto& definition : definitions) {
+            chord_type::add(definition.intervals, definition.aliases, definition.name);
+        }
+    }
+    chord_type::initChordTypes();
+}
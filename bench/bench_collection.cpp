@@ -0,0 +1,46 @@
+#include "bench.h"
+#include "tonalcpp/collection.h"
+#include <string>
+#include <vector>
+
+using namespace tonalcpp;
+
+static const std::vector<std::string> NOTES = {"C", "D", "E", "F", "G", "A", "B"};
+
+TONAL_BENCHMARK("collection/permutations 7 notes") {
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(collection::permutations(NOTES));
+    }
+}
+
+TONAL_BENCHMARK("collection/permutationsView 7 notes") {
+    for (std::size_t i = 0; i < iterations; i++) {
+        std::size_t count = 0;
+        for (const auto& perm : collection::permutationsView(NOTES)) {
+            count += perm.size();
+        }
+        bench::doNotOptimize(count);
+    }
+}
+
+TONAL_BENCHMARK("collection/combinationsView 7 choose 4") {
+    for (std::size_t i = 0; i < iterations; i++) {
+        std::size_t count = 0;
+        for (const auto& combination : collection::combinationsView(NOTES, 4)) {
+            count += combination.size();
+        }
+        bench::doNotOptimize(count);
+    }
+}
+
+TONAL_BENCHMARK("collection/shuffle std::rand") {
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(collection::shuffle(NOTES));
+    }
+}
+
+TONAL_BENCHMARK("collection/shuffle seeded") {
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(collection::shuffle(NOTES, i));
+    }
+}
@@ -0,0 +1,34 @@
+#include "bench.h"
+#include "tonalcpp/dictionary_file.h"
+#include <string>
+#include <vector>
+
+using namespace tonalcpp;
+
+static const std::vector<std::uint8_t>& chordTypes() {
+    static const std::vector<std::uint8_t> bytes = dictionary_file::compile(chord_type::all());
+    return bytes;
+}
+
+TONAL_BENCHMARK("dictionary_file/open (chord types)") {
+    const std::vector<std::uint8_t>& bytes = chordTypes();
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(dictionary_file::Dictionary(bytes.data(), bytes.size()).size());
+    }
+}
+
+TONAL_BENCHMARK("dictionary_file/find") {
+    const std::vector<std::uint8_t>& bytes = chordTypes();
+    const dictionary_file::Dictionary dictionary(bytes.data(), bytes.size());
+    const std::vector<std::string> keys = {"maj7", "m7b5", "7#11", "100010010001", "sus24"};
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(dictionary.indexOf(keys[i % keys.size()]));
+    }
+}
+
+TONAL_BENCHMARK("dictionary_file/chord_type::getChordType") {
+    const std::vector<std::string> keys = {"maj7", "m7b5", "7#11", "100010010001", "sus24"};
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(chord_type::getChordType(keys[i % keys.size()]));
+    }
+}
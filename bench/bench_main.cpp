@@ -0,0 +1,132 @@
+#include "bench.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace tonalcpp {
+namespace bench {
+
+std::vector<Benchmark>& registry() {
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+
+bool registerBenchmark(const std::string& name, BenchmarkFunction fn) {
+    registry().push_back({name, std::move(fn)});
+    return true;
+}
+
+struct Result {
+    double ns;               // Time per iteration
+    std::size_t iterations;  // Iterations of the measured run
+};
+
+// Run a benchmark with a growing number of iterations until it takes
+// at least minSeconds, then report the time per iteration
+static Result measure(const Benchmark& benchmark, double minSeconds) {
+    using Clock = std::chrono::steady_clock;
+    std::size_t iterations = 1;
+    
+    while (true) {
+        const auto start = Clock::now();
+        benchmark.fn(iterations);
+        const std::chrono::duration<double> elapsed = Clock::now() - start;
+        
+        if (elapsed.count() >= minSeconds || iterations >= (std::size_t(1) << 40)) {
+            return {elapsed.count() * 1e9 / static_cast<double>(iterations), iterations};
+        }
+        iterations *= elapsed.count() < minSeconds / 100 ? 10 : 2;
+    }
+}
+
+// Benchmark names as JSON strings
+static std::string jsonString(const std::string& str) {
+    std::string result = "\"";
+    for (char c : str) {
+        if (c == '"' || c == '\\') {
+            result += '\\';
+            result += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            result += escaped;
+        } else {
+            result += c;
+        }
+    }
+    return result + "\"";
+}
+
+} // namespace bench
+} // namespace tonalcpp
+
+static void usage(const char* program) {
+    std::printf("Usage: %s [--json] [--min-time=SECONDS] [--list] [FILTER]\n", program);
+    std::printf("  FILTER            only run the benchmarks whose name contains it\n");
+    std::printf("  --json            print the results as JSON\n");
+    std::printf("  --min-time=SECS   minimum measured time per benchmark (default 0.2)\n");
+    std::printf("  --list            print the benchmark names and exit (a JSON array of\n");
+    std::printf("                    names with --json)\n");
+}
+
+int main(int argc, char** argv) {
+    using namespace tonalcpp::bench;
+    
+    const char* filter = "";
+    bool json = false;
+    bool list = false;
+    double minSeconds = 0.2;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--json") == 0) {
+            json = true;
+        } else if (std::strcmp(argv[i], "--list") == 0) {
+            list = true;
+        } else if (std::strncmp(argv[i], "--min-time=", 11) == 0) {
+            minSeconds = std::atof(argv[i] + 11);
+        } else if (std::strcmp(argv[i], "--help") == 0) {
+            usage(argv[0]);
+            return 0;
+        } else if (argv[i][0] == '-') {
+            usage(argv[0]);
+            return 1;
+        } else {
+            filter = argv[i];
+        }
+    }
+    
+    bool first = true;
+    if (json) {
+        std::printf("{\n  \"context\": {\"library\": \"tonalcpp\", \"min_time\": %g},\n", minSeconds);
+        std::printf("  \"benchmarks\": [");
+    }
+    for (const auto& benchmark : registry()) {
+        if (std::strstr(benchmark.name.c_str(), filter) == nullptr) {
+            continue;
+        }
+        if (list) {
+            if (json) {
+                std::printf("%s\n    %s", first ? "" : ",", jsonString(benchmark.name).c_str());
+            } else {
+                std::printf("%s\n", benchmark.name.c_str());
+            }
+            first = false;
+            continue;
+        }
+        const Result result = measure(benchmark, minSeconds);
+        if (json) {
+            std::printf("%s\n    {\"name\": %s, \"ns_per_op\": %.3f, \"iterations\": %zu}",
+                        first ? "" : ",", jsonString(benchmark.name).c_str(), result.ns, result.iterations);
+            std::fflush(stdout);
+        } else {
+            std::printf("%-50s %12.2f ns/op\n", benchmark.name.c_str(), result.ns);
+        }
+        first = false;
+    }
+    if (json) {
+        std::printf("\n  ]\n}\n");
+    }
+    
+    return 0;
+}
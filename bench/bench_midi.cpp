@@ -0,0 +1,145 @@
+#include "bench.h"
+#include "tonalcpp/midi.h"
+#include "tonalcpp/note.h"
+#include <cmath>
+#include <string>
+#include <vector>
+
+using namespace tonalcpp;
+
+// Steps spread on both sides of the tonic, so both branches are exercised
+static std::vector<int> benchSteps() {
+    std::vector<int> steps(1024);
+    for (std::size_t i = 0; i < steps.size(); i++) {
+        steps[i] = static_cast<int>(i % 41) - 20;
+    }
+    return steps;
+}
+
+TONAL_BENCHMARK("midi/toMidi") {
+    const std::vector<std::string> notes = {"C4", "60", "Eb5", "F#2", "x"};
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(midi::toMidi(notes[i % notes.size()]));
+    }
+}
+
+TONAL_BENCHMARK("midi/midiToNoteName") {
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(midi::midiToNoteName(static_cast<int>(i % 128)));
+    }
+}
+
+TONAL_BENCHMARK("midi/midiToNoteHandle") {
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(midi::midiToNoteHandle(static_cast<int>(i % 128)));
+    }
+}
+
+TONAL_BENCHMARK("midi/pcsetSteps std::function") {
+    const auto steps = benchSteps();
+    const std::function<int(int)> fn = midi::pcsetSteps("101011010101", 60);
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(fn(steps[i % steps.size()]));
+    }
+}
+
+TONAL_BENCHMARK("midi/PcsetSteps") {
+    const auto steps = benchSteps();
+    const midi::PcsetSteps mapper("101011010101", 60);
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(mapper(steps[i % steps.size()]));
+    }
+}
+
+TONAL_BENCHMARK("midi/PcsetSteps batch (per step)") {
+    const auto steps = benchSteps();
+    std::vector<int> out(steps.size());
+    const midi::PcsetSteps mapper("101011010101", 60);
+    for (std::size_t i = 0; i < iterations; i += steps.size()) {
+        mapper(steps.data(), steps.size(), out.data());
+        bench::doNotOptimize(out.data());
+    }
+}
+
+TONAL_BENCHMARK("midi/pcsetDegrees std::function") {
+    const auto degrees = benchSteps();
+    const std::function<std::optional<int>(int)> fn = midi::pcsetDegrees("101011010101", 60);
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(fn(degrees[i % degrees.size()]));
+    }
+}
+
+TONAL_BENCHMARK("midi/PcsetDegrees") {
+    const auto degrees = benchSteps();
+    const midi::PcsetDegrees mapper("101011010101", 60);
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(mapper(degrees[i % degrees.size()]));
+    }
+}
+
+// Pitch tracker like input: a glide over the piano range
+static std::vector<float> benchFreqs() {
+    std::vector<float> freqs(4096);
+    for (std::size_t i = 0; i < freqs.size(); i++) {
+        freqs[i] = 27.5f * std::pow(2.0f, 7.0f * i / freqs.size());
+    }
+    return freqs;
+}
+
+TONAL_BENCHMARK("midi/freqToMidi scalar") {
+    const auto freqs = benchFreqs();
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(midi::freqToMidi(freqs[i % freqs.size()]));
+    }
+}
+
+TONAL_BENCHMARK("midi/freqToMidi batch (per value)") {
+    const auto freqs = benchFreqs();
+    std::vector<float> out(freqs.size());
+    for (std::size_t i = 0; i < iterations; i += freqs.size()) {
+        midi::freqToMidi(freqs.data(), freqs.size(), out.data());
+        bench::doNotOptimize(out.data());
+    }
+}
+
+TONAL_BENCHMARK("midi/midiToFreq scalar") {
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(midi::midiToFreq(static_cast<int>(i & 127), 442.0));
+    }
+}
+
+TONAL_BENCHMARK("midi/midiToFreq TuningTable") {
+    const midi::TuningTable table(442.0);
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(midi::midiToFreq(static_cast<int>(i & 127), table));
+    }
+}
+
+TONAL_BENCHMARK("midi/midiToFreq batch (per value)") {
+    std::vector<float> notes(4096);
+    for (std::size_t i = 0; i < notes.size(); i++) {
+        notes[i] = (i % 1280) / 10.0f;
+    }
+    std::vector<float> out(notes.size());
+    for (std::size_t i = 0; i < iterations; i += notes.size()) {
+        midi::midiToFreq(notes.data(), notes.size(), out.data());
+        bench::doNotOptimize(out.data());
+    }
+}
+
+TONAL_BENCHMARK("note/fromFreq") {
+    const auto freqs = benchFreqs();
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(note::fromFreq(freqs[i % freqs.size()]));
+    }
+}
+
+TONAL_BENCHMARK("note/fromFreqIds (per value)") {
+    const auto freqs = benchFreqs();
+    std::vector<int> ids(freqs.size());
+    std::vector<float> cents(freqs.size());
+    for (std::size_t i = 0; i < iterations; i += freqs.size()) {
+        note::fromFreqIds(freqs.data(), freqs.size(), ids.data(), cents.data());
+        bench::doNotOptimize(ids.data());
+    }
+}
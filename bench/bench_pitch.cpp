@@ -0,0 +1,170 @@
+#include "bench.h"
+#include "tonalcpp/intern.h"
+#include "tonalcpp/pcset.h"
+#include "tonalcpp/pitch_distance.h"
+#include "tonalcpp/pitch_interval.h"
+#include "tonalcpp/pitch_note.h"
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace tonalcpp;
+
+// Warm variants run on filled caches. Cold variants clear the caches before
+// each call, so they measure the parsing (plus the cost of the cache miss).
+
+static const std::vector<std::string> NOTES = {"C4", "Eb5", "F#3", "Bbb2", "G##6", "A", "db", "x"};
+static const std::vector<std::string> INTERVALS = {"3M", "5P", "-2m", "7M", "11A", "13m", "9b", "x"};
+static const std::vector<std::string> CHROMAS = {"101010110101", "100010010001", "101101010110", "000000000000"};
+
+TONAL_BENCHMARK("pitch_note/note (warm)") {
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(pitch_note::note(NOTES[i % NOTES.size()]));
+    }
+}
+
+TONAL_BENCHMARK("pitch_note/note (cold)") {
+    for (std::size_t i = 0; i < iterations; i++) {
+        pitch_note::clearCache();
+        bench::doNotOptimize(pitch_note::note(NOTES[i % NOTES.size()]));
+    }
+}
+
+// Notes as slices of a line of text (nothing is copied to look them up)
+static const std::string_view NOTE_LINE = "C4 Eb5 F#3 Bbb2 G##6 A db x";
+
+TONAL_BENCHMARK("pitch_note/note from a string_view (warm)") {
+    std::vector<std::string_view> slices;
+    for (std::size_t start = 0; start < NOTE_LINE.size();) {
+        const std::size_t end = std::min(NOTE_LINE.find(' ', start), NOTE_LINE.size());
+        slices.push_back(NOTE_LINE.substr(start, end - start));
+        start = end + 1;
+    }
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(pitch_note::note(slices[i % slices.size()]));
+    }
+}
+
+// Copies of parsed values (like the ones returned by the caches)
+TONAL_BENCHMARK("pitch_note/Note copy (per note)") {
+    std::vector<pitch_note::Note> notes;
+    for (const auto& name : NOTES) {
+        notes.push_back(pitch_note::note(name));
+    }
+    std::vector<pitch_note::Note> copies(notes.size());
+    for (std::size_t i = 0; i < iterations; i += notes.size()) {
+        std::copy(notes.begin(), notes.end(), copies.begin());
+        bench::doNotOptimize(copies.data());
+    }
+}
+
+TONAL_BENCHMARK("pitch_interval/Interval copy (per interval)") {
+    std::vector<pitch_interval::Interval> intervals;
+    for (const auto& name : INTERVALS) {
+        intervals.push_back(pitch_interval::interval(name));
+    }
+    std::vector<pitch_interval::Interval> copies(intervals.size());
+    for (std::size_t i = 0; i < iterations; i += intervals.size()) {
+        std::copy(intervals.begin(), intervals.end(), copies.begin());
+        bench::doNotOptimize(copies.data());
+    }
+}
+
+TONAL_BENCHMARK("pitch_note/tokenizeNote") {
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(pitch_note::tokenizeNote(NOTES[i % NOTES.size()]));
+    }
+}
+
+TONAL_BENCHMARK("intern/intern (existing names)") {
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(intern::intern(NOTES[i % NOTES.size()]));
+    }
+}
+
+TONAL_BENCHMARK("pitch_interval/interval (warm)") {
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(pitch_interval::interval(INTERVALS[i % INTERVALS.size()]));
+    }
+}
+
+TONAL_BENCHMARK("pitch_interval/interval (cold)") {
+    for (std::size_t i = 0; i < iterations; i++) {
+        pitch_interval::clearCache();
+        bench::doNotOptimize(pitch_interval::interval(INTERVALS[i % INTERVALS.size()]));
+    }
+}
+
+TONAL_BENCHMARK("pitch_distance/transpose (warm)") {
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(pitch_distance::transpose(NOTES[i % NOTES.size()],
+                                                       INTERVALS[i % INTERVALS.size()]));
+    }
+}
+
+TONAL_BENCHMARK("pitch_distance/transpose (cold)") {
+    for (std::size_t i = 0; i < iterations; i++) {
+        pitch_note::clearCache();
+        pitch_interval::clearCache();
+        bench::doNotOptimize(pitch_distance::transpose(NOTES[i % NOTES.size()],
+                                                       INTERVALS[i % INTERVALS.size()]));
+    }
+}
+
+TONAL_BENCHMARK("pitch_distance/distance (warm)") {
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(pitch_distance::distance(NOTES[i % NOTES.size()],
+                                                      NOTES[(i + 3) % NOTES.size()]));
+    }
+}
+
+TONAL_BENCHMARK("pitch_distance/distance (cold)") {
+    for (std::size_t i = 0; i < iterations; i++) {
+        pitch_note::clearCache();
+        pitch_interval::clearCache();
+        bench::doNotOptimize(pitch_distance::distance(NOTES[i % NOTES.size()],
+                                                      NOTES[(i + 3) % NOTES.size()]));
+    }
+}
+
+TONAL_BENCHMARK("pcset/getPcset chroma (warm)") {
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(pcset::getPcset(CHROMAS[i % CHROMAS.size()]));
+    }
+}
+
+TONAL_BENCHMARK("pcset/getPcset chroma (cold)") {
+    for (std::size_t i = 0; i < iterations; i++) {
+        pcset::clearCache();
+        bench::doNotOptimize(pcset::getPcset(CHROMAS[i % CHROMAS.size()]));
+    }
+}
+
+TONAL_BENCHMARK("pcset/getPcset notes (warm)") {
+    const std::vector<std::string> notes = {"C", "E", "G", "B", "D"};
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(pcset::getPcset(notes));
+    }
+}
+
+TONAL_BENCHMARK("pcset/getPcset notes (cold)") {
+    const std::vector<std::string> notes = {"C", "E", "G", "B", "D"};
+    for (std::size_t i = 0; i < iterations; i++) {
+        pitch_note::clearCache();
+        pcset::clearCache();
+        bench::doNotOptimize(pcset::getPcset(notes));
+    }
+}
+
+TONAL_BENCHMARK("pcset/notes") {
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(pcset::notes(CHROMAS[i % CHROMAS.size()]));
+    }
+}
+
+TONAL_BENCHMARK("pcset/noteHandles") {
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(pcset::noteHandles(CHROMAS[i % CHROMAS.size()]));
+    }
+}
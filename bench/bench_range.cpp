@@ -0,0 +1,51 @@
+#include "bench.h"
+#include "tonalcpp/range.h"
+#include <string>
+#include <vector>
+
+using namespace tonalcpp;
+
+static const std::vector<std::string> RANGE = {"C1", "C7", "E3", "G6"};
+
+TONAL_BENCHMARK("range/numeric") {
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(range::numeric(RANGE));
+    }
+}
+
+TONAL_BENCHMARK("range/numericView iterate") {
+    for (std::size_t i = 0; i < iterations; i++) {
+        int sum = 0;
+        for (int midi : range::numericView(RANGE)) {
+            sum += midi;
+        }
+        bench::doNotOptimize(sum);
+    }
+}
+
+TONAL_BENCHMARK("range/chromatic") {
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(range::chromatic(RANGE));
+    }
+}
+
+TONAL_BENCHMARK("range/chromaticView iterate") {
+    for (std::size_t i = 0; i < iterations; i++) {
+        std::size_t length = 0;
+        for (const std::string& name : range::chromaticView(RANGE)) {
+            length += name.size();
+        }
+        bench::doNotOptimize(length);
+    }
+}
+
+TONAL_BENCHMARK("range/numericView filter iterate") {
+    const auto view = range::numericView(RANGE);
+    for (std::size_t i = 0; i < iterations; i++) {
+        int sum = 0;
+        for (int midi : view.filter(0x091)) {
+            sum += midi;
+        }
+        bench::doNotOptimize(sum);
+    }
+}
@@ -0,0 +1,70 @@
+#include "bench.h"
+#include "tonalcpp/chord_detect.h"
+#include "tonalcpp/segmentation.h"
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace tonalcpp;
+
+// 4096 four-voice chords cycling a jazz turnaround in 12 keys, with a
+// melody note struck twice per chord
+static const smf::NoteEvents& benchEvents() {
+    static const smf::NoteEvents events = [] {
+        const std::vector<std::vector<int>> shapes = {{0, 4, 7, 11}, {9, 12, 16, 19}, {2, 5, 9, 12}, {7, 11, 14, 17}};
+        smf::NoteEvents result;
+        for (std::uint32_t c = 0; c < 4096; c++) {
+            const std::uint32_t tick = c * 960;
+            const int root = 36 + static_cast<int>((c / 4) % 12);
+            for (int interval : shapes[c % 4]) {
+                result.push_back(tick, 0, static_cast<std::uint8_t>(root + interval), 90, 0);
+            }
+            const auto melody = static_cast<std::uint8_t>(root + 24 + shapes[c % 4][c % 3 + 1]);
+            result.push_back(tick, 1, melody, 100, 1);
+            result.push_back(tick + 480, 1, melody, 0, 1);
+            result.push_back(tick + 480, 1, melody, 100, 1);
+            result.push_back(tick + 960, 1, melody, 0, 1);
+            for (int interval : shapes[c % 4]) {
+                result.push_back(tick + 960, 0, static_cast<std::uint8_t>(root + interval), 0, 0);
+            }
+        }
+        return result;
+    }();
+    return events;
+}
+
+TONAL_BENCHMARK("segmentation/chord_detect::detect") {
+    const std::vector<std::string> notes = {"C", "E", "G", "B"};
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(chord_detect::detect(notes));
+    }
+}
+
+TONAL_BENCHMARK("segmentation/ChordLabeler (memoized)") {
+    segmentation::ChordLabeler labeler;
+    const std::uint16_t mask = 0b100010010001;
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(labeler(mask, 0));
+    }
+}
+
+TONAL_BENCHMARK("segmentation/segment by onsets (per event)") {
+    const smf::NoteEvents& events = benchEvents();
+    segmentation::ChordLabeler labeler;
+    const segmentation::SegmentOptions options;
+    for (std::size_t i = 0; i < iterations; i += events.size()) {
+        bench::doNotOptimize(segmentation::segment(events, options, labeler));
+    }
+}
+
+TONAL_BENCHMARK("segmentation/segment by beats (per event)") {
+    const smf::NoteEvents& events = benchEvents();
+    segmentation::ChordLabeler labeler;
+    segmentation::SegmentOptions options;
+    options.slicing = segmentation::Slicing::Beats;
+    options.step = 480;
+    for (std::size_t i = 0; i < iterations; i += events.size()) {
+        bench::doNotOptimize(segmentation::segment(events, options, labeler));
+    }
+}
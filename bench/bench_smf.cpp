@@ -0,0 +1,68 @@
+#include "bench.h"
+#include "tonalcpp/smf.h"
+#include "tonalcpp/voicing.h"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+using namespace tonalcpp;
+
+// A format 1 file of 4 tracks with 32768 notes each (about 800 KB): running
+// status, short delta times and a few tempo meta events, as in real files
+static const std::vector<std::uint8_t>& benchFile() {
+    static const std::vector<std::uint8_t> bytes = [] {
+        const int tracks = 4;
+        const int notes = 32768;
+        std::vector<std::uint8_t> file = {'M', 'T', 'h', 'd', 0, 0, 0, 6, 0, 1, 0, tracks, 0x01, 0xE0};
+        for (int t = 0; t < tracks; t++) {
+            std::vector<std::uint8_t> track;
+            for (int n = 0; n < notes; n++) {
+                const std::uint8_t key = static_cast<std::uint8_t>(36 + (n * 7 + t * 12) % 60);
+                if (n % 4096 == 0) {
+                    // Tempo change, then the status byte again
+                    track.insert(track.end(), {0x00, 0xFF, 0x51, 0x03, 0x07, 0xA1, 0x20,
+                                               0x00, std::uint8_t(0x90 | t), key, 100});
+                } else {
+                    track.insert(track.end(), {0x00, key, 100});
+                }
+                track.insert(track.end(), {0x78, key, 0});
+            }
+            track.insert(track.end(), {0x00, 0xFF, 0x2F, 0x00});
+            const auto length = static_cast<std::uint32_t>(track.size());
+            file.insert(file.end(), {'M', 'T', 'r', 'k', std::uint8_t(length >> 24), std::uint8_t(length >> 16),
+                                     std::uint8_t(length >> 8), std::uint8_t(length)});
+            file.insert(file.end(), track.begin(), track.end());
+        }
+        return file;
+    }();
+    return bytes;
+}
+
+TONAL_BENCHMARK("smf/parse (per event)") {
+    const std::vector<std::uint8_t>& bytes = benchFile();
+    smf::MidiFile file;
+    smf::parse(bytes.data(), bytes.size(), file);
+    const std::size_t events = std::max<std::size_t>(file.events.size(), 1);
+    for (std::size_t i = 0; i < iterations; i += events) {
+        smf::parse(bytes.data(), bytes.size(), file);
+        bench::doNotOptimize(file.events.keys.data());
+    }
+}
+
+// A 16 bar progression of four-voice chords, written to memory: the cost
+// of a short rendered file, with the writer reused between files
+TONAL_BENCHMARK("smf/Writer progression (per file)") {
+    std::vector<voicing::Voicing> voicings(16);
+    for (std::size_t c = 0; c < voicings.size(); c++) {
+        voicings[c].size = 4;
+        for (std::uint8_t v = 0; v < 4; v++) {
+            voicings[c].midi[v] = static_cast<std::uint8_t>(48 + (c * 5) % 12 + v * 4);
+        }
+    }
+    smf::Writer writer;
+    for (std::size_t i = 0; i < iterations; i++) {
+        writer.clear();
+        writer.progression(0, voicings.data(), voicings.size(), 1920);
+        bench::doNotOptimize(writer.finish().data());
+    }
+}
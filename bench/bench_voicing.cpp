@@ -0,0 +1,193 @@
+#include "bench.h"
+#include "tonalcpp/pitch_interval.h"
+#include "tonalcpp/pitch_note.h"
+#include "tonalcpp/voicing.h"
+#include "tonalcpp/voicing_cache.h"
+#include "tonalcpp/voicing_generator.h"
+#include "tonalcpp/thread_pool.h"
+#include <string>
+#include <vector>
+
+using namespace tonalcpp;
+
+static const std::vector<std::string> CHORDS = {"C^7", "Dm7", "G7", "F#m7b5", "Bb6", "Ebo7"};
+
+TONAL_BENCHMARK("voicing/search") {
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(voicing::search(CHORDS[i % CHORDS.size()], {"E3", "G5"},
+                                             voicing_dictionary::all));
+    }
+}
+
+TONAL_BENCHMARK("voicing/search (cold)") {
+    for (std::size_t i = 0; i < iterations; i++) {
+        pitch_note::clearCache();
+        pitch_interval::clearCache();
+        bench::doNotOptimize(voicing::search(CHORDS[i % CHORDS.size()], {"E3", "G5"},
+                                             voicing_dictionary::all));
+    }
+}
+
+TONAL_BENCHMARK("voicing/sequence") {
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(voicing::sequence(CHORDS, {"E3", "G5"}, voicing_dictionary::all));
+    }
+}
+
+TONAL_BENCHMARK("voicing/searchMidi") {
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(voicing::searchMidi(CHORDS[i % CHORDS.size()], {"E3", "G5"},
+                                                 voicing_dictionary::all));
+    }
+}
+
+TONAL_BENCHMARK("voicing/VoicingCache searchMidi (warm)") {
+    voicing_cache::VoicingCache cache;
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(cache.searchMidi(CHORDS[i % CHORDS.size()], {"E3", "G5"},
+                                              voicing_dictionary::all));
+    }
+}
+
+TONAL_BENCHMARK("voicing/searchMidi core") {
+    const std::vector<voicing_dictionary::VoicingPattern> patterns = {
+        voicing_dictionary::compilePattern("3M 5P 7M 9M"),
+        voicing_dictionary::compilePattern("7M 9M 10M 12P"),
+    };
+    const std::vector<int> range = {52, 79};
+    std::vector<voicing::Voicing> out;
+    for (std::size_t i = 0; i < iterations; i++) {
+        out.clear();
+        voicing::searchMidi(static_cast<int>(i % 12) - 5, patterns.data(), patterns.size(), range, out);
+        bench::doNotOptimize(out.data());
+    }
+}
+
+TONAL_BENCHMARK("voicing/searchMidi custom dictionary") {
+    const voicing_dictionary::VoicingDictionary custom = voicing_dictionary::all;
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(voicing::searchMidi(CHORDS[i % CHORDS.size()], {"E3", "G5"}, custom));
+    }
+}
+
+TONAL_BENCHMARK("voicing/searchMidi compiled dictionary") {
+    const voicing_dictionary::CompiledDictionary compiled(voicing_dictionary::all);
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(voicing::searchMidi(CHORDS[i % CHORDS.size()], {"E3", "G5"}, compiled));
+    }
+}
+
+// Candidates of a 1000 chord progression (a ii-V-I cycle through all keys)
+static std::vector<std::vector<voicing::Voicing>> progression() {
+    const std::vector<std::string> tonics = {"C", "F", "Bb", "Eb", "Ab", "Db", "F#", "B", "E", "A", "D", "G"};
+    std::vector<std::vector<voicing::Voicing>> candidates;
+    for (std::size_t i = 0; candidates.size() < 1000; i++) {
+        const std::string& key = tonics[i % tonics.size()];
+        candidates.push_back(voicing::searchMidi(key + "m7", {"E3", "G5"}, voicing_dictionary::all));
+        candidates.push_back(voicing::searchMidi(key + "7", {"E3", "G5"}, voicing_dictionary::all));
+        candidates.push_back(voicing::searchMidi(key + "^7", {"E3", "G5"}, voicing_dictionary::all));
+    }
+    candidates.resize(1000);
+    return candidates;
+}
+
+TONAL_BENCHMARK("voicing/sequenceOptimal 1000 chords") {
+    const auto candidates = progression();
+    const voicing::SequenceWeights weights{1, 1, 2};
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(voicing::sequenceOptimal(candidates, weights));
+    }
+}
+
+TONAL_BENCHMARK("voice_leading/topNoteDiff") {
+    const auto voicings = voicing::search("Dm7", {"E3", "G5"}, voicing_dictionary::all);
+    const std::vector<std::string> last = {"C4", "E4", "G4", "B4"};
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(voice_leading::topNoteDiff(voicings, last));
+    }
+}
+
+TONAL_BENCHMARK("voice_leading/best TopNote") {
+    const auto voicings = voicing::searchMidi("Dm7", {"E3", "G5"}, voicing_dictionary::all);
+    const voicing::Voicing last = voicing::fromNames({"C4", "E4", "G4", "B4"});
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(voice_leading::best<voice_leading::TopNote>(last, voicings.data(), voicings.size()));
+    }
+}
+
+TONAL_BENCHMARK("voice_leading/scoreAll MinimalAssignment") {
+    const auto voicings = voicing::searchMidi("Dm7", {"E3", "G5"}, voicing_dictionary::all);
+    const voicing::Voicing last = voicing::fromNames({"C4", "E4", "G4", "B4"});
+    std::vector<int> scores(voicings.size());
+    for (std::size_t i = 0; i < iterations; i += voicings.size()) {
+        voice_leading::scoreAll<voice_leading::MinimalAssignment>(last, voicings.data(), voicings.size(), scores.data());
+        bench::doNotOptimize(scores.data());
+    }
+}
+
+// Songs built from the chords of the progression benchmark
+static std::vector<std::vector<std::string>> songs() {
+    const std::vector<std::string> tonics = {"C", "F", "Bb", "Eb", "Ab", "Db", "F#", "B", "E", "A", "D", "G"};
+    std::vector<std::vector<std::string>> result(512);
+    for (std::size_t s = 0; s < result.size(); s++) {
+        for (std::size_t c = 0; c < 32; c++) {
+            const std::string& key = tonics[(s + c / 3) % tonics.size()];
+            const char* types[] = {"m7", "7", "^7"};
+            result[s].push_back(key + types[c % 3]);
+        }
+    }
+    return result;
+}
+
+static void benchBatch(std::size_t iterations, std::size_t threads) {
+    const auto progressions = songs();
+    thread_pool::ThreadPool pool(threads);
+    const voicing_dictionary::CompiledDictionary& dictionary = *voicing_dictionary::builtin(voicing_dictionary::all);
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(voicing::sequenceOptimalBatch(progressions.data(), progressions.size(),
+                                                           {"E3", "G5"}, dictionary, pool));
+    }
+}
+
+TONAL_BENCHMARK("voicing/sequenceOptimalBatch 512 songs, 1 thread") {
+    benchBatch(iterations, 1);
+}
+
+TONAL_BENCHMARK("voicing/sequenceOptimalBatch 512 songs, all threads") {
+    benchBatch(iterations, 0);
+}
+
+TONAL_BENCHMARK("voicing_dictionary/lookup alias") {
+    const voicing_dictionary::VoicingDictionary custom = voicing_dictionary::all;
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(voicing_dictionary::lookup("-7", custom));
+    }
+}
+
+TONAL_BENCHMARK("voicing_dictionary/lookup alias (built-in)") {
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(voicing_dictionary::lookup("-7", voicing_dictionary::all));
+    }
+}
+
+TONAL_BENCHMARK("voicing_dictionary/CompiledDictionary build") {
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(voicing_dictionary::CompiledDictionary(voicing_dictionary::all));
+    }
+}
+
+TONAL_BENCHMARK("voicing_generator/generateMidi") {
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(voicing_generator::generateMidi(CHORDS[i % CHORDS.size()], {"E3", "G5"}));
+    }
+}
+
+TONAL_BENCHMARK("voicing_generator/generateMidi 6 voices, limit 8") {
+    voicing_generator::Constraints constraints;
+    constraints.minVoices = 5;
+    constraints.maxVoices = 6;
+    constraints.limit = 8;
+    for (std::size_t i = 0; i < iterations; i++) {
+        bench::doNotOptimize(voicing_generator::generateMidi("C13#11", {"C3", "C6"}, constraints));
+    }
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "tonalcpp/chord.h"
+#include "tonalcpp/thread_pool.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * A parser of plain text chord charts, for large lead sheet corpora:
+ *
+ *     # Autumn Leaves (A section)
+ *     | Cm7 F7 | Bbmaj7 % | Ebmaj7 | Am7b5 D7 |
+ *
+ * Bars are separated by "|" and by line ends (a line without "|" is a
+ * bar). The chords of a bar are separated by spaces and split its beats
+ * evenly. "%" repeats the previous chord, so a bar with only "%" repeats
+ * the last chord of the previous one. Empty bars and lines starting with
+ * "#" are ignored.
+ *
+ * The text is split at line ends into chunks parsed in parallel. Each
+ * distinct symbol is resolved with chord::get once per run, and the chords
+ * are stored as ids into the table of symbols.
+ */
+
+namespace tonalcpp {
+namespace chart {
+
+/**
+ * Options for parse and load
+ */
+struct ChartOptions {
+    int beatsPerBar = 4;
+    // Approximate size of the chunks of text parsed in parallel, in bytes
+    std::size_t chunkSize = 1 << 16;
+};
+
+/**
+ * The chords of a chart, as a structure of arrays: the same index in each
+ * array is one chord
+ */
+struct ChordEvents {
+    std::vector<std::uint32_t> bars;    // Bar of the chord (0 = first bar)
+    std::vector<std::uint8_t> beats;    // First beat of the chord in the bar (0 = downbeat)
+    std::vector<std::uint32_t> chords;  // Id of the chord symbol (see Chart)
+
+    std::size_t size() const { return chords.size(); }
+    bool empty() const { return chords.empty(); }
+
+    void push_back(std::uint32_t bar, std::uint8_t beat, std::uint32_t chord) {
+        bars.push_back(bar);
+        beats.push_back(beat);
+        chords.push_back(chord);
+    }
+
+    void reserve(std::size_t count) {
+        bars.reserve(count);
+        beats.reserve(count);
+        chords.reserve(count);
+    }
+
+    void resize(std::size_t count) {
+        bars.resize(count);
+        beats.resize(count);
+        chords.resize(count);
+    }
+};
+
+/**
+ * A parsed chart
+ */
+struct Chart {
+    bool empty = true;                  // True if the chart could not be read
+    std::uint32_t bars = 0;             // Number of bars
+    ChordEvents events;
+    std::vector<std::string> symbols;   // The distinct symbols, by id, in order of appearance
+    std::vector<chord::Chord> chords;   // The chord of each symbol, by id (empty if not valid)
+
+    /**
+     * The chord of an event
+     */
+    const chord::Chord& chord(std::size_t event) const { return chords[events.chords[event]]; }
+};
+
+/**
+ * Parse a chart
+ *
+ * @example
+ * const auto chart = chart::parse("| Dm7 G7 | Cmaj7 % |");
+ * chart.events.beats // => {0, 2, 0, 2}
+ * chart.symbols // => {"Dm7", "G7", "Cmaj7"}
+ *
+ * @param text The chart
+ * @param options The beats per bar and the chunk size
+ * @param pool The threads that parse the chunks and resolve the symbols
+ * @return The chart
+ */
+Chart parse(std::string_view text, const ChartOptions& options = {});
+Chart parse(std::string_view text, const ChartOptions& options, thread_pool::ThreadPool& pool);
+
+/**
+ * Load a chart from a text file, memory mapped (see parse)
+ *
+ * @param path The file path
+ * @return The chart (empty if the file can't be read)
+ */
+Chart load(const std::string& path, const ChartOptions& options = {});
+Chart load(const std::string& path, const ChartOptions& options, thread_pool::ThreadPool& pool);
+
+} // namespace chart
+} // namespace tonalcpp
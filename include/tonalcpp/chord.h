@@ -1,11 +1,14 @@
 #pragma once
 
+#include <memory_resource>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <array>
 #include <optional>
 #include <functional>
 #include "tonalcpp/chord_type.h"
+#include "tonalcpp/intern.h"
 #include "tonalcpp/pitch_note.h"
 
 namespace tonalcpp {
@@ -38,7 +41,7 @@ extern const Chord NoChord;
  * @param name The chord name to tokenize
  * @return An array with [tonic, type, bass]
  */
-ChordNameTokens tokenize(const std::string& name);
+ChordNameTokens tokenize(std::string_view name);
 
 /**
  * Helper function to handle bass note tokenization
@@ -47,15 +50,16 @@ ChordNameTokens tokenize(const std::string& name);
  * @param chord The chord part
  * @return Tokenized array
  */
-ChordNameTokens tokenizeBass(const std::string& note, const std::string& chord);
+ChordNameTokens tokenizeBass(std::string_view note, std::string_view chord);
 
 /**
- * Get a Chord from a chord name or tokens
+ * Get a Chord from a chord name or tokens. The name can be a slice of a
+ * larger buffer (like a token of a lead sheet): it's not copied.
  * 
  * @param src The chord name or array of tokens
  * @return Chord object
  */
-Chord get(const std::string& src);
+Chord get(std::string_view src);
 Chord get(const std::vector<std::string>& tokens);
 
 /**
@@ -66,14 +70,23 @@ Chord get(const std::vector<std::string>& tokens);
  * @param optionalBass Optional bass note
  * @return Chord object
  */
-Chord getChord(const std::string& typeName, 
-               const std::string& optionalTonic = "", 
-               const std::string& optionalBass = "");
+Chord getChord(std::string_view typeName, 
+               std::string_view optionalTonic = "", 
+               std::string_view optionalBass = "");
 
 /**
  * Alias for get function
  */
-inline Chord chord(const std::string& name) { return get(name); }
+inline Chord chord(std::string_view name) { return get(name); }
+
+/**
+ * Get the interned symbol of a chord (like get(name).symbol), to compare
+ * and hash chord symbols as integers
+ *
+ * @param name The chord name
+ * @return The handle of the chord symbol (empty if the chord is not valid)
+ */
+intern::Handle symbolHandle(std::string_view name);
 
 /**
  * Transpose a chord name
@@ -118,6 +131,19 @@ std::vector<std::string> reduced(const std::string& chordName);
 std::vector<std::string> notes(const std::string& chordName, const std::string& tonic = "");
 std::vector<std::string> notes(const std::vector<std::string>& tokens, const std::string& tonic = "");
 
+/**
+ * Same as notes, with the result allocated from a memory resource
+ *
+ * @param resource The memory resource of the result
+ * @param chordName The chord name
+ * @param tonic Optional tonic to use instead of the chord's tonic
+ * @return The notes of the chord
+ */
+std::pmr::vector<std::pmr::string> notes(
+    std::pmr::memory_resource* resource,
+    const std::string& chordName,
+    const std::string& tonic = "");
+
 /**
  * Get a note name from the chord by scale degree
  * 
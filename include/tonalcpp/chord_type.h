@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
 #include "tonalcpp/pcset.h"
@@ -40,7 +41,7 @@ using ChordTypeName = std::string;
  * @param type The chord type name, chroma, or setNum
  * @return The chord type object
  */
-ChordType getChordType(const std::string& type);
+ChordType getChordType(std::string_view type);
 ChordType getChordType(int type);
 
 /**
@@ -88,7 +89,47 @@ void add(const std::vector<std::string>& intervals,
          const std::string& fullName = "");
 
 /**
- * Add an alias for a chord
+ * A chord type to add with addAll (the arguments of add)
+ */
+struct Definition {
+    std::vector<std::string> intervals;
+    std::vector<std::string> aliases;
+    std::string name;
+};
+
+/**
+ * Add many chords to the dictionary at once. All the definitions are
+ * validated first: if any has no intervals or an invalid one, nothing is
+ * added. A chord with the same name and intervals as one in the dictionary
+ * (or defined before) is not added again: its new aliases are added to it.
+ * Unnamed chords are always added, as with add.
+ *
+ * The new dictionary is built aside and replaces the old one at once:
+ * lookups running meanwhile (from other threads too) find the old or the
+ * new chords, never a part of them, and a failure leaves it as it was.
+ *
+ * @example
+ * chord_type::addAll({{{"1P", "4A", "7m", "10M", "13M"}, {"myst"}, "mystic"}});
+ *
+ * @param definitions The chords to add
+ * @param count Number of chords
+ * @return Whether the chords were added
+ */
+bool addAll(const Definition* definitions, std::size_t count);
+bool addAll(const std::vector<Definition>& definitions);
+
+/**
+ * Add many chord types that are already built (like the entries of a
+ * dictionary file) at once, as addAll does with definitions. They are not
+ * validated nor parsed again.
+ *
+ * @param types The chord types to add
+ * @param count Number of chord types
+ */
+void addAll(const ChordType* types, std::size_t count);
+
+/**
+ * Add an alias for a chord of the dictionary
  * 
  * @param chord The chord type
  * @param alias The alias to add
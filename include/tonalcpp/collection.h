@@ -4,7 +4,13 @@
 #include <string>
 #include <functional>
 #include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
 #include <random>
+#include <utility>
 
 namespace tonalcpp {
 namespace collection {
@@ -96,7 +102,269 @@ std::vector<T> shuffle(std::vector<T> vec,
 }
 
 /**
- * Get all permutations of a vector
+ * A small and fast seedable pseudo random number generator (SplitMix64).
+ * It can be used with the standard library algorithms and distributions.
+ *
+ * @example
+ * Random random(42);
+ * random() // => always the same 64 bit number for seed 42
+ * random.uniform() // => a number in [0, 1)
+ */
+class Random {
+public:
+    using result_type = std::uint64_t;
+
+    explicit Random(std::uint64_t seed = 0) : state(seed) {}
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() {
+        std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    /**
+     * A number in [0, bound) (bound must be less than 2^32)
+     */
+    std::uint32_t below(std::uint32_t bound) {
+        return static_cast<std::uint32_t>(((*this)() >> 32) * bound >> 32);
+    }
+
+    /**
+     * A number in [0, 1)
+     */
+    double uniform() {
+        return ((*this)() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+private:
+    std::uint64_t state;
+};
+
+/**
+ * Randomizes the order of the specified vector, using the Fisher–Yates
+ * shuffle with a seeded Random generator. The same seed always gives the
+ * same order.
+ *
+ * @param vec The vector to shuffle
+ * @param seed The seed of the random number generator
+ * @return The shuffled vector
+ *
+ * @example
+ * shuffle(std::vector<std::string>{"C", "D", "E", "F"}, 42) // => [...]
+ */
+template<typename T>
+std::vector<T> shuffle(std::vector<T> vec, std::uint64_t seed) {
+    Random random(seed);
+    for (std::size_t m = vec.size(); m > 1; m--) {
+        using std::swap;
+        swap(vec[m - 1], vec[random.below(static_cast<std::uint32_t>(m))]);
+    }
+    return vec;
+}
+
+namespace detail {
+
+// Input iterator over the values of a generator: a class with
+// `const std::vector<T>& current() const` and `bool advance()`
+template<typename Generator>
+class GeneratorIterator {
+public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = typename std::decay<decltype(std::declval<Generator>().current())>::type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = const value_type&;
+
+    GeneratorIterator() = default;
+    explicit GeneratorIterator(Generator* generator) : generator(generator) {}
+
+    reference operator*() const { return generator->current(); }
+    pointer operator->() const { return &generator->current(); }
+    GeneratorIterator& operator++() {
+        if (!generator->advance()) {
+            generator = nullptr;
+        }
+        return *this;
+    }
+    void operator++(int) { ++*this; }
+    bool operator==(const GeneratorIterator& other) const { return generator == other.generator; }
+    bool operator!=(const GeneratorIterator& other) const { return generator != other.generator; }
+
+private:
+    Generator* generator = nullptr;  // nullptr at the end
+};
+
+} // namespace detail
+
+/**
+ * Lazy permutations of a vector: one permutation is kept at a time, so
+ * memory doesn't grow with the number of permutations and the iteration can
+ * stop at any moment. Same order as permutations (lexicographic, repeated
+ * values give unique permutations).
+ *
+ * Iterating again starts from the first permutation. Only one iteration at a
+ * time is possible, and each permutation is valid until the next one.
+ *
+ * @example
+ * for (const auto& perm : permutationsView(notes)) {
+ *     if (isGood(perm)) break;
+ * }
+ */
+template<typename T>
+class PermutationsView {
+public:
+    using iterator = detail::GeneratorIterator<PermutationsView>;
+
+    explicit PermutationsView(std::vector<T> vec) : items(std::move(vec)) {}
+
+    iterator begin() {
+        values = items;
+        std::sort(values.begin(), values.end());
+        return iterator(this);
+    }
+    iterator end() { return iterator(); }
+
+    const std::vector<T>& current() const { return values; }
+    bool advance() { return std::next_permutation(values.begin(), values.end()); }
+
+private:
+    std::vector<T> items;
+    std::vector<T> values;
+};
+
+/**
+ * Lazy k-combinations of a vector: the ways to choose k elements, keeping
+ * their order. Combinations are yielded in lexicographic order of the
+ * element positions. See PermutationsView about iterating.
+ *
+ * @example
+ * combinationsView({"a", "b", "c"}, 2) // => {"a", "b"}, {"a", "c"}, {"b", "c"}
+ */
+template<typename T>
+class CombinationsView {
+public:
+    using iterator = detail::GeneratorIterator<CombinationsView>;
+
+    CombinationsView(std::vector<T> vec, std::size_t k) : items(std::move(vec)), k(k) {}
+
+    iterator begin() {
+        if (k > items.size()) {
+            return end();
+        }
+        indexes.resize(k);
+        values.assign(items.begin(), items.begin() + k);
+        for (std::size_t i = 0; i < k; i++) {
+            indexes[i] = i;
+        }
+        return iterator(this);
+    }
+    iterator end() { return iterator(); }
+
+    const std::vector<T>& current() const { return values; }
+
+    bool advance() {
+        // Rightmost position that can still move right
+        const std::size_t n = items.size();
+        std::size_t i = k;
+        while (i > 0 && indexes[i - 1] == n - k + i - 1) {
+            i--;
+        }
+        if (i == 0) {
+            return false;
+        }
+        indexes[i - 1]++;
+        values[i - 1] = items[indexes[i - 1]];
+        for (std::size_t j = i; j < k; j++) {
+            indexes[j] = indexes[j - 1] + 1;
+            values[j] = items[indexes[j]];
+        }
+        return true;
+    }
+
+private:
+    std::vector<T> items;
+    std::size_t k;
+    std::vector<std::size_t> indexes;
+    std::vector<T> values;
+};
+
+/**
+ * Lazy subsets (power set) of a vector, keeping the order of the elements.
+ * Subset number i has the elements whose bit is set in i, starting from the
+ * empty set. Up to 63 elements. See PermutationsView about iterating.
+ *
+ * @example
+ * subsetsView({"a", "b"}) // => {}, {"a"}, {"b"}, {"a", "b"}
+ */
+template<typename T>
+class SubsetsView {
+public:
+    using iterator = detail::GeneratorIterator<SubsetsView>;
+
+    explicit SubsetsView(std::vector<T> vec) : items(std::move(vec)) {}
+
+    iterator begin() {
+        if (items.size() >= 64) {
+            return end();
+        }
+        mask = 0;
+        values.clear();
+        return iterator(this);
+    }
+    iterator end() { return iterator(); }
+
+    const std::vector<T>& current() const { return values; }
+
+    bool advance() {
+        if (++mask == (std::uint64_t(1) << items.size())) {
+            return false;
+        }
+        values.clear();
+        for (std::size_t i = 0; i < items.size(); i++) {
+            if (mask & (std::uint64_t(1) << i)) {
+                values.push_back(items[i]);
+            }
+        }
+        return true;
+    }
+
+private:
+    std::vector<T> items;
+    std::uint64_t mask = 0;
+    std::vector<T> values;
+};
+
+/**
+ * Lazy permutations of a vector (see PermutationsView)
+ */
+template<typename T>
+PermutationsView<T> permutationsView(std::vector<T> vec) {
+    return PermutationsView<T>(std::move(vec));
+}
+
+/**
+ * Lazy k-combinations of a vector (see CombinationsView)
+ */
+template<typename T>
+CombinationsView<T> combinationsView(std::vector<T> vec, std::size_t k) {
+    return CombinationsView<T>(std::move(vec), k);
+}
+
+/**
+ * Lazy subsets of a vector (see SubsetsView)
+ */
+template<typename T>
+SubsetsView<T> subsetsView(std::vector<T> vec) {
+    return SubsetsView<T>(std::move(vec));
+}
+
+/**
+ * Get all permutations of a vector. The number of permutations grows
+ * factorially: use permutationsView to iterate them without storing them.
  * 
  * @param vec The input vector
  * @return Vector containing all permutations
@@ -0,0 +1,258 @@
+#pragma once
+
+#include "tonalcpp/chord_type.h"
+#include "tonalcpp/helpers.h"
+#include "tonalcpp/scale_type.h"
+#include "tonalcpp/voicing_dictionary.h"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * A compact binary format for chord type, scale type and voicing
+ * dictionaries. A file is memory mapped and used in place: entries and
+ * lookups read the mapped bytes directly, nothing is parsed or copied when
+ * it's opened, and processes opening the same file share its pages.
+ *
+ * Layout (all integers little endian, sections 4 byte aligned):
+ * - Header (32 bytes): "TNLD", version (u16), kind (u16), then the number of
+ *   entries, hash slots, string references and voicing patterns, the size
+ *   of the string pool and a reserved word (u32 each)
+ * - Entries: 12 u32 each (name, set number, quality, chroma, normalized
+ *   chroma, and the ranges of intervals, aliases and patterns)
+ * - String references: offset and length (u32 each) into the string pool
+ * - Hash slots: key offset, key length and entry + 1 (u32 each; 0 = empty).
+ *   Open addressing with linear probing over a FNV-1a hash of the key
+ * - Voicing patterns: source reference (2 u32) and the compiled pattern
+ *   (20 bytes: size, bottom semitones and fifths, semitones and fifths of
+ *   voicing_dictionary::MAX_VOICES voices and a padding byte; a different
+ *   MAX_VOICES needs a new VERSION)
+ * - String pool: the distinct strings, not terminated
+ */
+
+namespace tonalcpp {
+namespace dictionary_file {
+
+/**
+ * Version of the format written by this library. Files of other versions
+ * can't be opened.
+ */
+constexpr std::uint16_t VERSION = 1;
+
+/**
+ * The dictionary stored in a file
+ */
+enum class Kind : std::uint16_t {
+    ChordTypes = 1,
+    ScaleTypes = 2,
+    Voicings = 3,
+};
+
+/**
+ * A list of strings of a dictionary file
+ */
+class Strings {
+public:
+    Strings() = default;
+    Strings(const std::uint8_t* refs, const char* pool, std::size_t count)
+        : refs(refs), pool(pool), count(count) {}
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    std::string_view operator[](std::size_t i) const;
+
+    /**
+     * Copy the strings
+     */
+    std::vector<std::string> toVector() const;
+
+private:
+    const std::uint8_t* refs = nullptr;
+    const char* pool = nullptr;
+    std::size_t count = 0;
+};
+
+class Dictionary;
+
+/**
+ * An entry of a dictionary file. The strings are views into the file: they
+ * are valid while the dictionary is open.
+ */
+class Entry {
+public:
+    /**
+     * The chord or scale type name, or the voicing symbol
+     */
+    std::string_view name() const;
+
+    // Chord and scale types
+    int setNum() const;
+    std::string_view chroma() const;
+    std::string_view normalized() const;
+    chord_type::ChordQuality quality() const;
+    Strings intervals() const;
+    Strings aliases() const;
+
+    // Voicings
+    std::size_t patternCount() const;
+    std::string_view patternSource(std::size_t i) const;
+    voicing_dictionary::VoicingPattern pattern(std::size_t i) const;
+
+private:
+    friend class Dictionary;
+    Entry(const Dictionary* dictionary, const std::uint8_t* record)
+        : dictionary(dictionary), record(record) {}
+
+    const Dictionary* dictionary;
+    const std::uint8_t* record;
+
+    std::uint32_t field(std::size_t i) const;
+};
+
+/**
+ * A dictionary file, opened in place. The file is validated when opened
+ * (bounds of every offset, without reading the strings); an invalid file
+ * gives a dictionary that is not open.
+ */
+class Dictionary {
+public:
+    Dictionary() = default;
+
+    /**
+     * Memory map a dictionary file
+     */
+    explicit Dictionary(const std::string& path);
+
+    /**
+     * Use a dictionary in memory, without copying it. The memory must
+     * outlive the dictionary.
+     */
+    Dictionary(const std::uint8_t* data, std::size_t size);
+
+    /**
+     * Use a compiled dictionary (see compile)
+     */
+    explicit Dictionary(std::vector<std::uint8_t> bytes);
+
+    Dictionary(const Dictionary&) = delete;
+    Dictionary& operator=(const Dictionary&) = delete;
+    Dictionary(Dictionary&& other) noexcept;
+    Dictionary& operator=(Dictionary&& other) noexcept;
+
+    /**
+     * Whether the dictionary is valid (false if it has not been opened)
+     */
+    bool isOpen() const { return data != nullptr; }
+
+    Kind kind() const { return fileKind; }
+
+    /**
+     * Number of entries
+     */
+    std::size_t size() const { return entries; }
+    bool empty() const { return entries == 0; }
+
+    Entry operator[](std::size_t i) const;
+
+    /**
+     * Find an entry by key: the name, set number, chroma or an alias of a
+     * chord or scale type, or the symbol of a voicing. As in chord_type, a
+     * key of several entries finds the last one.
+     *
+     * @param key The key
+     * @return The index of the entry, or -1 if not found
+     */
+    int indexOf(std::string_view key) const;
+    int indexOf(int setNum) const;
+
+    /**
+     * Find an entry by key (see indexOf)
+     */
+    std::optional<Entry> find(std::string_view key) const;
+
+    /**
+     * The file contents
+     */
+    const std::uint8_t* bytes() const { return data; }
+    std::size_t byteSize() const { return length; }
+
+private:
+    friend class Entry;
+
+    helpers::MappedFile mapped;
+    std::vector<std::uint8_t> owned;
+    const std::uint8_t* data = nullptr;
+    std::size_t length = 0;
+
+    Kind fileKind = Kind::ChordTypes;
+    std::size_t entries = 0;
+    std::size_t slots = 0;
+    std::size_t refs = 0;
+    std::size_t patterns = 0;
+    const std::uint8_t* entryTable = nullptr;
+    const std::uint8_t* refTable = nullptr;
+    const std::uint8_t* slotTable = nullptr;
+    const std::uint8_t* patternTable = nullptr;
+    const char* pool = nullptr;
+    std::size_t poolSize = 0;
+
+    void open(const std::uint8_t* bytes, std::size_t size);
+    void reset();
+    std::string_view string(const std::uint8_t* ref) const;
+};
+
+/**
+ * Compile dictionaries to the binary format
+ *
+ * @return The file contents
+ */
+std::vector<std::uint8_t> compile(const std::vector<chord_type::ChordType>& types);
+std::vector<std::uint8_t> compile(const std::vector<scale_type::ScaleType>& types);
+std::vector<std::uint8_t> compile(const voicing_dictionary::VoicingDictionary& dictionary);
+
+/**
+ * Compile a dictionary in text format. Voicings use the format of
+ * voicing_dictionary::parseDictionary. Chord and scale types have a line
+ * per type with its name, intervals and aliases separated by "|":
+ *
+ *     major seventh = 1P 3M 5P 7M | maj7 | Δ | M7
+ *
+ * Empty lines and lines starting with "#" are ignored.
+ *
+ * @param kind The kind of dictionary
+ * @param text The dictionary text
+ * @return The file contents (empty if any line is not valid)
+ */
+std::vector<std::uint8_t> compileText(Kind kind, std::string_view text);
+
+/**
+ * Compile a dictionary text file to a binary file
+ *
+ * @param kind The kind of dictionary
+ * @param source Path of the text file
+ * @param destination Path of the binary file
+ * @return Whether the source is valid and the binary file was written
+ */
+bool compileFile(Kind kind, const std::string& source, const std::string& destination);
+
+/**
+ * Convert entries back to the dictionary types
+ */
+chord_type::ChordType toChordType(const Entry& entry);
+scale_type::ScaleType toScaleType(const Entry& entry);
+voicing_dictionary::VoicingDictionary toVoicingDictionary(const Dictionary& dictionary);
+
+/**
+ * Add the types of a chord or scale type file to the chord_type or
+ * scale_type dictionary (see chord_type::addAll and scale_type::addAll)
+ *
+ * @param dictionary The dictionary file
+ * @return Whether the types were added (false for voicings)
+ */
+bool install(const Dictionary& dictionary);
+
+} // namespace dictionary_file
+} // namespace tonalcpp
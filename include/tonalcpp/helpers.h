@@ -1,6 +1,17 @@
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <ostream>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
 #include <vector>
 
 namespace tonalcpp {
@@ -15,5 +26,249 @@ namespace helpers {
  */
 std::vector<std::string> split(const std::string& str);
 
+/**
+ * A read-only view of a whole file, memory mapped when the platform allows
+ * it (POSIX), read into memory otherwise. The contents are not copied: pages
+ * are loaded by the OS as they are read.
+ *
+ * @example
+ * helpers::MappedFile file("song.mid");
+ * if (file.isOpen()) parse(file.data(), file.size());
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    /**
+     * Map a file. If it can't be opened, isOpen() is false
+     */
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    bool isOpen() const { return opened; }
+    const std::uint8_t* data() const { return bytes; }
+    std::size_t size() const { return length; }
+
+private:
+    void close();
+
+    bool opened = false;
+    bool mapped = false;                // Whether bytes must be unmapped
+    const std::uint8_t* bytes = nullptr;
+    std::size_t length = 0;
+    std::vector<std::uint8_t> buffer;   // The contents, when not mapped
+};
+
+/**
+ * A hash map with string keys that can be looked up with a string_view,
+ * without creating a temporary std::string (C++17 unordered_map has no
+ * heterogeneous lookup). Keys are copied once, on insertion, to a storage
+ * that never moves them. Entries can't be removed one by one, only all
+ * together with clear().
+ *
+ * Not copyable: the index points to the keys of its own storage.
+ */
+template<typename Value>
+class StringMap {
+public:
+    using Index = std::unordered_map<std::string_view, Value>;
+    using const_iterator = typename Index::const_iterator;
+
+    StringMap() = default;
+    StringMap(const StringMap&) = delete;
+    StringMap& operator=(const StringMap&) = delete;
+    StringMap(StringMap&&) = default;
+    StringMap& operator=(StringMap&&) = default;
+
+    /**
+     * Find a value
+     *
+     * @param key The key
+     * @return A pointer to the value, or nullptr if the key is not present
+     */
+    Value* find(std::string_view key) {
+        auto it = index.find(key);
+        return it == index.end() ? nullptr : &it->second;
+    }
+    const Value* find(std::string_view key) const {
+        auto it = index.find(key);
+        return it == index.end() ? nullptr : &it->second;
+    }
+
+    /**
+     * Get the value of a key, inserting a default value if not present
+     */
+    Value& operator[](std::string_view key) {
+        auto it = index.find(key);
+        if (it != index.end()) {
+            return it->second;
+        }
+        keys.emplace_back(key);
+        return index[keys.back()];
+    }
+
+    std::size_t size() const { return index.size(); }
+    bool empty() const { return index.empty(); }
+
+    /**
+     * Reserve space for count keys, so adding them doesn't rehash
+     */
+    void reserve(std::size_t count) { index.reserve(count); }
+
+    void clear() {
+        index.clear();
+        keys.clear();
+    }
+
+    // Iterate the (key, value) pairs, in no particular order
+    const_iterator begin() const { return index.begin(); }
+    const_iterator end() const { return index.end(); }
+
+private:
+    std::deque<std::string> keys;  // Growing a deque doesn't move its elements
+    Index index;
+};
+
+/**
+ * Append chord or scale types to a dictionary. A type with the same
+ * (non-empty) name and chroma as one in the dictionary, or added before, is
+ * merged into it: only its new aliases are added. Unnamed types are always
+ * appended, as add() does.
+ *
+ * @param dictionary The types of the dictionary
+ * @param types The types to add
+ */
+template <typename Type>
+void mergeTypes(std::vector<Type>& dictionary, std::vector<Type>&& types) {
+    std::unordered_map<std::string, std::size_t> positions;
+    positions.reserve(dictionary.size() + types.size());
+    for (std::size_t i = 0; i < dictionary.size(); i++) {
+        if (!dictionary[i].name.empty()) {
+            positions.emplace(dictionary[i].chroma + dictionary[i].name, i);
+        }
+    }
+    dictionary.reserve(dictionary.size() + types.size());
+    for (Type& type : types) {
+        if (!type.name.empty()) {
+            const auto inserted = positions.emplace(type.chroma + type.name, dictionary.size());
+            if (!inserted.second) {
+                std::vector<std::string>& aliases = dictionary[inserted.first->second].aliases;
+                for (auto& alias : type.aliases) {
+                    if (std::find(aliases.begin(), aliases.end(), alias) == aliases.end()) {
+                        aliases.push_back(std::move(alias));
+                    }
+                }
+                continue;
+            }
+        }
+        dictionary.push_back(std::move(type));
+    }
+}
+
+/**
+ * A string of at most Capacity chars stored inline (no allocation), for
+ * short names like "C#4" or "13M". It's trivially copyable and converts to
+ * std::string and std::string_view, so it can replace a std::string field
+ * without changing the code that reads it.
+ *
+ * Building it from a longer string throws std::length_error (like
+ * std::string beyond max_size). Use fits() to check first.
+ */
+template<std::size_t Capacity>
+class InlineString {
+    static_assert(Capacity < 256, "The size is stored in a byte");
+
+public:
+    constexpr InlineString() = default;
+    InlineString(const char* str) : InlineString(std::string_view(str)) {}
+    InlineString(const std::string& str) : InlineString(std::string_view(str)) {}
+    InlineString(std::string_view str) {
+        if (!fits(str)) {
+            throw std::length_error("InlineString: too long");
+        }
+        std::memcpy(chars, str.data(), str.size());
+        count = static_cast<std::uint8_t>(str.size());
+    }
+
+    /**
+     * Whether a string is short enough
+     */
+    static constexpr bool fits(std::string_view str) { return str.size() <= Capacity; }
+    static constexpr std::size_t max_size() { return Capacity; }
+
+    constexpr std::size_t size() const { return count; }
+    constexpr std::size_t length() const { return count; }
+    constexpr bool empty() const { return count == 0; }
+    constexpr const char* data() const { return chars; }
+    constexpr const char* begin() const { return chars; }
+    constexpr const char* end() const { return chars + count; }
+    constexpr char operator[](std::size_t i) const { return chars[i]; }
+    constexpr char front() const { return chars[0]; }
+    constexpr char back() const { return chars[count - 1]; }
+
+    std::string_view view() const { return std::string_view(chars, count); }
+    std::string str() const { return std::string(chars, count); }
+    operator std::string_view() const { return view(); }
+    operator std::string() const { return str(); }
+
+    // Comparisons and concatenations with anything that converts to a
+    // string_view (other than an InlineString): std::string, const char*...
+    template<typename T>
+    using IfText = std::enable_if_t<std::is_convertible_v<const T&, std::string_view> &&
+                                    !std::is_same_v<T, InlineString>, int>;
+
+    friend bool operator==(const InlineString& a, const InlineString& b) { return a.view() == b.view(); }
+    friend bool operator!=(const InlineString& a, const InlineString& b) { return a.view() != b.view(); }
+    friend bool operator<(const InlineString& a, const InlineString& b) { return a.view() < b.view(); }
+    template<typename T, IfText<T> = 0>
+    friend bool operator==(const InlineString& a, const T& b) { return a.view() == std::string_view(b); }
+    template<typename T, IfText<T> = 0>
+    friend bool operator==(const T& a, const InlineString& b) { return std::string_view(a) == b.view(); }
+    template<typename T, IfText<T> = 0>
+    friend bool operator!=(const InlineString& a, const T& b) { return a.view() != std::string_view(b); }
+    template<typename T, IfText<T> = 0>
+    friend bool operator!=(const T& a, const InlineString& b) { return std::string_view(a) != b.view(); }
+
+    // Concatenation gives a std::string
+    friend std::string operator+(const InlineString& a, const InlineString& b) {
+        std::string result(a.view());
+        result += b.view();
+        return result;
+    }
+    template<typename T, IfText<T> = 0>
+    friend std::string operator+(const InlineString& a, const T& b) {
+        std::string result(a.view());
+        result += std::string_view(b);
+        return result;
+    }
+    template<typename T, IfText<T> = 0>
+    friend std::string operator+(const T& a, const InlineString& b) {
+        std::string result(a);
+        result += b.view();
+        return result;
+    }
+    friend std::string operator+(const InlineString& a, char b) { return a.str() + b; }
+    friend std::string operator+(char a, const InlineString& b) { return a + b.str(); }
+
+    friend std::ostream& operator<<(std::ostream& os, const InlineString& str) { return os << str.view(); }
+
+private:
+    char chars[Capacity] = {};
+    std::uint8_t count = 0;
+};
+
 } // namespace helpers
-} // namespace tonalcpp
\ No newline at end of file
+} // namespace tonalcpp
+
+namespace std {
+template<std::size_t Capacity>
+struct hash<tonalcpp::helpers::InlineString<Capacity>> {
+    std::size_t operator()(const tonalcpp::helpers::InlineString<Capacity>& str) const noexcept {
+        return std::hash<std::string_view>()(str.view());
+    }
+};
+} // namespace std
\ No newline at end of file
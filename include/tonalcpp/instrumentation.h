@@ -0,0 +1,225 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+/**
+ * Opt-in instrumentation of the library hot paths: call counters and time
+ * histograms of the main functions, allocation counts and hit/miss counters
+ * of the note, interval and pcset caches.
+ *
+ * It is compiled in only when TONAL_INSTRUMENTATION is defined (CMake
+ * option TONAL_INSTRUMENTATION). Otherwise the probes expand to nothing and
+ * snapshot() returns empty statistics, so code using this API builds in
+ * both configurations.
+ */
+
+namespace tonalcpp {
+namespace instrumentation {
+
+/**
+ * Number of buckets of the time histograms. Bucket i counts the calls that
+ * took [2^i, 2^(i+1)) nanoseconds, the last one also counts longer calls.
+ */
+constexpr std::size_t HISTOGRAM_BUCKETS = 32;
+
+/**
+ * The instrumented caches
+ */
+enum class Cache { Note, Interval, Pcset };
+constexpr std::size_t CACHE_COUNT = 3;
+
+/**
+ * Statistics of an instrumented function
+ */
+struct ProbeStats {
+    std::string name;                 // Like "chord::get"
+    std::uint64_t calls = 0;
+    std::uint64_t totalNs = 0;        // Time spent in the calls (nested probes included)
+    std::uint64_t allocations = 0;    // Heap allocations made by the calls
+    std::uint64_t allocatedBytes = 0;
+    std::array<std::uint64_t, HISTOGRAM_BUCKETS> histogram{};
+};
+
+/**
+ * Statistics of a cache
+ */
+struct CacheStats {
+    std::string name;                 // Like "noteCache"
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+
+    /**
+     * Fraction of the lookups found in the cache (0 if there were none)
+     */
+    double hitRate() const {
+        const auto total = hits + misses;
+        return total == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(total);
+    }
+};
+
+/**
+ * All the statistics since the last reset
+ */
+struct Snapshot {
+    std::vector<ProbeStats> probes;   // In order of first call
+    std::vector<CacheStats> caches;
+    std::uint64_t allocations = 0;    // All the allocations recorded by the hook
+    std::uint64_t allocatedBytes = 0;
+};
+
+/**
+ * Whether the instrumentation is compiled in
+ */
+constexpr bool enabled() {
+#ifdef TONAL_INSTRUMENTATION
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * Get the statistics. Counters are updated without locking, so a snapshot
+ * taken while other threads run is only approximately consistent.
+ */
+Snapshot snapshot();
+
+/**
+ * Set all the statistics to zero
+ */
+void reset();
+
+/**
+ * Record a heap allocation. Call it from a replacement of the global
+ * operator new (see TONAL_INSTRUMENTATION_ALLOCATION_HOOK)
+ *
+ * @param size The allocated bytes
+ */
+void recordAllocation(std::size_t size);
+
+/**
+ * Record a cache lookup
+ */
+void recordCacheLookup(Cache cache, bool hit);
+
+/**
+ * The counters of an instrumented function (see TONAL_PROBE)
+ */
+struct Probe {
+    const char* name;
+    std::atomic<std::uint64_t> calls{0};
+    std::atomic<std::uint64_t> totalNs{0};
+    std::atomic<std::uint64_t> allocations{0};
+    std::atomic<std::uint64_t> allocatedBytes{0};
+    std::array<std::atomic<std::uint64_t>, HISTOGRAM_BUCKETS> histogram{};
+
+    explicit Probe(const char* name) : name(name) {}
+};
+
+/**
+ * Get the probe of a function, created on first use. Probes live until the
+ * end of the program.
+ */
+Probe& probe(const char* name);
+
+/**
+ * Thread local allocation counters, to attribute allocations to probes
+ */
+struct AllocationCount {
+    std::uint64_t allocations = 0;
+    std::uint64_t bytes = 0;
+};
+AllocationCount threadAllocations();
+
+/**
+ * Measure a call: time and allocations between construction and
+ * destruction are added to the probe
+ */
+class ScopedProbe {
+public:
+    explicit ScopedProbe(Probe& probe)
+        : target(probe), allocationsAtStart(threadAllocations()), start(std::chrono::steady_clock::now()) {}
+    ~ScopedProbe();
+
+    ScopedProbe(const ScopedProbe&) = delete;
+    ScopedProbe& operator=(const ScopedProbe&) = delete;
+
+private:
+    Probe& target;
+    AllocationCount allocationsAtStart;
+    std::chrono::steady_clock::time_point start;
+};
+
+} // namespace instrumentation
+} // namespace tonalcpp
+
+#define TONAL_INSTRUMENTATION_CONCAT_IMPL(a, b) a##b
+#define TONAL_INSTRUMENTATION_CONCAT(a, b) TONAL_INSTRUMENTATION_CONCAT_IMPL(a, b)
+
+#ifdef TONAL_INSTRUMENTATION
+
+/**
+ * Measure the enclosing scope as a call of the named function
+ *
+ * @example
+ * Chord get(const std::string& src) {
+ *     TONAL_PROBE("chord::get");
+ *     ...
+ * }
+ */
+#define TONAL_PROBE(name)                                                                       \
+    static ::tonalcpp::instrumentation::Probe& TONAL_INSTRUMENTATION_CONCAT(tonalProbe, __LINE__) = \
+        ::tonalcpp::instrumentation::probe(name);                                               \
+    const ::tonalcpp::instrumentation::ScopedProbe TONAL_INSTRUMENTATION_CONCAT(tonalProbeScope, __LINE__)( \
+        TONAL_INSTRUMENTATION_CONCAT(tonalProbe, __LINE__))
+
+/**
+ * Record a cache lookup (cache is an instrumentation::Cache)
+ */
+#define TONAL_CACHE_LOOKUP(cache, hit) \
+    ::tonalcpp::instrumentation::recordCacheLookup(::tonalcpp::instrumentation::Cache::cache, hit)
+
+/**
+ * Define replacements of the global operator new and delete that record
+ * the allocations. Use it in exactly one source file of the program, at
+ * global scope. The plain and nothrow forms are replaced, so every block
+ * they allocate is freed by the matching delete. The std::align_val_t
+ * forms (types aligned beyond the default) are left to the standard
+ * library, and their allocations are not counted.
+ */
+#define TONAL_INSTRUMENTATION_ALLOCATION_HOOK()                                                \
+    void* operator new(std::size_t size) {                                                      \
+        ::tonalcpp::instrumentation::recordAllocation(size);                                    \
+        if (void* p = std::malloc(size == 0 ? 1 : size)) return p;                              \
+        throw std::bad_alloc();                                                                 \
+    }                                                                                           \
+    void* operator new[](std::size_t size) { return ::operator new(size); }                     \
+    void* operator new(std::size_t size, const std::nothrow_t&) noexcept {                      \
+        ::tonalcpp::instrumentation::recordAllocation(size);                                    \
+        return std::malloc(size == 0 ? 1 : size);                                               \
+    }                                                                                           \
+    void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept {                \
+        return ::operator new(size, tag);                                                       \
+    }                                                                                           \
+    void operator delete(void* p) noexcept { std::free(p); }                                    \
+    void operator delete[](void* p) noexcept { std::free(p); }                                  \
+    void operator delete(void* p, std::size_t) noexcept { std::free(p); }                       \
+    void operator delete[](void* p, std::size_t) noexcept { std::free(p); }                     \
+    void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }             \
+    void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+
+#else
+
+#define TONAL_PROBE(name) ((void)0)
+#define TONAL_CACHE_LOOKUP(cache, hit) ((void)0)
+#define TONAL_INSTRUMENTATION_ALLOCATION_HOOK()
+
+#endif
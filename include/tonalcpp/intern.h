@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+
+/**
+ * A global, thread-safe table of interned names (note, interval and chord
+ * symbol names). Each distinct name is stored once and identified by a
+ * small integer handle, so hot loops can compare and hash handles instead
+ * of strings. Names are never removed: handles and the references to their
+ * names stay valid until the end of the program.
+ */
+
+namespace tonalcpp {
+namespace intern {
+
+/**
+ * Handle of an interned name. The default handle is the empty name.
+ */
+class Handle {
+public:
+    constexpr Handle() = default;
+
+    /**
+     * The integer identifying the name (0 for the empty name). Ids are
+     * given in interning order and are not stable between runs.
+     */
+    constexpr std::uint32_t id() const { return index; }
+
+    constexpr bool empty() const { return index == 0; }
+
+    /**
+     * The name. The reference is valid until the end of the program.
+     */
+    const std::string& str() const;
+    std::string_view view() const { return str(); }
+
+    friend constexpr bool operator==(Handle a, Handle b) { return a.index == b.index; }
+    friend constexpr bool operator!=(Handle a, Handle b) { return a.index != b.index; }
+    // By id (interning order), not alphabetically
+    friend constexpr bool operator<(Handle a, Handle b) { return a.index < b.index; }
+
+private:
+    friend Handle intern(std::string_view name);
+    friend std::optional<Handle> find(std::string_view name);
+    explicit constexpr Handle(std::uint32_t index) : index(index) {}
+
+    std::uint32_t index = 0;
+};
+
+/**
+ * Intern a name
+ *
+ * @param name The name
+ * @return The handle of the name (the same for equal names)
+ *
+ * @example
+ * intern::intern("C#4") == intern::intern(std::string("C#") + "4") // => true
+ */
+Handle intern(std::string_view name);
+
+/**
+ * Find the handle of a name without interning it
+ *
+ * @param name The name
+ * @return The handle, or nullopt if the name was never interned
+ */
+std::optional<Handle> find(std::string_view name);
+
+/**
+ * Number of interned names (the empty name included)
+ */
+std::size_t size();
+
+} // namespace intern
+} // namespace tonalcpp
+
+namespace std {
+template<>
+struct hash<tonalcpp::intern::Handle> {
+    std::size_t operator()(tonalcpp::intern::Handle handle) const noexcept {
+        return std::hash<std::uint32_t>()(handle.id());
+    }
+};
+} // namespace std
@@ -1,6 +1,9 @@
 #pragma once
 
+#include "tonalcpp/intern.h"
 #include "tonalcpp/pitch_note.h"
+#include <array>
+#include <cstddef>
 #include <optional>
 #include <string>
 #include <vector>
@@ -41,6 +44,75 @@ std::optional<int> toMidi(int note);
  */
 double midiToFreq(int midi, double tuning = 440.0);
 
+/**
+ * Precomputed frequencies of the 128 midi notes for a given A4 reference.
+ * Build it once and look up frequencies without calling std::pow.
+ */
+class TuningTable {
+public:
+    /**
+     * @param tuning A4 tuning frequency in Hz (440 by default)
+     */
+    explicit TuningTable(double tuning = 440.0);
+
+    /**
+     * Build a table from arbitrary frequencies (see tuning::Tuning)
+     * @param freqs The frequency of each midi note (0 for unmapped notes)
+     * @param tuning The reference frequency of the tuning in Hz
+     */
+    TuningTable(const std::array<double, 128>& freqs, double tuning);
+
+    /**
+     * Get the frequency of a midi note. Notes outside 0-127 are computed
+     * (12-TET tables) or 0 (tables built from arbitrary frequencies).
+     */
+    double operator[](int midi) const {
+        return midi >= 0 && midi <= 127 ? freqs[midi] : compute(midi);
+    }
+
+    /**
+     * The reference frequency in Hz: the A4 frequency of 12-TET tables, the
+     * frequency given with arbitrary ones (for Scala tunings, the frequency
+     * of the reference note of the keyboard mapping, not always A4)
+     */
+    double reference() const { return tuning; }
+
+    /**
+     * The frequencies of all midi notes (0-127)
+     */
+    const std::array<double, 128>& frequencies() const { return freqs; }
+
+private:
+    double compute(int midi) const;
+
+    double tuning;
+    bool equalTempered = true;
+    std::array<double, 128> freqs;
+};
+
+/**
+ * Get the frequency in hertz from midi number using a tuning table
+ *
+ * @param midi The note midi number
+ * @param table The tuning table
+ * @return The frequency
+ */
+inline double midiToFreq(int midi, const TuningTable& table) {
+    return table[midi];
+}
+
+/**
+ * Convert a batch of (possibly fractional) midi numbers to frequencies.
+ * It uses a polynomial approximation of exp2 (relative error below 1e-6,
+ * a thousandth of a cent) so the loop can be vectorized by the compiler.
+ *
+ * @param midi Pointer to the first midi number
+ * @param count Number of values
+ * @param out Destination (must hold count values)
+ * @param tuning A4 tuning frequency in Hz (440 by default)
+ */
+void midiToFreq(const float* midi, std::size_t count, float* out, double tuning = 440.0);
+
 /**
  * Get the midi number from a frequency in hertz. The midi number can
  * contain decimals (with two digits precision)
@@ -50,6 +122,20 @@ double midiToFreq(int midi, double tuning = 440.0);
  */
 double freqToMidi(double freq);
 
+/**
+ * Convert a batch of frequencies to (fractional) midi numbers. Unlike the
+ * scalar version the result is not rounded to two decimals. It uses a
+ * polynomial approximation of log2 (error below a hundredth of a cent) so
+ * the loop can be vectorized by the compiler. Invalid frequencies
+ * (zero, negative, infinite or NaN) produce NaN.
+ *
+ * @param freq Pointer to the first frequency in Hz
+ * @param count Number of values
+ * @param out Destination (must hold count values)
+ * @param tuning A4 tuning frequency in Hz (440 by default)
+ */
+void freqToMidi(const float* freq, std::size_t count, float* out, double tuning = 440.0);
+
 /**
  * Options for converting MIDI to note name
  */
@@ -68,6 +154,16 @@ struct ToNoteNameOptions {
  */
 std::string midiToNoteName(int midi, const ToNoteNameOptions& options = {});
 
+/**
+ * Same as midiToNoteName, but returns the interned name. Names of valid
+ * midi numbers (0-127) are looked up in a table, without building strings.
+ *
+ * @param midi The midi note number
+ * @param options Options for conversion (pitchClass, sharps)
+ * @return The handle of the note name
+ */
+intern::Handle midiToNoteHandle(int midi, const ToNoteNameOptions& options = {});
+
 /**
  * Get the chroma (pitch class value 0-11) from a MIDI note number
  * @param midi The MIDI note number
@@ -123,5 +219,112 @@ std::function<int(int)> pcsetSteps(const std::string& chroma, int tonic);
 std::function<std::optional<int>(int)> pcsetDegrees(const std::vector<int>& notes, int tonic);
 std::function<std::optional<int>(int)> pcsetDegrees(const std::string& chroma, int tonic);
 
+/**
+ * Maps scale steps to midi notes. It's the concrete (inlinable) version of
+ * the function returned by pcsetSteps: the pitch classes of the set are
+ * kept in a fixed array so it can be built and evaluated in constant
+ * expressions.
+ *
+ * @example
+ * constexpr PcsetSteps steps("101011010101", 60);
+ * static_assert(steps(1) == 62);
+ */
+class PcsetSteps {
+public:
+    constexpr PcsetSteps() = default;
+
+    /**
+     * @param chroma A 12 characters chroma literal (e.g. "101011010101")
+     * @param tonic The tonic note as a MIDI note number
+     */
+    constexpr PcsetSteps(const char (&chroma)[13], int tonic) : tonic(tonic) {
+        for (int i = 0; i < 12; i++) {
+            if (chroma[i] == '1') {
+                set[len++] = i;
+            }
+        }
+    }
+
+    /**
+     * @param notes Array of MIDI numbers
+     * @param tonic The tonic note as a MIDI note number
+     */
+    PcsetSteps(const std::vector<int>& notes, int tonic);
+
+    /**
+     * @param chroma A binary chroma string
+     * @param tonic The tonic note as a MIDI note number
+     */
+    PcsetSteps(const std::string& chroma, int tonic);
+
+    /**
+     * Get the midi note of a scale step (0 is the tonic, negative steps go down)
+     * An empty set always returns the tonic.
+     */
+    constexpr int operator()(int step) const {
+        if (len == 0) {
+            return tonic;
+        }
+        // Floored division, like Math.floor(step / len) in JS
+        int octaves = step / len;
+        if (step % len < 0) {
+            octaves -= 1;
+        }
+        return set[step - octaves * len] + octaves * 12 + tonic;
+    }
+
+    /**
+     * Map a batch of steps to midi notes
+     * @param steps Pointer to the first step
+     * @param count Number of steps
+     * @param out Destination (must hold count values)
+     */
+    void operator()(const int* steps, std::size_t count, int* out) const;
+
+    /**
+     * Number of pitch classes in the set
+     */
+    constexpr int size() const { return len; }
+
+private:
+    std::array<int, 12> set{};
+    int len = 0;
+    int tonic = 0;
+};
+
+/**
+ * Maps scale degrees (1-based, 0 is not a degree) to midi notes. Concrete
+ * version of the function returned by pcsetDegrees.
+ */
+class PcsetDegrees {
+public:
+    constexpr PcsetDegrees() = default;
+    constexpr PcsetDegrees(const char (&chroma)[13], int tonic) : steps(chroma, tonic) {}
+    PcsetDegrees(const std::vector<int>& notes, int tonic) : steps(notes, tonic) {}
+    PcsetDegrees(const std::string& chroma, int tonic) : steps(chroma, tonic) {}
+
+    constexpr std::optional<int> operator()(int degree) const {
+        if (degree == 0) {
+            return std::nullopt;
+        }
+        return steps(degree > 0 ? degree - 1 : degree);
+    }
+
+    /**
+     * Map a batch of degrees to midi notes. Degree 0 has no midi note, so it
+     * writes the given fallback value instead.
+     * @param degrees Pointer to the first degree
+     * @param count Number of degrees
+     * @param out Destination (must hold count values)
+     * @param fallback Value written for degree 0
+     */
+    void operator()(const int* degrees, std::size_t count, int* out, int fallback = -1) const;
+
+    constexpr int size() const { return steps.size(); }
+
+private:
+    PcsetSteps steps;
+};
+
 } // namespace midi
 } // namespace tonalcpp
\ No newline at end of file
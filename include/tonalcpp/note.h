@@ -5,7 +5,9 @@
 #include "tonalcpp/pitch_distance.h"
 #include "tonalcpp/pitch_interval.h"
 #include "tonalcpp/midi.h"
+#include <cstddef>
 #include <functional>
+#include <memory_resource>
 #include <optional>
 #include <string>
 #include <vector>
@@ -93,6 +95,15 @@ std::string fromMidi(int midiNum);
  */
 std::string fromMidiSharps(int midiNum);
 
+/**
+ * Same as fromMidi and fromMidiSharps, but return the interned name
+ * (see midi::midiToNoteHandle)
+ * @param midiNum The midi note number
+ * @return The handle of the note name
+ */
+intern::Handle fromMidiHandle(int midiNum);
+intern::Handle fromMidiSharpsHandle(int midiNum);
+
 /**
  * Given a frequency in Hz, returns a note name using flats for altered notes
  * @param frequency The frequency in Hz
@@ -100,6 +111,38 @@ std::string fromMidiSharps(int midiNum);
  */
 std::string fromFreq(double frequency);
 
+/**
+ * A note identified by its midi number, without a name
+ */
+struct FreqNote {
+    int midi;       // Nearest midi number (-1 if the frequency is not valid)
+    double cents;   // Deviation from the midi note in cents (-50 to 50)
+};
+
+/**
+ * Given a frequency in Hz, returns the nearest midi note and the deviation
+ * in cents. No strings are built: use fromMidi to get the name if needed.
+ *
+ * @param frequency The frequency in Hz
+ * @param tuning A4 tuning frequency in Hz (440 by default)
+ * @return The nearest midi note and the cents deviation
+ */
+FreqNote fromFreqId(double frequency, double tuning = 440.0);
+
+/**
+ * Batch version of fromFreqId for pitch tracker output. It uses the
+ * vectorized midi::freqToMidi conversion. Invalid frequencies (zero,
+ * negative, infinite or NaN) give -1, as in fromFreqId.
+ *
+ * @param freqs Pointer to the first frequency in Hz
+ * @param count Number of frequencies
+ * @param midi Destination of the nearest midi numbers (-1 if not valid)
+ * @param cents Destination of the deviations in cents
+ * @param tuning A4 tuning frequency in Hz (440 by default)
+ */
+void fromFreqIds(const float* freqs, std::size_t count, int* midi, float* cents,
+                 double tuning = 440.0);
+
 /**
  * Given a frequency in Hz, returns a note name using sharps for altered notes
  * @param frequency The frequency in Hz
@@ -201,6 +244,19 @@ std::vector<std::string> sortedNames(
     const std::vector<std::string>& notes,
     const NoteComparator& comparator = ascending);
 
+/**
+ * Same as sortedNames, with the result (and the notes being sorted)
+ * allocated from a memory resource
+ * @param resource The memory resource
+ * @param notes Array of note names
+ * @param comparator The comparator function to use for sorting
+ * @return Sorted array of note names
+ */
+std::pmr::vector<std::pmr::string> sortedNames(
+    std::pmr::memory_resource* resource,
+    const std::vector<std::string>& notes,
+    const NoteComparator& comparator = ascending);
+
 /**
  * Sort and extract unique note names from an array
  * @param notes Array of note names
@@ -1,9 +1,11 @@
 #pragma once
 
+#include <memory_resource>
 #include <string>
 #include <vector>
 #include <optional>
 #include <unordered_map>
+#include "tonalcpp/intern.h"
 #include "tonalcpp/pitch.h"
 
 namespace tonalcpp {
@@ -83,6 +85,12 @@ Pcset getPcset(int src);
 Pcset getPcset(const std::vector<std::string>& src);
 Pcset getPcset(const Pcset& pcset);
 
+/**
+ * Remove the pitch class sets cached by getPcset(). The cache fills again
+ * on use
+ */
+void clearCache();
+
 /**
  * Get the intervals in a set (from C)
  * 
@@ -94,6 +102,29 @@ std::vector<std::string> intervals(int src);
 std::vector<std::string> intervals(const std::vector<std::string>& src);
 std::vector<std::string> intervals(const Pcset& pcset);
 
+/**
+ * Same as intervals, with the result allocated from a memory resource. The
+ * intervals are copied straight from the pcset cache.
+ *
+ * @param resource The memory resource of the result
+ * @param src The source (chroma, set number or list of notes/intervals)
+ * @return The intervals
+ */
+std::pmr::vector<std::pmr::string> intervals(std::pmr::memory_resource* resource, const std::string& src);
+std::pmr::vector<std::pmr::string> intervals(std::pmr::memory_resource* resource, int src);
+std::pmr::vector<std::pmr::string> intervals(std::pmr::memory_resource* resource, const std::vector<std::string>& src);
+
+/**
+ * Get the chroma of a list of intervals, checking that all of them are
+ * valid. It's faster than chroma(), that tries to parse each one as a note
+ * first.
+ *
+ * @param intervals The interval names
+ * @return The chroma, or an empty string if the list is empty or any
+ * interval is not valid
+ */
+std::string intervalsChroma(const std::vector<std::string>& intervals);
+
 /**
  * Get the chroma of a set
  * 
@@ -127,6 +158,18 @@ std::vector<std::string> notes(int src);
 std::vector<std::string> notes(const std::vector<std::string>& src);
 std::vector<std::string> notes(const Pcset& pcset);
 
+/**
+ * Same as notes, but returns the interned note names. The names are found
+ * from the chroma, without transposing the intervals.
+ *
+ * @param src The source set
+ * @return List of note name handles
+ */
+std::vector<intern::Handle> noteHandles(const std::string& src);
+std::vector<intern::Handle> noteHandles(int src);
+std::vector<intern::Handle> noteHandles(const std::vector<std::string>& src);
+std::vector<intern::Handle> noteHandles(const Pcset& pcset);
+
 /**
  * Get all possible pitch class sets (all possible chromas)
  * 
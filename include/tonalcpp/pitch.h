@@ -4,9 +4,13 @@
 #include <optional>
 #include <string>
 #include <vector>
+#include <cstddef>
 #include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
 #include <typeinfo>
 #include <exception>
+#include "tonalcpp/helpers.h"
 
 namespace tonalcpp {
 namespace pitch {
@@ -25,13 +29,60 @@ enum class Direction {
 using PitchClassCoordinates = std::array<int, 1>;
 using NoteCoordinates = std::array<int, 2>;
 using IntervalCoordinates = std::array<int, 3>;
-using PitchCoordinates = std::vector<int>;
+
+/**
+ * Coordinates of any pitch: [fifths] for pitch classes, [fifths, octaves]
+ * for notes and [fifths, octaves, direction] for intervals. The values are
+ * stored inline (copies don't allocate), with the interface of a vector.
+ */
+class PitchCoordinates {
+public:
+    PitchCoordinates() = default;
+    PitchCoordinates(std::initializer_list<int> values) {
+        for (int value : values) {
+            push_back(value);
+        }
+    }
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    int operator[](std::size_t i) const { return values[i]; }
+    int& operator[](std::size_t i) { return values[i]; }
+    const int* begin() const { return values.data(); }
+    const int* end() const { return values.data() + count; }
+
+    void push_back(int value) {
+        if (count == values.size()) {
+            throw std::length_error("PitchCoordinates: at most 3 values");
+        }
+        values[count++] = value;
+    }
+
+    friend bool operator==(const PitchCoordinates& a, const PitchCoordinates& b) {
+        if (a.count != b.count) return false;
+        for (std::size_t i = 0; i < a.count; i++) {
+            if (a.values[i] != b.values[i]) return false;
+        }
+        return true;
+    }
+    friend bool operator!=(const PitchCoordinates& a, const PitchCoordinates& b) { return !(a == b); }
+
+private:
+    std::array<int, 3> values{};
+    std::uint8_t count = 0;
+};
+
+/**
+ * Note and interval names are short ("C#4", "Bbb-1", "-13M"): they are
+ * stored inline. Longer names are not valid notes or intervals.
+ */
+using NameString = helpers::InlineString<7>;
 
 /**
  * NamedPitch interface for objects with a name representation
  */
 struct NamedPitch {
-    std::string name;
+    NameString name;
 };
 
 /**
@@ -55,7 +106,7 @@ struct Pitch : public NamedPitch {
     }
     
     // Full constructor
-    Pitch(int s, int a, std::optional<int> o, std::optional<Direction> d, std::string n = "") 
+    Pitch(int s, int a, std::optional<int> o, std::optional<Direction> d, NameString n = NameString()) 
         : NamedPitch{n}, step(s), alt(a), oct(o), dir(d) {}
 };
 
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 #include <optional>
 #include <unordered_map>
@@ -29,9 +31,9 @@ using Quality = std::string;
  */
 struct Interval : public pitch::Pitch {
     bool empty;                          // Whether this is a valid interval
-    IntervalName name;                   // The interval name
+    pitch::NameString name;              // The interval name
     int num;                             // The interval number (1, 2, 3, etc.)
-    Quality q;                           // The interval quality string (P, M, m, d, A, etc.)
+    pitch::NameString q;                 // The interval quality string (P, M, m, d, A, etc.)
     IntervalType type;                   // The interval type (perfectable or majorable)
     int simple;                          // Simplified interval number
     int semitones;                       // The number of semitones
@@ -48,6 +50,10 @@ struct Interval : public pitch::Pitch {
              const pitch::IntervalCoordinates& co);
 };
 
+// Intervals are copied out of the cache on every lookup
+static_assert(std::is_trivially_copyable_v<Interval>, "Interval must be trivially copyable");
+static_assert(sizeof(Interval) <= 2 * 64, "Interval must fit in two cache lines");
+
 /**
  * Invalid interval constant
  */
@@ -58,7 +64,7 @@ extern const Interval NoInterval;
  * @param src Interval string or Pitch
  * @return Interval object
  */
-Interval interval(const std::string& src);
+Interval interval(std::string_view src);
 
 /**
  * Parse a string to an interval 
@@ -66,14 +72,19 @@ Interval interval(const std::string& src);
  * @param useCache Whether to use the cache for parsed intervals
  * @return Interval object
  */
-Interval interval(const std::string& src, bool useCache);
+Interval interval(std::string_view src, bool useCache);
+
+/**
+ * Remove the intervals cached by interval(). The cache fills again on use
+ */
+void clearCache();
 
 /**
  * Tokenize an interval string into components
  * @param str Interval string
  * @return Pair of [number, quality]
  */
-std::pair<std::string, std::string> tokenizeInterval(const std::string& str);
+std::pair<std::string, std::string> tokenizeInterval(std::string_view str);
 
 /**
  * Convert pitch properties to quality string
@@ -1,9 +1,12 @@
 #pragma once
 
+#include "tonalcpp/intern.h"
 #include "tonalcpp/pitch.h"
 #include <optional>
 #include <string>
+#include <string_view>
 #include <tuple>
+#include <type_traits>
 #include <vector>
 
 namespace tonalcpp {
@@ -19,19 +22,25 @@ using NoteName = std::string;
  */
 struct Note : public pitch::Pitch {
     bool empty = false;
-    std::string letter;
-    std::string acc;
-    std::string pc;
+    pitch::NameString letter;
+    pitch::NameString acc;
+    pitch::NameString pc;
     int chroma;
     int height;
     pitch::PitchCoordinates coord;
     std::optional<int> midi;
     std::optional<double> freq;
 
-    Note() : pitch::Pitch(), empty(true), letter(""), acc(""), pc(""), 
-             chroma(0), height(0), coord({}), midi(std::nullopt), freq(std::nullopt) {}
+    Note() : pitch::Pitch(), empty(true), letter(), acc(), pc(), 
+             chroma(0), height(0), coord(), midi(std::nullopt), freq(std::nullopt) {}
 };
 
+// Notes are copied out of the cache on every lookup: keep them small and
+// copyable with a memcpy
+static_assert(std::is_trivially_copyable_v<Note>, "Note must be trivially copyable");
+static_assert(sizeof(Note) <= 2 * 64, "Note must fit in two cache lines");
+static_assert(alignof(Note) <= alignof(double), "Note must not be over-aligned");
+
 // Create an empty note singleton
 extern const Note NoNote;
 
@@ -40,7 +49,7 @@ extern const Note NoNote;
  * @param noteName The note name string to parse
  * @return Tuple containing letter, accidental, octave string, and remainder
  */
-std::tuple<std::string, std::string, std::string, std::string> tokenizeNote(const std::string& noteName);
+std::tuple<std::string, std::string, std::string, std::string> tokenizeNote(std::string_view noteName);
 
 /**
  * Convert pitch step to letter name (0 -> C, 1 -> D, etc.)
@@ -61,14 +70,14 @@ std::string altToAcc(int alt);
  * @param acc The accidental string
  * @return The alteration value
  */
-int accToAlt(const std::string& acc);
+int accToAlt(std::string_view acc);
 
 /**
  * Parse a note name into a full Note object
  * @param noteName The note name to parse
  * @return A complete Note object
  */
-Note parse(const std::string& noteName);
+Note parse(std::string_view noteName);
 
 /**
  * Convert a Pitch object to a note name
@@ -77,6 +86,13 @@ Note parse(const std::string& noteName);
  */
 std::string pitchName(const pitch::Pitch& pitch);
 
+/**
+ * Same as pitchName, but returns the interned name
+ * @param pitch The Pitch object to convert
+ * @return The handle of the note name
+ */
+intern::Handle pitchNameHandle(const pitch::Pitch& pitch);
+
 /**
  * Convert pitch coordinates to a Note object
  * @param coord The pitch coordinates
@@ -85,13 +101,20 @@ std::string pitchName(const pitch::Pitch& pitch);
 Note coordToNote(const pitch::PitchCoordinates& coord);
 
 /**
- * Create a Note object from a note name or a pitch object
+ * Create a Note object from a note name or a pitch object. Names can be
+ * slices of a larger buffer: cached notes are found without copying them.
  * @param src The source (note name, pitch, or named pitch)
  * @return A Note object
  */
-Note note(const std::string& src);
+Note note(std::string_view src);
 Note note(const pitch::Pitch& src);
 Note note(const pitch::NamedPitch& src);
 
+/**
+ * Remove the notes cached by note(). The cache fills again on use (useful
+ * to measure uncached lookups)
+ */
+void clearCache();
+
 } // namespace pitch_note
 } // namespace tonalcpp
\ No newline at end of file
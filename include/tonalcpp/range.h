@@ -1,5 +1,9 @@
 #pragma once
 
+#include <cstddef>
+#include <iterator>
+#include <memory_resource>
+#include <utility>
 #include <vector>
 #include <string>
 #include "tonalcpp/midi.h"
@@ -33,5 +37,220 @@ std::vector<int> numeric(const std::vector<std::string>& notes);
  */
 std::vector<std::string> chromatic(const std::vector<std::string>& notes, bool sharps = false);
 
+/**
+ * Same as numeric, with the result allocated from a memory resource (like a
+ * per-request std::pmr::monotonic_buffer_resource)
+ *
+ * @param resource The memory resource of the result
+ * @param notes Vector of note names or midi numbers
+ * @return Vector of midi numbers or empty vector if not valid parameters
+ */
+std::pmr::vector<int> numeric(std::pmr::memory_resource* resource, const std::vector<std::string>& notes);
+
+/**
+ * Same as chromatic, with the result allocated from a memory resource
+ *
+ * @param resource The memory resource of the result
+ * @param notes Vector of note names or midi note numbers to create a range from
+ * @param sharps Whether to use sharps instead of flats for altered notes
+ * @return Vector of note names
+ */
+std::pmr::vector<std::pmr::string> chromatic(
+    std::pmr::memory_resource* resource,
+    const std::vector<std::string>& notes,
+    bool sharps = false);
+
+/**
+ * Pitch class mask with all the 12 pitch classes (bit i is pitch class i)
+ */
+constexpr unsigned ALL_CHROMAS = 0xFFF;
+
+/**
+ * A lazy numeric range: the midi numbers of a range are computed on access
+ * from the range ends, so only the ends are stored. Optionally filtered by a
+ * pitch class mask.
+ *
+ * @example
+ * auto view = numericView({"C4", "C5"});
+ * view.size() // => 13
+ * view[2] // => 62
+ * for (int midi : view.filter(0x091)) {} // => 60, 64, 67, 72 (C, E and G)
+ */
+class NumericView {
+public:
+    /**
+     * Forward iterator over the midi numbers of the view
+     */
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = int;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const int*;
+        using reference = int;
+
+        Iterator() = default;
+
+        int operator*() const { return value; }
+        Iterator& operator++() { advance(); return *this; }
+        Iterator operator++(int) { Iterator it = *this; advance(); return it; }
+        bool operator==(const Iterator& other) const { return segment == other.segment && value == other.value; }
+        bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+    private:
+        friend class NumericView;
+        const NumericView* view = nullptr;
+        std::size_t segment = 0;  // Index of the end the current segment goes to
+        int value = 0;
+        int target = 0;           // The end of the current segment
+        int step = 0;
+
+        Iterator(const NumericView* view, std::size_t segment, int value)
+            : view(view), segment(segment), value(value), target(value) {}
+        void advance();
+    };
+
+    /**
+     * An empty view
+     */
+    NumericView() = default;
+
+    /**
+     * @param ends The midi numbers of the range ends (segments are joined)
+     * @param mask The pitch classes to keep
+     */
+    explicit NumericView(std::vector<int> ends, unsigned mask = ALL_CHROMAS);
+
+    /**
+     * Number of midi numbers (computed once, without walking the range)
+     */
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    /**
+     * The midi number at a position (not checked)
+     */
+    int operator[](std::size_t index) const;
+
+    Iterator begin() const;
+    Iterator end() const { return Iterator(this, ends.size(), 0); }
+
+    /**
+     * Keep only the midi numbers of some pitch classes
+     *
+     * @param mask The pitch classes to keep (bit i is pitch class i)
+     * @return A view with the notes of this view in those pitch classes
+     */
+    NumericView filter(unsigned mask) const { return NumericView(ends, this->mask & mask); }
+
+    /**
+     * Copy the midi numbers to a vector (same as numeric)
+     */
+    std::vector<int> toVector() const;
+
+    unsigned chromas() const { return mask; }
+
+private:
+    std::vector<int> ends;
+    unsigned mask = ALL_CHROMAS;
+    std::size_t count = 0;
+};
+
+/**
+ * A lazy chromatic range: like NumericView, but yields note names. The names
+ * are interned, so iterating doesn't allocate.
+ *
+ * @example
+ * auto view = chromaticView({"C2", "E2"});
+ * view[1] // => "Db2"
+ * for (const std::string& name : view) {}
+ */
+class ChromaticView {
+public:
+    /**
+     * Forward iterator over the note names of the view
+     */
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::string;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::string*;
+        using reference = const std::string&;
+
+        Iterator() = default;
+
+        const std::string& operator*() const;
+        const std::string* operator->() const { return &**this; }
+        Iterator& operator++() { ++it; return *this; }
+        Iterator operator++(int) { Iterator copy = *this; ++it; return copy; }
+        bool operator==(const Iterator& other) const { return it == other.it; }
+        bool operator!=(const Iterator& other) const { return it != other.it; }
+
+    private:
+        friend class ChromaticView;
+        NumericView::Iterator it;
+        bool sharps = false;
+
+        Iterator(NumericView::Iterator it, bool sharps) : it(it), sharps(sharps) {}
+    };
+
+    ChromaticView() = default;
+
+    /**
+     * @param numeric The midi numbers (between 0 and 127)
+     * @param sharps Whether to use sharps instead of flats for altered notes
+     */
+    explicit ChromaticView(NumericView numeric, bool sharps = false)
+        : midi(std::move(numeric)), sharps(sharps) {}
+
+    std::size_t size() const { return midi.size(); }
+    bool empty() const { return midi.empty(); }
+
+    /**
+     * The note name at a position (not checked)
+     */
+    const std::string& operator[](std::size_t index) const;
+
+    Iterator begin() const { return Iterator(midi.begin(), sharps); }
+    Iterator end() const { return Iterator(midi.end(), sharps); }
+
+    /**
+     * Keep only the notes of some pitch classes (see NumericView::filter)
+     */
+    ChromaticView filter(unsigned mask) const { return ChromaticView(midi.filter(mask), sharps); }
+
+    /**
+     * The midi numbers of the notes
+     */
+    const NumericView& numeric() const { return midi; }
+
+    /**
+     * Copy the note names to a vector (same as chromatic)
+     */
+    std::vector<std::string> toVector() const;
+
+private:
+    NumericView midi;
+    bool sharps = false;
+};
+
+/**
+ * Same as numeric, but lazy
+ *
+ * @param notes Vector of note names or midi numbers
+ * @return The view, or an empty view if not valid parameters
+ */
+NumericView numericView(const std::vector<std::string>& notes);
+
+/**
+ * Same as chromatic, but lazy
+ *
+ * @param notes Vector of note names or midi note numbers to create a range from
+ * @param sharps Whether to use sharps instead of flats for altered notes
+ * @return The view, or an empty view if not valid parameters
+ */
+ChromaticView chromaticView(const std::vector<std::string>& notes, bool sharps = false);
+
 } // namespace range
 } // namespace tonalcpp
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <tuple>
 #include <optional>
@@ -41,7 +42,7 @@ using ScaleNameTokens = std::tuple<std::string, std::string>;
  * @param name The scale name
  * @return A tuple (tonic, name)
  */
-ScaleNameTokens tokenize(const ScaleName& name);
+ScaleNameTokens tokenize(std::string_view name);
 
 /**
  * Return all scale names
@@ -54,7 +55,7 @@ std::vector<std::string> names();
  * @param src The scale name or scale name tokens
  * @return The scale object
  */
-Scale get(const ScaleName& src);
+Scale get(std::string_view src);
 Scale get(const ScaleNameTokens& src);
 
 /**
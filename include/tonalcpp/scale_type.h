@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
 #include "tonalcpp/pcset.h"
@@ -38,7 +39,7 @@ std::vector<std::string> names();
  * @param type Scale name or pitch class set chroma
  * @return The scale type properties
  */
-ScaleType get(const ScaleTypeName& type);
+ScaleType get(std::string_view type);
 ScaleType get(int setNum);
 
 /**
@@ -72,6 +73,43 @@ ScaleType add(const std::vector<std::string>& intervals,
               const std::string& name,
               const std::vector<std::string>& aliases = {});
 
+/**
+ * A scale type to add with addAll (the arguments of add)
+ */
+struct Definition {
+    std::vector<std::string> intervals;
+    std::string name;
+    std::vector<std::string> aliases;
+};
+
+/**
+ * Add many scales to the dictionary at once. All the definitions are
+ * validated first: if any has no name, no intervals or an invalid one,
+ * nothing is added. A scale with the same name and intervals as one in the
+ * dictionary (or defined before) is not added again: its new aliases are
+ * added to it.
+ *
+ * The new dictionary is built aside and replaces the old one at once:
+ * lookups running meanwhile (from other threads too) find the old or the
+ * new scales, never a part of them, and a failure leaves it as it was.
+ *
+ * @param definitions The scales to add
+ * @param count Number of scales
+ * @return Whether the scales were added
+ */
+bool addAll(const Definition* definitions, std::size_t count);
+bool addAll(const std::vector<Definition>& definitions);
+
+/**
+ * Add many scale types that are already built (like the entries of a
+ * dictionary file) at once, as addAll does with definitions. They are not
+ * validated nor parsed again.
+ *
+ * @param types The scale types to add
+ * @param count Number of scale types
+ */
+void addAll(const ScaleType* types, std::size_t count);
+
 /**
  * Add an alias for a scale
  * 
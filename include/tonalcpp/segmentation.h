@@ -0,0 +1,146 @@
+#pragma once
+
+#include "tonalcpp/chord_detect.h"
+#include "tonalcpp/intern.h"
+#include "tonalcpp/smf.h"
+#include "tonalcpp/thread_pool.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace tonalcpp {
+namespace segmentation {
+
+/**
+ * How the time is sliced in segments
+ */
+enum class Slicing {
+    Onsets,  // A new segment each time the sounding notes change
+    Beats,   // Fixed steps of a beat grid
+};
+
+/**
+ * Options for segment
+ */
+struct SegmentOptions {
+    Slicing slicing = Slicing::Onsets;
+    // Beats: ticks per step. 0 = a quarter note (the division of the file)
+    std::uint32_t step = 0;
+    // Whether channel 10 (General MIDI percussion) is included
+    bool drums = false;
+    chord_detect::DetectOptions detect;
+};
+
+/**
+ * A span of time with the same harmony
+ */
+struct Segment {
+    std::uint32_t start = 0;   // First tick
+    std::uint32_t end = 0;     // Tick after the last one
+    // The pitch classes sounding, as a pcset number (C = 2048 ... B = 1)
+    std::uint16_t mask = 0;
+    int bass = -1;             // Lowest midi key sounding
+    intern::Handle chord;      // The most likely chord (empty if none)
+};
+
+/**
+ * Memoized chord detection by pitch classes and bass: chord_detect::detect
+ * runs once per distinct (mask, bass) pair, the next lookups are an array
+ * access. Not thread safe: use one labeler per thread.
+ */
+class ChordLabeler {
+public:
+    explicit ChordLabeler(const chord_detect::DetectOptions& options = chord_detect::DetectOptions());
+
+    /**
+     * The most likely chord of a set of pitch classes
+     *
+     * @param mask The pitch classes, as a pcset number
+     * @param bass The chroma of the bass (0-11). It must be in the mask
+     * @return The chord name (empty if none is detected)
+     *
+     * @example
+     * labeler(pcset::num(std::vector<std::string>{"C", "E", "G"}), 0).str() // => "CM"
+     */
+    intern::Handle operator()(std::uint16_t mask, int bass);
+
+    /**
+     * Number of times chord_detect::detect has been called
+     */
+    std::size_t detections() const { return count; }
+
+private:
+    chord_detect::DetectOptions options;
+    std::vector<intern::Handle> labels;  // By (bass << 12 | mask)
+    std::vector<bool> known;
+    std::size_t count = 0;
+};
+
+/**
+ * Slice note events in harmonic segments and label them with chords.
+ * Silent spans have no segment. Adjacent segments with the same chord are
+ * merged: the merged segment has the pitch classes of all of them and the
+ * bass of the first one.
+ *
+ * With Slicing::Beats, a step has the pitch classes sounding at any time
+ * within it, and options.step must not be 0.
+ *
+ * @param events The note events, sorted by tick
+ * @param options The slicing options (options.detect is not used: the
+ * labeler has its own)
+ * @param labeler The chord labeler (reused between calls to share its memo)
+ * @return The segments, in time order
+ */
+std::vector<Segment> segment(
+    const smf::NoteEvents& events,
+    const SegmentOptions& options,
+    ChordLabeler& labeler
+);
+
+/**
+ * Segment the note events of a file
+ *
+ * @param file The midi file
+ * @param options The options (a step of 0 is one quarter note)
+ * @return The segments (empty if the file is empty, or is in SMPTE time
+ * and the beat grid has no step)
+ */
+std::vector<Segment> segment(const smf::MidiFile& file, const SegmentOptions& options = SegmentOptions());
+
+/**
+ * Segment many files in parallel. Each worker keeps its own chord labeler,
+ * so the detector runs about once per distinct chord and worker.
+ *
+ * @param files Pointer to the first file
+ * @param count Number of files
+ * @param options The options
+ * @param pool The threads to use
+ * @return The segments of each file
+ */
+std::vector<std::vector<Segment>> segmentBatch(
+    const smf::MidiFile* files,
+    std::size_t count,
+    const SegmentOptions& options,
+    thread_pool::ThreadPool& pool
+);
+
+/**
+ * Load and segment many .mid files in parallel. Each worker reuses the
+ * event buffers of the files it reads.
+ *
+ * @param paths Pointer to the first path
+ * @param count Number of paths
+ * @param options The options
+ * @param pool The threads to use
+ * @return The segments of each file (empty for files that can't be read)
+ */
+std::vector<std::vector<Segment>> segmentFiles(
+    const std::string* paths,
+    std::size_t count,
+    const SegmentOptions& options,
+    thread_pool::ThreadPool& pool
+);
+
+} // namespace segmentation
+} // namespace tonalcpp
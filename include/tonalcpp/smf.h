@@ -0,0 +1,247 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace tonalcpp {
+
+namespace voice_leading {
+struct Voicing;
+}
+
+namespace smf {
+
+/**
+ * Note on and note off events, as a structure of arrays: the i-th event is
+ * (ticks[i], channels[i], keys[i], velocities[i], tracks[i]). Keys are midi
+ * note numbers, so they can be given to midi::midiToNoteName (or
+ * midi::midiToNoteHandle) and chord_detect without any conversion.
+ *
+ * Note off events have velocity 0 (a note on with velocity 0 is a note off
+ * too, as in the MIDI spec). The release velocity is not kept.
+ */
+struct NoteEvents {
+    std::vector<std::uint32_t> ticks;       // Absolute time, in ticks
+    std::vector<std::uint8_t> channels;     // 0-15
+    std::vector<std::uint8_t> keys;         // Midi note number (0-127)
+    std::vector<std::uint8_t> velocities;   // 1-127 for note on, 0 for note off
+    std::vector<std::uint16_t> tracks;      // Index of the track of the event
+
+    std::size_t size() const { return ticks.size(); }
+    bool empty() const { return ticks.empty(); }
+    bool isNoteOn(std::size_t i) const { return velocities[i] > 0; }
+
+    void push_back(std::uint32_t tick, std::uint8_t channel, std::uint8_t key,
+                   std::uint8_t velocity, std::uint16_t track) {
+        ticks.push_back(tick);
+        channels.push_back(channel);
+        keys.push_back(key);
+        velocities.push_back(velocity);
+        tracks.push_back(track);
+    }
+
+    void reserve(std::size_t count) {
+        ticks.reserve(count);
+        channels.reserve(count);
+        keys.reserve(count);
+        velocities.reserve(count);
+        tracks.reserve(count);
+    }
+
+    /**
+     * Remove the events, keeping the allocated memory
+     */
+    void clear() {
+        ticks.clear();
+        channels.clear();
+        keys.clear();
+        velocities.clear();
+        tracks.clear();
+    }
+};
+
+/**
+ * The note events of a Standard MIDI File
+ */
+struct MidiFile {
+    bool empty = true;
+    int format = 0;             // 0 (one track) or 1 (simultaneous tracks)
+    int tracks = 0;             // Number of track chunks read
+    // Ticks per quarter note. Negative for SMPTE time: the high byte is
+    // minus the frames per second and the low byte the ticks per frame
+    int division = 0;
+    NoteEvents events;          // All the tracks merged, by tick
+};
+
+/**
+ * Read the note events of a Standard MIDI File (format 0 or 1) from
+ * memory. Running status, variable length quantities, meta and sysex
+ * events are decoded; everything but notes is skipped. The events of all
+ * the tracks are merged by tick (events at the same tick stay in track
+ * order).
+ *
+ * @param data The file contents
+ * @param size The size of the contents
+ * @return The file (empty if it's not a valid format 0 or 1 file)
+ */
+MidiFile parse(const std::uint8_t* data, std::size_t size);
+
+/**
+ * Same as parse, reusing the memory of a previous result: when reading
+ * many files, the event buffers stop growing and nothing is allocated per
+ * event.
+ *
+ * @param data The file contents
+ * @param size The size of the contents
+ * @param file The result (cleared first)
+ * @return Whether the file is valid (if not, file is empty)
+ */
+bool parse(const std::uint8_t* data, std::size_t size, MidiFile& file);
+
+/**
+ * Read a Standard MIDI File from disk. The file is memory mapped and
+ * decoded in place, without copying it.
+ *
+ * @param path Path to the .mid file
+ * @return The file (empty if it can't be read or is not valid)
+ */
+MidiFile load(const std::string& path);
+bool load(const std::string& path, MidiFile& file);
+
+/**
+ * Writes Standard MIDI Files to a memory buffer. Notes are given with their
+ * duration: the note offs are kept in a small queue and written in time
+ * order. Note offs are written as note ons with velocity 0, so running
+ * status is used for all the notes.
+ *
+ * Within a track, events must be given in time order (an event before the
+ * last one written is moved to the last tick). A single track gives a
+ * format 0 file, more tracks a format 1 file. A gap longer than a delta
+ * time can hold (2^28 - 1 ticks) is split with empty text events.
+ *
+ * The buffer and the queue are reused by clear(): a writer that writes
+ * many files stops allocating once it has written the biggest one.
+ *
+ * @example
+ * smf::Writer writer;
+ * writer.note(0, 480, 60);
+ * writer.note(480, 480, 64);
+ * writer.save("two_notes.mid");
+ */
+class Writer {
+public:
+    /**
+     * @param division Ticks per quarter note
+     */
+    explicit Writer(int division = 480);
+
+    /**
+     * Start a new file, keeping the allocated memory
+     */
+    void clear();
+
+    /**
+     * Start a new track. The first one is started by the first event.
+     */
+    void beginTrack();
+
+    /**
+     * Write a note
+     *
+     * @param tick The start, in ticks
+     * @param duration The duration, in ticks
+     * @param key The midi note number (0-127)
+     * @param velocity The velocity (1-127)
+     * @param channel The channel (0-15)
+     */
+    void note(std::uint32_t tick, std::uint32_t duration, std::uint8_t key,
+              std::uint8_t velocity = 100, std::uint8_t channel = 0);
+
+    /**
+     * Write all the notes of a voicing at the same time
+     */
+    void chord(std::uint32_t tick, std::uint32_t duration, const voice_leading::Voicing& voicing,
+               std::uint8_t velocity = 100, std::uint8_t channel = 0);
+
+    /**
+     * Write notes given by name (e.g. {"C4", "E4", "G4"}, as returned by
+     * voicing::sequence). Invalid names are skipped.
+     */
+    void chord(std::uint32_t tick, std::uint32_t duration, const std::vector<std::string>& notes,
+               std::uint8_t velocity = 100, std::uint8_t channel = 0);
+
+    /**
+     * Write a voiced progression, one chord after another
+     *
+     * @param tick The start of the first chord
+     * @param voicings Pointer to the first voicing (empty voicings are rests)
+     * @param count Number of voicings
+     * @param duration The duration of each chord, in ticks
+     * @return The tick after the last chord
+     */
+    std::uint32_t progression(std::uint32_t tick, const voice_leading::Voicing* voicings, std::size_t count,
+                              std::uint32_t duration, std::uint8_t velocity = 100, std::uint8_t channel = 0);
+
+    /**
+     * Write a tempo change
+     *
+     * @param tick The time of the change
+     * @param microsecondsPerQuarter The tempo (500000 = 120 bpm)
+     */
+    void tempo(std::uint32_t tick, std::uint32_t microsecondsPerQuarter);
+
+    /**
+     * End the file and get its contents. Events written after this start a
+     * new track.
+     */
+    const std::vector<std::uint8_t>& finish();
+
+    /**
+     * End the file and write it to disk
+     *
+     * @param path The path of the .mid file
+     * @return Whether it could be written
+     */
+    bool save(const std::string& path);
+
+private:
+    struct NoteOff {
+        std::uint32_t tick;
+        std::uint8_t channel;
+        std::uint8_t key;
+    };
+
+    struct Later {
+        bool operator()(const NoteOff& a, const NoteOff& b) const { return a.tick > b.tick; }
+    };
+
+    int division;
+    std::vector<std::uint8_t> bytes;
+    std::vector<NoteOff> pending;   // A min heap by tick
+    int tracks = 0;
+    std::size_t trackStart = 0;     // Offset of the open track chunk (0 = none)
+    std::uint32_t last = 0;         // Tick of the last event of the track
+    std::uint8_t running = 0;       // Running status (0 = none)
+
+    void endTrack();
+    void flush(std::uint32_t tick);
+    void event(std::uint32_t tick, std::uint8_t status, std::uint8_t data1, std::uint8_t data2);
+    void delta(std::uint32_t tick);
+};
+
+/**
+ * Write a voiced progression (e.g. a result of voicing::sequenceOptimal)
+ * as a format 0 file. By default, each chord lasts a bar of 4/4.
+ *
+ * @param path The path of the .mid file
+ * @param voicings The voicings (empty voicings are rests)
+ * @param duration The duration of each chord, in ticks (480 per quarter)
+ * @return Whether it could be written
+ */
+bool saveProgression(const std::string& path, const std::vector<voice_leading::Voicing>& voicings,
+                     std::uint32_t duration = 1920);
+
+} // namespace smf
+} // namespace tonalcpp
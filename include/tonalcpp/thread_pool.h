@@ -0,0 +1,85 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace tonalcpp {
+namespace thread_pool {
+
+/**
+ * The body of a parallel loop: called with a chunk [begin, end) of the
+ * indexes and the number of the worker that runs it (0 to size() - 1), so
+ * per-worker scratch data can be indexed without locking
+ */
+using ChunkFunction = std::function<void(std::size_t begin, std::size_t end, std::size_t worker)>;
+
+/**
+ * A fixed set of worker threads running parallel loops. Each worker gets a
+ * contiguous share of the chunks of a loop and, when it runs out, steals
+ * chunks from the back of the other workers' queues.
+ */
+class ThreadPool {
+public:
+    /**
+     * @param threads Number of worker threads (0 = one per hardware thread)
+     */
+    explicit ThreadPool(std::size_t threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * Number of worker threads
+     */
+    std::size_t size() const { return workers.size(); }
+
+    /**
+     * Run a function over the indexes [0, count) split in chunks, and wait
+     * until all of them are done. If the function throws, the first
+     * exception is rethrown here once all the chunks are finished.
+     *
+     * Loops are run one at a time: calling parallelFor from inside the body
+     * of another loop of the same pool deadlocks.
+     *
+     * @param count Number of indexes
+     * @param body The function to run on each chunk
+     * @param grain Number of indexes per chunk
+     */
+    void parallelFor(std::size_t count, const ChunkFunction& body, std::size_t grain = 1);
+
+private:
+    using Chunk = std::pair<std::size_t, std::size_t>;
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Chunk> chunks;
+    };
+
+    std::vector<std::thread> workers;
+    std::vector<std::unique_ptr<Queue>> queues;
+
+    std::mutex loopMutex;     // One loop at a time
+    std::mutex stateMutex;    // Protects the fields below
+    std::condition_variable wake;
+    std::condition_variable finished;
+    const ChunkFunction* body = nullptr;
+    std::size_t generation = 0;
+    std::size_t running = 0;
+    bool stopping = false;
+    std::exception_ptr error;
+
+    void work(std::size_t worker);
+    bool next(std::size_t worker, Chunk& chunk);
+};
+
+} // namespace thread_pool
+} // namespace tonalcpp
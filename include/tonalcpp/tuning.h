@@ -0,0 +1,162 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "tonalcpp/midi.h"
+
+namespace tonalcpp {
+namespace tuning {
+
+/**
+ * A Scala scale (.scl file)
+ */
+struct ScalaScale {
+    bool empty = true;
+    std::string description;
+    std::vector<double> cents;  // Pitch of degrees 1..n in cents. The last one is the period
+};
+
+/**
+ * A Scala keyboard mapping (.kbm file)
+ */
+struct KeyboardMapping {
+    bool empty = true;
+    int size = 0;                 // Size of the mapping pattern (0 = linear mapping)
+    int firstMidi = 0;            // First midi note to retune
+    int lastMidi = 127;           // Last midi note to retune
+    int middleNote = 60;          // Midi note where the first entry of the mapping is mapped
+    int referenceNote = 60;       // Midi note with the reference frequency
+    double referenceFreq = 261.6255653005986; // Frequency of the reference note in Hz
+    int octaveDegree = 0;         // Scale degree of the formal octave (0 = scale size)
+    std::vector<int> mapping;     // Scale degree of each key of the pattern (-1 = unmapped)
+};
+
+/**
+ * Parse the contents of a Scala scale file
+ *
+ * @param text The .scl file contents
+ * @return The scale (empty if not valid)
+ */
+ScalaScale parseScl(const std::string& text);
+
+/**
+ * Load a Scala scale file from disk
+ *
+ * @param path Path to the .scl file
+ * @return The scale (empty if the file can't be read or is not valid)
+ */
+ScalaScale loadScl(const std::string& path);
+
+/**
+ * Parse the contents of a Scala keyboard mapping file
+ *
+ * @param text The .kbm file contents
+ * @return The keyboard mapping (empty if not valid)
+ */
+KeyboardMapping parseKbm(const std::string& text);
+
+/**
+ * Load a Scala keyboard mapping file from disk
+ *
+ * @param path Path to the .kbm file
+ * @return The keyboard mapping (empty if the file can't be read or is not valid)
+ */
+KeyboardMapping loadKbm(const std::string& path);
+
+/**
+ * Nearest tuned note of a frequency
+ */
+struct Nearest {
+    int midi;      // Nearest mapped midi note (-1 if none)
+    int degree;    // Scale degree of that note (0 = first note of the scale)
+    double cents;  // Deviation from the tuned note in cents
+};
+
+/**
+ * An immutable tuning table built from a Scala scale and keyboard mapping.
+ * All the work is done in the constructor: queries are table lookups, and
+ * since nothing is mutated afterwards a Tuning can be shared between
+ * threads (e.g. through a std::shared_ptr<const Tuning>).
+ */
+class Tuning {
+public:
+    /**
+     * 12-TET tuning with A4 = 440Hz
+     */
+    Tuning();
+
+    /**
+     * @param scale The Scala scale
+     * @param mapping The keyboard mapping. An empty mapping maps the scale
+     * linearly from middle C (midi 60, 261.6256Hz)
+     */
+    explicit Tuning(const ScalaScale& scale, const KeyboardMapping& mapping = KeyboardMapping());
+
+    /**
+     * Whether the tuning is valid (an invalid scale or mapping gives an empty tuning)
+     */
+    bool empty() const { return isEmpty; }
+
+    /**
+     * Get the frequency of a midi note. Unmapped notes (and notes outside
+     * 0-127) have frequency 0.
+     */
+    double midiToFreq(int midi) const { return table[midi]; }
+
+    /**
+     * Batch version of midiToFreq
+     * @param midi Pointer to the first midi note
+     * @param count Number of notes
+     * @param out Destination (must hold count values)
+     */
+    void midiToFreq(const int* midi, std::size_t count, double* out) const;
+
+    /**
+     * Get the scale degree of a midi note (0 = first note of the scale),
+     * or -1 if the note is not mapped
+     */
+    int degree(int midi) const { return midi >= 0 && midi <= 127 ? degrees[midi] : -1; }
+
+    /**
+     * Find the mapped midi note whose frequency is the nearest to the given one
+     * @param freq Frequency in Hz
+     * @return The nearest note (midi is -1 if there are no mapped notes or freq is not valid)
+     */
+    Nearest freqToNearest(double freq) const;
+
+    /**
+     * Batch version of freqToNearest
+     * @param freqs Pointer to the first frequency
+     * @param count Number of frequencies
+     * @param midi Destination of the nearest midi notes
+     * @param cents Destination of the deviations in cents
+     */
+    void freqToNearest(const float* freqs, std::size_t count, int* midi, float* cents) const;
+
+    /**
+     * The frequencies of all midi notes, usable with midi::midiToFreq
+     */
+    const midi::TuningTable& frequencies() const { return table; }
+
+private:
+    bool isEmpty;
+    midi::TuningTable table;
+    std::array<int, 128> degrees;
+    // Mapped notes sorted by pitch, for the nearest lookups
+    std::vector<double> sortedLog2;
+    std::vector<int> sortedMidi;
+};
+
+/**
+ * Load a tuning from Scala files
+ *
+ * @param sclPath Path to the .scl file
+ * @param kbmPath Path to the .kbm file (optional)
+ * @return The tuning (empty if any of the files can't be loaded)
+ */
+Tuning load(const std::string& sclPath, const std::string& kbmPath = "");
+
+} // namespace tuning
+} // namespace tonalcpp
@@ -1,8 +1,15 @@
 #pragma once
 
-#include <vector>
-#include <string>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
 #include <functional>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "tonalcpp/voicing_dictionary.h"
 
 namespace tonalcpp {
 namespace voice_leading {
@@ -26,5 +33,212 @@ std::vector<std::string> topNoteDiff(
     const std::vector<std::string>& lastVoicing
 );
 
+/**
+ * A voicing as midi numbers (from bottom to top) in a fixed size array.
+ * The spelling of each note is kept as its position in the circle of
+ * fifths, so note names are only built when requested.
+ */
+struct Voicing {
+    std::uint8_t size = 0;
+    std::array<std::uint8_t, voicing_dictionary::MAX_VOICES> midi{};
+    std::array<std::int8_t, voicing_dictionary::MAX_VOICES> fifths{}; // 0 = C, 1 = G, -1 = F...
+
+    int operator[](std::size_t i) const { return midi[i]; }
+    bool empty() const { return size == 0; }
+    int bass() const { return midi[0]; }
+    int top() const { return midi[size - 1]; }
+
+    /**
+     * Get the name of a note of the voicing (e.g. "Eb4")
+     */
+    std::string name(std::size_t i) const;
+
+    /**
+     * Get the note names of the voicing
+     */
+    std::vector<std::string> names() const;
+
+    bool operator==(const Voicing& other) const;
+    bool operator!=(const Voicing& other) const { return !(*this == other); }
+};
+
+/**
+ * Voice leading metrics. Each one is a function object that gives the cost
+ * (lower is better) of moving from a voicing to another. Both voicings must
+ * not be empty. They are plain structs so they inline when passed to the
+ * templates below (scoreAll, best, voicing::sequenceOptimal), and can be
+ * combined with weighted and sum.
+ */
+
+/**
+ * Semitones moved by the top note
+ */
+struct TopNote {
+    int operator()(const Voicing& from, const Voicing& to) const {
+        return std::abs(from.top() - to.top());
+    }
+};
+
+/**
+ * Semitones moved by the bass
+ */
+struct Bass {
+    int operator()(const Voicing& from, const Voicing& to) const {
+        return std::abs(from.bass() - to.bass());
+    }
+};
+
+/**
+ * Semitones moved by all the voices. Voices are paired from the bottom;
+ * extra voices are paired with the top voice of the smaller voicing.
+ */
+struct TotalMotion {
+    int operator()(const Voicing& from, const Voicing& to) const {
+        const std::size_t voices = std::max(from.size, to.size);
+        int motion = 0;
+        for (std::size_t i = 0; i < voices; i++) {
+            const int a = from.midi[std::min<std::size_t>(i, from.size - 1)];
+            const int b = to.midi[std::min<std::size_t>(i, to.size - 1)];
+            motion += std::abs(a - b);
+        }
+        return motion;
+    }
+};
+
+/**
+ * The smallest total motion of any way of connecting the voices without
+ * crossings, where every note of both voicings is connected and a voice
+ * can split or merge (so voicings of different sizes can be compared)
+ */
+struct MinimalAssignment {
+    int operator()(const Voicing& from, const Voicing& to) const {
+        // cost[i][j]: best connection of the first i + 1 and j + 1 notes
+        constexpr std::size_t N = voicing_dictionary::MAX_VOICES;
+        std::array<std::array<int, N>, N> cost;
+        for (std::size_t i = 0; i < from.size; i++) {
+            for (std::size_t j = 0; j < to.size; j++) {
+                int previous = 0;
+                if (i > 0 && j > 0) {
+                    previous = std::min({cost[i - 1][j - 1], cost[i - 1][j], cost[i][j - 1]});
+                } else if (i > 0) {
+                    previous = cost[i - 1][j];
+                } else if (j > 0) {
+                    previous = cost[i][j - 1];
+                }
+                cost[i][j] = previous + std::abs(from.midi[i] - to.midi[j]);
+            }
+        }
+        return cost[from.size - 1][to.size - 1];
+    }
+};
+
+/**
+ * Pitch classes of the first voicing that are not in the second one
+ */
+struct LostCommonTones {
+    int operator()(const Voicing& from, const Voicing& to) const {
+        unsigned kept = 0;
+        for (std::size_t i = 0; i < to.size; i++) {
+            kept |= 1u << (to.midi[i] % 12);
+        }
+        int lost = 0;
+        for (std::size_t i = 0; i < from.size; i++) {
+            lost += (kept >> (from.midi[i] % 12)) & 1u ? 0 : 1;
+        }
+        return lost;
+    }
+};
+
+/**
+ * A metric multiplied by a weight
+ */
+template<typename Metric>
+struct Weighted {
+    int weight;
+    Metric metric;
+
+    int operator()(const Voicing& from, const Voicing& to) const {
+        return weight == 0 ? 0 : weight * metric(from, to);
+    }
+};
+
+/**
+ * The sum of several metrics
+ */
+template<typename... Metrics>
+struct Sum {
+    std::tuple<Metrics...> metrics;
+
+    int operator()(const Voicing& from, const Voicing& to) const {
+        return std::apply([&](const Metrics&... m) { return (0 + ... + m(from, to)); }, metrics);
+    }
+};
+
+/**
+ * Multiply a metric by a weight
+ *
+ * @example
+ * weighted(2, Bass())
+ */
+template<typename Metric>
+Weighted<Metric> weighted(int weight, Metric metric = Metric()) {
+    return {weight, metric};
+}
+
+/**
+ * Add several metrics
+ *
+ * @example
+ * sum(TopNote(), weighted(2, Bass()))
+ */
+template<typename... Metrics>
+Sum<Metrics...> sum(Metrics... metrics) {
+    return {std::make_tuple(metrics...)};
+}
+
+/**
+ * Score all the candidates that could follow a voicing
+ *
+ * @param lastVoicing The previous voicing
+ * @param candidates Pointer to the first candidate
+ * @param count Number of candidates
+ * @param out Destination of the costs (must hold count values)
+ * @param metric The voice leading metric
+ */
+template<typename Metric>
+void scoreAll(const Voicing& lastVoicing, const Voicing* candidates, std::size_t count,
+              int* out, const Metric& metric = Metric()) {
+    for (std::size_t i = 0; i < count; i++) {
+        out[i] = metric(lastVoicing, candidates[i]);
+    }
+}
+
+/**
+ * Find the candidate with the lowest cost (the first one on ties)
+ *
+ * @param lastVoicing The previous voicing (if empty, the first candidate is chosen)
+ * @param candidates Pointer to the first candidate
+ * @param count Number of candidates
+ * @param metric The voice leading metric
+ * @return The index of the best candidate (count if there are no candidates)
+ */
+template<typename Metric>
+std::size_t best(const Voicing& lastVoicing, const Voicing* candidates, std::size_t count,
+                 const Metric& metric = Metric()) {
+    if (count == 0 || lastVoicing.empty()) {
+        return count == 0 ? count : 0;
+    }
+    std::size_t index = 0;
+    int lowest = metric(lastVoicing, candidates[0]);
+    for (std::size_t i = 1; i < count; i++) {
+        const int cost = metric(lastVoicing, candidates[i]);
+        if (cost < lowest) {
+            lowest = cost;
+            index = i;
+        }
+    }
+    return index;
+}
+
 } // namespace voice_leading
 } // namespace tonalcpp
\ No newline at end of file
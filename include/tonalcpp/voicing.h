@@ -1,7 +1,15 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory_resource>
 #include <vector>
 #include <string>
+#include "tonalcpp/thread_pool.h"
 #include "tonalcpp/voice_leading.h"
 #include "tonalcpp/voicing_dictionary.h"
 
@@ -23,6 +31,69 @@ extern const voicing_dictionary::VoicingDictionary& defaultDictionary;
  */
 extern const voice_leading::VoiceLeadingFunction& defaultVoiceLeading;
 
+/**
+ * A voicing as midi numbers (see voice_leading::Voicing)
+ */
+using voice_leading::Voicing;
+
+/**
+ * Build a voicing from note names (from bottom to top)
+ *
+ * @param notes The note names (e.g. {"C4", "E4", "G4"})
+ * @return The voicing (empty if any note is not valid or there are more than MAX_VOICES notes)
+ */
+Voicing fromNames(const std::vector<std::string>& notes);
+
+/**
+ * Search for all possible voicings of a chord within a range. Same results
+ * as search, but computed with integers (the dictionary patterns are parsed
+ * once and start notes are enumerated arithmetically) and without building
+ * note names.
+ *
+ * @param chord The chord name
+ * @param range The note range (defaults to ["C3", "C5"])
+ * @param dictionary The voicing dictionary to use (defaults to triads)
+ * @return Vector of all possible voicings
+ */
+std::vector<Voicing> searchMidi(
+    const std::string& chord,
+    const std::vector<std::string>& range = defaultRange,
+    const voicing_dictionary::VoicingDictionary& dictionary = voicing_dictionary::triads
+);
+
+/**
+ * Search for all possible voicings of a chord within a range, using a
+ * compiled dictionary
+ *
+ * @param chord The chord name
+ * @param range The note range
+ * @param dictionary The compiled voicing dictionary
+ * @return Vector of all possible voicings
+ */
+std::vector<Voicing> searchMidi(
+    const std::string& chord,
+    const std::vector<std::string>& range,
+    const voicing_dictionary::CompiledDictionary& dictionary
+);
+
+/**
+ * Find the voicings of a tonic and a list of compiled patterns within a midi
+ * range. This is the integer core used by searchMidi.
+ *
+ * @param tonicFifths The tonic pitch class as position in the circle of fifths (0 = C)
+ * @param patterns The compiled voicing patterns
+ * @param count Number of patterns
+ * @param range The midi numbers of the range ends (like range::numeric, segments are joined)
+ * @param out Found voicings are appended here
+ */
+void searchMidi(
+    int tonicFifths,
+    const voicing_dictionary::VoicingPattern* patterns,
+    std::size_t count,
+    const std::vector<int>& range,
+    std::vector<Voicing>& out
+);
+
 /**
  * Get a single voicing for a chord
  * @param chord The chord name
@@ -53,6 +124,38 @@ std::vector<std::vector<std::string>> search(
     const voicing_dictionary::VoicingDictionary& dictionary = voicing_dictionary::triads
 );
 
+/**
+ * Search for all possible voicings of a chord within a range, using a
+ * compiled dictionary
+ * @param chord The chord name
+ * @param range The note range
+ * @param dictionary The compiled voicing dictionary
+ * @return Vector of all possible voicings, each voicing being a vector of note names
+ */
+std::vector<std::vector<std::string>> search(
+    const std::string& chord,
+    const std::vector<std::string>& range,
+    const voicing_dictionary::CompiledDictionary& dictionary
+);
+
+/**
+ * Same as search, with the result allocated from a memory resource (like a
+ * per-request std::pmr::monotonic_buffer_resource). With the built-in
+ * dictionaries the candidate voicings go to per-thread scratch buffers
+ * instead of a temporary vector.
+ * @param resource The memory resource of the result
+ * @param chord The chord name
+ * @param range The note range (defaults to ["C3", "C5"])
+ * @param dictionary The voicing dictionary to use (defaults to triads)
+ * @return Vector of all possible voicings, each voicing being a vector of note names
+ */
+std::pmr::vector<std::pmr::vector<std::pmr::string>> search(
+    std::pmr::memory_resource* resource,
+    const std::string& chord,
+    const std::vector<std::string>& range = defaultRange,
+    const voicing_dictionary::VoicingDictionary& dictionary = voicing_dictionary::triads
+);
+
 /**
  * Voice a sequence of chords with voice leading
  * @param chords Vector of chord names
@@ -70,5 +173,238 @@ std::vector<std::vector<std::string>> sequence(
     const std::vector<std::string>& lastVoicing = {}
 );
 
+/**
+ * Weights of the built-in voice leading costs used by sequenceOptimal.
+ * The cost of moving from a voicing to the next one is the weighted sum of:
+ * - topNote: semitones moved by the top note
+ * - motion: semitones moved by all the voices (paired from the bottom; extra
+ *   voices are paired with the top voice of the smaller voicing)
+ * - commonTones: pitch classes of the previous voicing that are not kept
+ */
+struct SequenceWeights {
+    int topNote = 1;
+    int motion = 0;
+    int commonTones = 0;
+};
+
+/**
+ * A custom voice leading cost of moving between two voicings (lower is better)
+ */
+using TransitionCost = std::function<int(const Voicing& from, const Voicing& to)>;
+
+/**
+ * Value of sequenceOptimal indexes for chords without candidates
+ */
+constexpr std::size_t NO_VOICING = static_cast<std::size_t>(-1);
+
+/**
+ * Choose one voicing per chord minimizing the total voice leading cost of
+ * the whole sequence (instead of greedily, one chord at a time like
+ * sequence does). Runs in O(n·k²) for n chords of k candidates each.
+ *
+ * A chord without candidates breaks the sequence: the next chord is chosen
+ * as if it were the first one. Ties are resolved in favor of the lower
+ * candidates.
+ *
+ * @param candidates The candidate voicings of each chord (e.g. from searchMidi)
+ * @param metric The voice leading metric (see voice_leading::TopNote and others)
+ * @param lastVoicing The voicing before the first chord (optional)
+ * @return The index of the chosen candidate of each chord (NO_VOICING if it has none)
+ *
+ * @example
+ * sequenceOptimal(candidates, voice_leading::sum(voice_leading::TopNote(), voice_leading::Bass()))
+ */
+template<typename Metric>
+std::vector<std::size_t> sequenceOptimal(
+    const std::vector<std::vector<Voicing>>& candidates,
+    const Metric& metric,
+    const Voicing& lastVoicing = Voicing()
+) {
+    const std::size_t n = candidates.size();
+    std::vector<std::size_t> result(n, NO_VOICING);
+    
+    // Best predecessor of each candidate of each chord
+    std::vector<std::vector<std::uint32_t>> back(n);
+    std::vector<std::int64_t> prevTotal;
+    std::vector<std::int64_t> total;
+    // Transition costs from the previous chord, one row per current candidate
+    std::vector<int> matrix;
+    const std::vector<Voicing>* prev = nullptr;
+    
+    // Pick the best path ending at the chord before `end`
+    auto backtrack = [&](std::size_t end) {
+        if (prev == nullptr) return;
+        std::size_t best = static_cast<std::size_t>(
+            std::min_element(prevTotal.begin(), prevTotal.end()) - prevTotal.begin());
+        for (std::size_t i = end; i-- > 0 && !candidates[i].empty();) {
+            result[i] = best;
+            best = back[i][best];
+        }
+    };
+    
+    for (std::size_t i = 0; i < n; i++) {
+        const auto& current = candidates[i];
+        if (current.empty()) {
+            // Close the current segment and start a new one
+            backtrack(i);
+            prev = nullptr;
+            continue;
+        }
+        
+        const std::size_t k = current.size();
+        total.assign(k, 0);
+        back[i].assign(k, 0);
+        
+        if (prev == nullptr) {
+            if (i == 0 && !lastVoicing.empty()) {
+                matrix.resize(k);
+                voice_leading::scoreAll(lastVoicing, current.data(), k, matrix.data(), metric);
+                std::copy(matrix.begin(), matrix.end(), total.begin());
+            }
+        } else {
+            const std::size_t kp = prev->size();
+            matrix.resize(k * kp);
+            for (std::size_t j = 0; j < k; j++) {
+                int* row = matrix.data() + j * kp;
+                for (std::size_t p = 0; p < kp; p++) {
+                    row[p] = metric((*prev)[p], current[j]);
+                }
+            }
+            for (std::size_t j = 0; j < k; j++) {
+                const int* row = matrix.data() + j * kp;
+                std::int64_t lowest = std::numeric_limits<std::int64_t>::max();
+                std::uint32_t arg = 0;
+                for (std::size_t p = 0; p < kp; p++) {
+                    const std::int64_t value = prevTotal[p] + row[p];
+                    if (value < lowest) {
+                        lowest = value;
+                        arg = static_cast<std::uint32_t>(p);
+                    }
+                }
+                total[j] = lowest;
+                back[i][j] = arg;
+            }
+        }
+        
+        prevTotal.swap(total);
+        prev = &current;
+    }
+    backtrack(n);
+    
+    return result;
+}
+
+/**
+ * Same as the sequenceOptimal above using the built-in costs
+ *
+ * @param candidates The candidate voicings of each chord (e.g. from searchMidi)
+ * @param weights The weights of the built-in costs
+ * @param lastVoicing The voicing before the first chord (optional)
+ * @return The index of the chosen candidate of each chord (NO_VOICING if it has none)
+ */
+std::vector<std::size_t> sequenceOptimal(
+    const std::vector<std::vector<Voicing>>& candidates,
+    const SequenceWeights& weights = SequenceWeights(),
+    const Voicing& lastVoicing = Voicing()
+);
+
+/**
+ * Same as the sequenceOptimal above with a custom cost function
+ *
+ * @param candidates The candidate voicings of each chord
+ * @param cost The cost of moving from a voicing to another
+ * @param lastVoicing The voicing before the first chord (optional)
+ * @return The index of the chosen candidate of each chord (NO_VOICING if it has none)
+ */
+std::vector<std::size_t> sequenceOptimal(
+    const std::vector<std::vector<Voicing>>& candidates,
+    const TransitionCost& cost,
+    const Voicing& lastVoicing = Voicing()
+);
+
+/**
+ * Voice a sequence of chords minimizing the total voice leading cost
+ * (see the other sequenceOptimal)
+ *
+ * @param chords Vector of chord names
+ * @param range The note range (defaults to ["C3", "C5"])
+ * @param dictionary The voicing dictionary to use (defaults to all)
+ * @param weights The weights of the built-in costs (defaults to top note motion)
+ * @param lastVoicing The voicing before the first chord (optional)
+ * @return Vector of voicings, one for each chord (empty if the chord has no voicings)
+ */
+std::vector<std::vector<std::string>> sequenceOptimal(
+    const std::vector<std::string>& chords,
+    const std::vector<std::string>& range = defaultRange,
+    const voicing_dictionary::VoicingDictionary& dictionary = defaultDictionary,
+    const SequenceWeights& weights = SequenceWeights(),
+    const std::vector<std::string>& lastVoicing = {}
+);
+
+/**
+ * The voicings of many progressions stored in a single array
+ */
+struct VoicedProgressions {
+    std::vector<Voicing> voicings;     // All the voicings (empty for chords without voicings)
+    std::vector<std::size_t> offsets;  // Progression i is [offsets[i], offsets[i + 1])
+
+    /**
+     * Number of progressions
+     */
+    std::size_t size() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+
+    /**
+     * Get the voicings of a progression
+     */
+    const Voicing* begin(std::size_t i) const { return voicings.data() + offsets[i]; }
+    const Voicing* end(std::size_t i) const { return voicings.data() + offsets[i + 1]; }
+
+    /**
+     * Get the note names of a progression (same format as sequence)
+     */
+    std::vector<std::vector<std::string>> names(std::size_t i) const;
+};
+
+/**
+ * Voice many progressions in parallel. Each progression gives the same
+ * voicings as sequence with topNoteDiff, and the result doesn't depend on
+ * the number of threads.
+ *
+ * @param progressions Pointer to the first progression (a vector of chord names)
+ * @param count Number of progressions
+ * @param range The note range
+ * @param dictionary The compiled voicing dictionary
+ * @param pool The threads to use
+ * @return The voicings of all the progressions
+ */
+VoicedProgressions sequenceBatch(
+    const std::vector<std::string>* progressions,
+    std::size_t count,
+    const std::vector<std::string>& range,
+    const voicing_dictionary::CompiledDictionary& dictionary,
+    thread_pool::ThreadPool& pool
+);
+
+/**
+ * Voice many progressions in parallel with sequenceOptimal. The result
+ * doesn't depend on the number of threads.
+ *
+ * @param progressions Pointer to the first progression (a vector of chord names)
+ * @param count Number of progressions
+ * @param range The note range
+ * @param dictionary The compiled voicing dictionary
+ * @param pool The threads to use
+ * @param weights The weights of the built-in costs
+ * @return The voicings of all the progressions
+ */
+VoicedProgressions sequenceOptimalBatch(
+    const std::vector<std::string>* progressions,
+    std::size_t count,
+    const std::vector<std::string>& range,
+    const voicing_dictionary::CompiledDictionary& dictionary,
+    thread_pool::ThreadPool& pool,
+    const SequenceWeights& weights = SequenceWeights()
+);
+
 } // namespace voicing
 } // namespace tonalcpp
\ No newline at end of file
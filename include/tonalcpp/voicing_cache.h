@@ -0,0 +1,167 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "tonalcpp/voicing.h"
+#include "tonalcpp/voicing_dictionary.h"
+
+namespace tonalcpp {
+namespace voicing_cache {
+
+/**
+ * A list of candidate voicings shared between the cache and its users
+ */
+using Candidates = std::shared_ptr<const std::vector<voicing::Voicing>>;
+
+/**
+ * Cache usage counters
+ */
+struct Stats {
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    std::uint64_t evictions = 0;
+    std::size_t size = 0;      // Cached candidate lists
+    std::size_t capacity = 0;
+
+    /**
+     * Fraction of the lookups found in the cache (0 if there were none)
+     */
+    double hitRate() const {
+        const auto total = hits + misses;
+        return total == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(total);
+    }
+};
+
+/**
+ * A bounded cache of voicing search results. Lead sheets repeat the same
+ * few chords, so the candidates of each (chord, range, dictionary) are
+ * computed once and shared. Entries are keyed by the dictionary entry of the
+ * chord type (so "Cm7" and "C-7" share them), the tonic, the range ends and
+ * the dictionary; the least recently used entry is dropped when the cache
+ * is full.
+ *
+ * All the methods are thread-safe.
+ */
+class VoicingCache {
+public:
+    /**
+     * @param capacity Maximum number of cached candidate lists
+     */
+    explicit VoicingCache(std::size_t capacity = 1024);
+
+    VoicingCache(const VoicingCache&) = delete;
+    VoicingCache& operator=(const VoicingCache&) = delete;
+
+    /**
+     * Same as voicing::searchMidi, but cached. Only ranges with two ends are
+     * cached; other ranges are searched every time.
+     *
+     * @param chord The chord name
+     * @param range The note range
+     * @param dictionary The compiled voicing dictionary
+     * @return The candidate voicings (never null)
+     */
+    Candidates searchMidi(
+        const std::string& chord,
+        const std::vector<std::string>& range,
+        const voicing_dictionary::CompiledDictionary& dictionary
+    );
+
+    /**
+     * Same as voicing::searchMidi, but cached. The dictionary is compiled the
+     * first time it's used, and the compiled copy is found by the address of
+     * the dictionary. Only its number of entries is checked, so call
+     * invalidate(dictionary) after changing a dictionary, or before
+     * destroying it if another one may take its address. To avoid both,
+     * compile the dictionary once and use the CompiledDictionary overload:
+     * its id is never reused.
+     *
+     * @param chord The chord name
+     * @param range The note range (defaults to ["C3", "C5"])
+     * @param dictionary The voicing dictionary (defaults to triads)
+     * @return The candidate voicings (never null)
+     */
+    Candidates searchMidi(
+        const std::string& chord,
+        const std::vector<std::string>& range = voicing::defaultRange,
+        const voicing_dictionary::VoicingDictionary& dictionary = voicing_dictionary::triads
+    );
+
+    /**
+     * Forget everything cached about a dictionary. Must be called when a
+     * dictionary used with this cache is changed or destroyed.
+     */
+    void invalidate(const voicing_dictionary::VoicingDictionary& dictionary);
+
+    /**
+     * Forget the cached candidates of a compiled dictionary
+     */
+    void invalidate(const voicing_dictionary::CompiledDictionary& dictionary);
+
+    /**
+     * Forget everything
+     */
+    void clear();
+
+    /**
+     * Get the usage counters
+     */
+    Stats stats() const;
+
+    /**
+     * Reset the hit, miss and eviction counters
+     */
+    void resetStats();
+
+private:
+    struct Key {
+        std::uint64_t dictionary;
+        int entry;
+        int tonicFifths;
+        int low;
+        int high;
+
+        bool operator==(const Key& other) const {
+            return dictionary == other.dictionary && entry == other.entry &&
+                tonicFifths == other.tonicFifths && low == other.low && high == other.high;
+        }
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const;
+    };
+
+    using Entry = std::pair<Key, Candidates>;
+
+    std::size_t capacity;
+    mutable std::mutex mutex;
+    // Most recently used first
+    std::list<Entry> entries;
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> positions;
+    // Number of cached candidate lists of each dictionary, by id
+    std::unordered_map<std::uint64_t, std::size_t> cachedCounts;
+    // A compiled copy of a VoicingDictionary, and the number of entries it
+    // was compiled from
+    struct CompiledCopy {
+        std::size_t size = 0;
+        std::shared_ptr<const voicing_dictionary::CompiledDictionary> dictionary;
+    };
+    // The compiled copies of the VoicingDictionary maps, by address. A copy
+    // is dropped with the last candidate list of its dictionary
+    std::unordered_map<const voicing_dictionary::VoicingDictionary*, CompiledCopy> compiled;
+    Stats counters;
+
+    std::shared_ptr<const voicing_dictionary::CompiledDictionary> compile(
+        const voicing_dictionary::VoicingDictionary& dictionary);
+    void removeDictionary(std::uint64_t id);
+    void removeCompiled(std::uint64_t id);
+};
+
+} // namespace voicing_cache
+} // namespace tonalcpp
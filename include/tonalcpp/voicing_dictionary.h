@@ -1,9 +1,13 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <map>
 #include <optional>
+#include <unordered_map>
 
 namespace tonalcpp {
 namespace voicing_dictionary {
@@ -44,5 +48,182 @@ std::optional<std::vector<std::string>> lookup(
     const VoicingDictionary& dictionary = defaultDictionary
 );
 
+/**
+ * Maximum number of notes in a voicing pattern
+ */
+constexpr std::size_t MAX_VOICES = 8;
+
+/**
+ * A voicing pattern (like "3m 5P 7m 9M") parsed to integers. The notes are
+ * stored relative to the bottom note, which is itself an interval above the
+ * chord tonic. Semitones give the pitch and fifths (the position in the
+ * circle of fifths) give the spelling.
+ */
+struct VoicingPattern {
+    std::uint8_t size = 0;                          // Number of notes (0 = invalid pattern)
+    int bottomSemitones = 0;                        // Semitones from the tonic to the bottom note
+    int bottomFifths = 0;                           // Fifths from the tonic to the bottom note
+    std::array<std::int8_t, MAX_VOICES> semitones{}; // Semitones above the bottom note
+    std::array<std::int8_t, MAX_VOICES> fifths{};    // Fifths above the bottom note
+
+    bool operator==(const VoicingPattern& other) const {
+        return size == other.size && bottomSemitones == other.bottomSemitones &&
+            bottomFifths == other.bottomFifths && semitones == other.semitones &&
+            fifths == other.fifths;
+    }
+};
+
+/**
+ * Parse a voicing pattern. Patterns are parsed once and cached.
+ *
+ * @param pattern Space separated interval names (e.g. "3m 5P 7m 9M")
+ * @return The compiled pattern (size is 0 if it has no notes, invalid
+ * intervals or more than MAX_VOICES notes)
+ */
+VoicingPattern compilePattern(const std::string& pattern);
+
+/**
+ * The compiled patterns of a dictionary entry (a view into a CompiledDictionary)
+ */
+struct Patterns {
+    const VoicingPattern* first = nullptr;
+    const VoicingPattern* last = nullptr;
+
+    const VoicingPattern* begin() const { return first; }
+    const VoicingPattern* end() const { return last; }
+    std::size_t size() const { return static_cast<std::size_t>(last - first); }
+    bool empty() const { return first == last; }
+};
+
+/**
+ * A voicing dictionary with all the patterns parsed once and stored in a
+ * contiguous array. Entries can be found by symbol or by chord type id
+ * (the chord type set number), so chord names don't need to be matched
+ * against the symbols of the dictionary.
+ *
+ * The dictionary is immutable once built.
+ */
+class CompiledDictionary {
+public:
+    CompiledDictionary() = default;
+
+    /**
+     * Compile a voicing dictionary. Invalid patterns are skipped.
+     */
+    explicit CompiledDictionary(const VoicingDictionary& dictionary);
+
+    /**
+     * Find the patterns of a chord symbol. Like lookup, if the symbol is not
+     * in the dictionary the aliases of the chord are tried.
+     *
+     * @param symbol The chord symbol (e.g. "m7")
+     * @return The patterns (empty if not found)
+     */
+    Patterns find(const std::string& symbol) const;
+
+    /**
+     * Find the patterns of a chord type
+     *
+     * @param chordTypeId The chord type set number (see chord_type::ChordType::setNum)
+     * @return The patterns (empty if not found)
+     */
+    Patterns find(int chordTypeId) const;
+
+    /**
+     * Find the entry of a chord symbol (resolved like find). The symbols of
+     * the dictionary and all the chord type names and aliases are resolved
+     * when the dictionary is built, so this is usually a single hash lookup.
+     *
+     * @param symbol The chord symbol
+     * @return The index of the entry, or -1 if not found
+     */
+    int indexOf(const std::string& symbol) const;
+
+    /**
+     * Bulk version of indexOf
+     *
+     * @param symbols Pointer to the first symbol
+     * @param count Number of symbols
+     * @param out Destination of the entry indexes (-1 if not found)
+     */
+    void indexOf(const std::string* symbols, std::size_t count, int* out) const;
+
+    /**
+     * The precomputed resolution table: entry index of every dictionary
+     * symbol and chord type name or alias that resolves to an entry
+     */
+    const std::unordered_map<std::string, std::uint32_t>& resolutions() const { return resolved; }
+
+    /**
+     * Get the patterns of an entry
+     *
+     * @param index The index of the entry (see indexOf)
+     */
+    Patterns at(std::size_t index) const { return entry(static_cast<std::uint32_t>(index)); }
+
+    /**
+     * Identifier of this dictionary, unique for each compiled dictionary
+     * (copies share it). Useful as a cache key since the contents never change.
+     */
+    std::uint64_t id() const { return dictionaryId; }
+
+    /**
+     * Get the symbols of the dictionary (sorted)
+     */
+    const std::vector<std::string>& symbols() const { return entrySymbols; }
+
+    /**
+     * Number of entries (symbols) of the dictionary
+     */
+    std::size_t size() const { return entrySymbols.size(); }
+
+    bool empty() const { return entrySymbols.empty(); }
+
+    /**
+     * Convert back to a VoicingDictionary
+     */
+    VoicingDictionary toDictionary() const;
+
+private:
+    std::uint64_t dictionaryId = 0;
+    std::vector<VoicingPattern> patterns;
+    std::vector<std::string> sources;          // Pattern strings, parallel to patterns
+    std::vector<std::uint32_t> offsets;        // Patterns of entry i: [offsets[i], offsets[i + 1])
+    std::vector<std::string> entrySymbols;
+    std::unordered_map<std::string, std::uint32_t> bySymbol;
+    std::unordered_map<int, std::uint32_t> byChordType;
+    std::unordered_map<std::string, std::uint32_t> resolved;
+
+    Patterns entry(std::uint32_t i) const;
+    int resolve(const std::string& symbol) const;
+};
+
+/**
+ * Get the compiled version of a built-in dictionary, or nullptr if the
+ * dictionary is not one of triads, lefthand or all
+ */
+const CompiledDictionary* builtin(const VoicingDictionary& dictionary);
+
+/**
+ * Parse a voicing dictionary in text format. Each line has a chord symbol
+ * and its patterns separated by "|":
+ *
+ *     m7 = 3m 5P 7m 9M | 7m 9M 10m 12P
+ *
+ * Empty lines and lines starting with "#" are ignored.
+ *
+ * @param text The dictionary text
+ * @return The dictionary (empty if any line or pattern is not valid)
+ */
+CompiledDictionary parseDictionary(const std::string& text);
+
+/**
+ * Load a voicing dictionary in text format from disk (see parseDictionary)
+ *
+ * @param path Path to the file
+ * @return The dictionary (empty if the file can't be read or is not valid)
+ */
+CompiledDictionary loadDictionary(const std::string& path);
+
 } // namespace voicing_dictionary
 } // namespace tonalcpp
\ No newline at end of file
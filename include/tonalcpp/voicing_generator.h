@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "tonalcpp/voicing.h"
+
+namespace tonalcpp {
+namespace voicing_generator {
+
+/**
+ * Rules that the generated voicings must follow
+ */
+struct Constraints {
+    int minVoices = 3;                 // Minimum number of notes
+    int maxVoices = 4;                 // Maximum number of notes (at most MAX_VOICES)
+    int maxSpan = 19;                  // Maximum semitones between the bottom and top notes
+    // Chord intervals that can be left out (all the others are required)
+    std::vector<std::string> omittable = {"1P", "5P"};
+    // Notes below this midi note must be at least minLowInterval semitones
+    // apart from the note above them (to avoid muddy low voicings)
+    int lowRegister = 52;
+    int minLowInterval = 5;
+    bool doubleTensions = false;       // Whether 9ths, 11ths and 13ths can be doubled
+    // Maximum number of voicings. If not 0, only the voicings with the
+    // smallest span are kept
+    std::size_t limit = 0;
+};
+
+/**
+ * Generate all the voicings of a chord within a range that follow the
+ * constraints. Unlike voicing::search, voicings are not taken from a
+ * dictionary, so any chord type can be voiced. Notes are spelled like the
+ * chord notes. For slash chords (like "C^7/E") the bass note is the bottom
+ * note.
+ *
+ * Voicings are enumerated from the bottom note up, discarding partial
+ * voicings that can't be completed (too wide, not enough voices left for
+ * the missing required notes...). With a limit, partial voicings wider than
+ * the worst voicing kept are discarded too.
+ *
+ * @param chord The chord name
+ * @param range The note range (the lowest and highest notes are used)
+ * @param constraints The rules
+ * @return The voicings, by bottom note and then by the notes above it
+ * (by span first if there's a limit)
+ */
+std::vector<voicing::Voicing> generateMidi(
+    const std::string& chord,
+    const std::vector<std::string>& range = voicing::defaultRange,
+    const Constraints& constraints = Constraints()
+);
+
+/**
+ * Same as generateMidi, with the voicings as note names (like voicing::search)
+ */
+std::vector<std::vector<std::string>> generate(
+    const std::string& chord,
+    const std::vector<std::string>& range = voicing::defaultRange,
+    const Constraints& constraints = Constraints()
+);
+
+} // namespace voicing_generator
+} // namespace tonalcpp
@@ -0,0 +1,205 @@
+#include "tonalcpp/chart.h"
+#include "tonalcpp/helpers.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+
+namespace tonalcpp {
+namespace chart {
+
+namespace {
+
+// The chord of a "%" with no chord before it in the chunk
+constexpr std::uint32_t REPEAT = UINT32_MAX;
+
+// A part of the text, parsed on its own: bars and symbol ids are local
+struct Chunk {
+    std::string_view text;
+    ChordEvents events;
+    std::uint32_t bars = 0;
+    std::vector<std::string_view> symbols;
+    std::unordered_map<std::string_view, std::uint32_t> ids;
+};
+
+bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+void parseChunk(Chunk& chunk, int beatsPerBar) {
+    std::vector<std::uint32_t> bar;  // The chords of the current bar
+    const auto endBar = [&]() {
+        if (bar.empty()) {
+            return;
+        }
+        for (std::size_t i = 0; i < bar.size(); i++) {
+            const auto beat = static_cast<std::uint8_t>(i * beatsPerBar / bar.size());
+            chunk.events.push_back(chunk.bars, beat, bar[i]);
+        }
+        chunk.bars++;
+        bar.clear();
+    };
+
+    std::uint32_t previous = REPEAT;
+    bool lineStart = true;
+    const char* p = chunk.text.data();
+    const char* const end = p + chunk.text.size();
+    while (p < end) {
+        const char c = *p;
+        if (c == '\n') {
+            endBar();
+            lineStart = true;
+            p++;
+        } else if (isSpace(c)) {
+            p++;
+        } else if (lineStart && c == '#') {
+            const void* newline = std::memchr(p, '\n', static_cast<std::size_t>(end - p));
+            p = newline ? static_cast<const char*>(newline) : end;
+        } else if (c == '|') {
+            endBar();
+            lineStart = false;
+            p++;
+        } else {
+            lineStart = false;
+            const char* const start = p;
+            while (p < end && !isSpace(*p) && *p != '\n' && *p != '|') {
+                p++;
+            }
+            const std::string_view symbol(start, static_cast<std::size_t>(p - start));
+            if (symbol != "%") {
+                const auto id = static_cast<std::uint32_t>(chunk.symbols.size());
+                const auto inserted = chunk.ids.emplace(symbol, id);
+                if (inserted.second) {
+                    chunk.symbols.push_back(symbol);
+                }
+                previous = inserted.first->second;
+            }
+            bar.push_back(previous);
+        }
+    }
+    endBar();
+}
+
+// Split the text after the first line end of each chunkSize bytes
+std::vector<Chunk> split(std::string_view text, std::size_t chunkSize) {
+    std::vector<Chunk> chunks;
+    chunks.reserve(text.size() / std::max<std::size_t>(chunkSize, 1) + 1);
+    std::size_t begin = 0;
+    while (begin < text.size()) {
+        std::size_t end = text.size();
+        if (text.size() - begin > chunkSize) {
+            const std::size_t newline = text.find('\n', begin + std::max<std::size_t>(chunkSize, 1) - 1);
+            end = newline == std::string_view::npos ? text.size() : newline + 1;
+        }
+        chunks.emplace_back();
+        chunks.back().text = text.substr(begin, end - begin);
+        begin = end;
+    }
+    return chunks;
+}
+
+// Run body(begin, end) over count indexes, in the pool if there is one
+template <typename Body>
+void forEach(std::size_t count, thread_pool::ThreadPool* pool, Body body) {
+    if (pool == nullptr) {
+        body(0, count);
+        return;
+    }
+    pool->parallelFor(count, [&](std::size_t begin, std::size_t end, std::size_t) { body(begin, end); });
+}
+
+Chart build(std::string_view text, const ChartOptions& options, thread_pool::ThreadPool* pool) {
+    Chart chart;
+    chart.empty = false;
+    std::vector<Chunk> chunks = split(text, pool ? options.chunkSize : text.size());
+    const int beatsPerBar = std::clamp(options.beatsPerBar, 1, 255);
+    forEach(chunks.size(), pool, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            parseChunk(chunks[i], beatsPerBar);
+        }
+    });
+
+    // Merge the symbol tables, and find where each chunk goes
+    std::unordered_map<std::string_view, std::uint32_t> ids;
+    const auto globalId = [&](std::string_view symbol) {
+        const auto inserted = ids.emplace(symbol, static_cast<std::uint32_t>(chart.symbols.size()));
+        if (inserted.second) {
+            chart.symbols.emplace_back(symbol);
+        }
+        return inserted.first->second;
+    };
+    std::vector<std::vector<std::uint32_t>> remap(chunks.size());
+    std::vector<std::size_t> offsets(chunks.size());
+    std::vector<std::uint32_t> barOffsets(chunks.size());
+    // The chord repeated by a "%" at the start of each chunk
+    std::vector<std::uint32_t> repeated(chunks.size());
+    std::size_t events = 0;
+    std::uint32_t previous = REPEAT;
+    for (std::size_t c = 0; c < chunks.size(); c++) {
+        const Chunk& chunk = chunks[c];
+        if (previous == REPEAT && !chunk.events.empty() && chunk.events.chords[0] == REPEAT) {
+            // Nothing to repeat: "%" is a symbol
+            previous = globalId("%");
+        }
+        repeated[c] = previous;
+        remap[c].reserve(chunk.symbols.size());
+        for (std::string_view symbol : chunk.symbols) {
+            remap[c].push_back(globalId(symbol));
+        }
+        offsets[c] = events;
+        barOffsets[c] = chart.bars;
+        events += chunk.events.size();
+        chart.bars += chunk.bars;
+        if (!chunk.events.empty() && chunk.events.chords.back() != REPEAT) {
+            previous = remap[c][chunk.events.chords.back()];
+        }
+    }
+
+    chart.events.resize(events);
+    forEach(chunks.size(), pool, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t c = begin; c < end; c++) {
+            const ChordEvents& local = chunks[c].events;
+            for (std::size_t i = 0; i < local.size(); i++) {
+                const std::size_t e = offsets[c] + i;
+                chart.events.bars[e] = barOffsets[c] + local.bars[i];
+                chart.events.beats[e] = local.beats[i];
+                chart.events.chords[e] = local.chords[i] == REPEAT ? repeated[c] : remap[c][local.chords[i]];
+            }
+        }
+    });
+
+    chart.chords.resize(chart.symbols.size());
+    forEach(chart.symbols.size(), pool, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            chart.chords[i] = chord::get(chart.symbols[i]);
+        }
+    });
+    return chart;
+}
+
+std::string_view view(const helpers::MappedFile& file) {
+    return std::string_view(reinterpret_cast<const char*>(file.data()), file.size());
+}
+
+} // namespace
+
+Chart parse(std::string_view text, const ChartOptions& options) {
+    return build(text, options, nullptr);
+}
+
+Chart parse(std::string_view text, const ChartOptions& options, thread_pool::ThreadPool& pool) {
+    return build(text, options, &pool);
+}
+
+Chart load(const std::string& path, const ChartOptions& options) {
+    const helpers::MappedFile file(path);
+    return file.isOpen() ? build(view(file), options, nullptr) : Chart();
+}
+
+Chart load(const std::string& path, const ChartOptions& options, thread_pool::ThreadPool& pool) {
+    const helpers::MappedFile file(path);
+    return file.isOpen() ? build(view(file), options, &pool) : Chart();
+}
+
+} // namespace chart
+} // namespace tonalcpp
@@ -1,4 +1,5 @@
 #include "tonalcpp/chord.h"
+#include "tonalcpp/instrumentation.h"
 #include "tonalcpp/chord_detect.h"
 #include "tonalcpp/pcset.h"
 #include "tonalcpp/pitch_distance.h"
@@ -42,7 +43,7 @@ const Chord NoChord = {
     {}  // notes
 };
 
-ChordNameTokens tokenize(const std::string& name) {
+ChordNameTokens tokenize(std::string_view name) {
     auto [letter, acc, oct, type] = pitch_note::tokenizeNote(name);
     if (letter.empty()) {
         return tokenizeBass("", type);
@@ -53,27 +54,28 @@ ChordNameTokens tokenize(const std::string& name) {
     }
 }
 
-ChordNameTokens tokenizeBass(const std::string& note, const std::string& chord) {
+ChordNameTokens tokenizeBass(std::string_view note, std::string_view chord) {
     // Split by slash for bass note
     size_t slashPos = chord.find('/');
-    if (slashPos == std::string::npos) {
-        return {note, chord, ""};
+    if (slashPos == std::string_view::npos) {
+        return {std::string(note), std::string(chord), ""};
     }
     
-    std::string chordPart = chord.substr(0, slashPos);
-    std::string bassPart = chord.substr(slashPos + 1);
+    std::string_view chordPart = chord.substr(0, slashPos);
+    std::string_view bassPart = chord.substr(slashPos + 1);
     
     auto [bassLetter, bassAcc, bassOct, bassType] = pitch_note::tokenizeNote(bassPart);
     
     // Only a pitch class is accepted as bass note
     if (!bassLetter.empty() && bassOct.empty() && bassType.empty()) {
-        return {note, chordPart, bassLetter + bassAcc};
+        return {std::string(note), std::string(chordPart), bassLetter + bassAcc};
     } else {
-        return {note, chord, ""};
+        return {std::string(note), std::string(chord), ""};
     }
 }
 
-Chord get(const std::string& src) {
+Chord get(std::string_view src) {
+    TONAL_PROBE("chord::get");
     if (src.empty()) {
         return NoChord;
     }
@@ -89,6 +91,10 @@ Chord get(const std::string& src) {
     return result;
 }
 
+intern::Handle symbolHandle(std::string_view name) {
+    return intern::intern(get(name).symbol);
+}
+
 Chord get(const std::vector<std::string>& tokens) {
     if (tokens.empty()) {
         return NoChord;
@@ -101,9 +107,9 @@ Chord get(const std::vector<std::string>& tokens) {
     return getChord(type, tonic, bass);
 }
 
-Chord getChord(const std::string& typeName, 
-               const std::string& optionalTonic, 
-               const std::string& optionalBass) {
+Chord getChord(std::string_view typeName, 
+               std::string_view optionalTonic, 
+               std::string_view optionalBass) {
     chord_type::ChordType type = chord_type::getChordType(typeName);
     pitch_note::Note tonic = pitch_note::note(optionalTonic);
     pitch_note::Note bass = pitch_note::note(optionalBass);
@@ -174,7 +180,7 @@ Chord getChord(const std::string& typeName,
     
     // Generate chord name and symbol
     std::string preferredAlias = !type.aliases.empty() && std::find(type.aliases.begin(), type.aliases.end(), typeName) != type.aliases.end() 
-        ? typeName 
+        ? std::string(typeName) 
         : (!type.aliases.empty() ? type.aliases[0] : "");
     
     // Build chord symbol
@@ -321,6 +327,25 @@ std::vector<std::string> notes(const std::string& chordName, const std::string&
     return result;
 }
 
+std::pmr::vector<std::pmr::string> notes(
+    std::pmr::memory_resource* resource,
+    const std::string& chordName,
+    const std::string& tonic) {
+    std::pmr::vector<std::pmr::string> result(resource);
+    const Chord chord = get(chordName);
+    const std::string& noteToUse = !tonic.empty() ? tonic : chord.tonic.value_or("");
+    if (noteToUse.empty() || chord.empty) {
+        return result;
+    }
+    
+    result.reserve(chord.intervals.size());
+    for (const auto& ivl : chord.intervals) {
+        result.emplace_back(pitch_distance::transpose(noteToUse, ivl));
+    }
+    
+    return result;
+}
+
 std::vector<std::string> notes(const std::vector<std::string>& tokens, const std::string& tonic) {
     return notes(tokens.empty() ? "" : tokens[0], tonic);
 }
@@ -1,4 +1,5 @@
 #include "tonalcpp/chord_detect.h"
+#include "tonalcpp/instrumentation.h"
 #include <algorithm>
 #include <bitset>
 #include <functional>
@@ -140,6 +141,7 @@ std::vector<std::string> detect(
     const std::vector<std::string>& source,
     const DetectOptions& options
 ) {
+    TONAL_PROBE("chord_detect::detect");
     // Filter to valid note names with pitch classes
     std::vector<std::string> notes;
     for (const auto& n : source) {
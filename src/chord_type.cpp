@@ -2,14 +2,21 @@
 #include "tonalcpp/pcset.h"
 #include "tonalcpp/helpers.h"
 #include <algorithm>
+#include <mutex>
+#include <shared_mutex>
 #include <sstream>
 
 namespace tonalcpp {
 namespace chord_type {
 
-// Dictionary to store chord types
+// Dictionary to store chord types, and the position of each key in it
 static std::vector<ChordType> dictionary;
-static std::unordered_map<std::string, ChordType> index;
+static helpers::StringMap<std::size_t> index;
+
+// Readers take a shared lock. Writers take writerMutex for the whole
+// update, and a unique lock only while they change the dictionary
+static std::shared_mutex dictionaryMutex;
+static std::mutex writerMutex;
 
 // Empty chord type definition
 const ChordType NoChordType = {
@@ -171,20 +178,21 @@ ChordQuality getQuality(const std::vector<std::string>& intervals) {
     }
 }
 
-// Add an alias to the index
-void addAlias(const ChordType& chord, const std::string& alias) {
-    index[alias] = chord;
-}
+static void loadChordTypes();
 
-// Using split from helpers namespace
+static std::once_flag loaded;
 
-// Add a chord to the dictionary
-void add(const std::vector<std::string>& intervals, 
-         const std::vector<std::string>& aliases, 
-         const std::string& fullName) {
-    
-    ChordQuality quality = getQuality(intervals);
-    
+// Load the predefined chords on first use. Doing it during static
+// initialization depends on the initialization order of the other
+// translation units (the note and pcset caches)
+static void ensureInitialized() {
+    std::call_once(loaded, loadChordTypes);
+}
+
+// Create a chord type
+static ChordType makeChordType(const std::vector<std::string>& intervals,
+                               const std::vector<std::string>& aliases,
+                               const std::string& fullName) {
     // Create a Pcset first
     pcset::Pcset pcsetData = pcset::getPcset(intervals);
     
@@ -199,40 +207,138 @@ void add(const std::vector<std::string>& intervals,
     
     // Add ChordType specific members
     chord.name = fullName;
-    chord.quality = quality;
+    chord.quality = getQuality(intervals);
     chord.aliases = aliases;
-    
-    // Add to the dictionary
-    dictionary.push_back(chord);
-    
-    // Add to the index
+    return chord;
+}
+
+// Add the keys of the chord at a position of the dictionary to an index
+static void indexChordType(helpers::StringMap<std::size_t>& target,
+                           const ChordType& chord,
+                           std::size_t position) {
     if (!chord.name.empty()) {
-        index[chord.name] = chord;
+        target[chord.name] = position;
     }
     
-    index[std::to_string(chord.setNum)] = chord;
-    index[chord.chroma] = chord;
+    target[std::to_string(chord.setNum)] = position;
+    target[chord.chroma] = position;
     
     // Add each alias to the index
     for (const auto& alias : chord.aliases) {
-        addAlias(chord, alias);
+        target[alias] = position;
     }
 }
 
-// Get chord type by name, chroma, or set number
-ChordType getChordType(const std::string& type) {
-    auto it = index.find(type);
-    if (it != index.end()) {
-        return it->second;
+// Replace the dictionary, indexing it in one pass: a key of several chords
+// finds the last one. The caller holds writerMutex. The readers see the old
+// or the new dictionary, never a part of each
+static void publish(std::vector<ChordType> chords) {
+    std::size_t keyCount = 0;
+    for (const auto& chord : chords) {
+        keyCount += 3 + chord.aliases.size();
+    }
+    helpers::StringMap<std::size_t> nextIndex;
+    nextIndex.reserve(keyCount);
+    for (std::size_t i = 0; i < chords.size(); i++) {
+        indexChordType(nextIndex, chords[i], i);
     }
     
-    // Try to interpret as a chroma
-    if (pcset::isChroma(type)) {
-        auto it2 = index.find(type);
-        if (it2 != index.end()) {
-            return it2->second;
+    std::unique_lock<std::shared_mutex> lock(dictionaryMutex);
+    dictionary.swap(chords);
+    index = std::move(nextIndex);
+}
+
+// Find a chord of the dictionary by name and intervals
+static std::size_t position(const ChordType& chord) {
+    for (std::size_t i = 0; i < dictionary.size(); i++) {
+        if (dictionary[i].name == chord.name && dictionary[i].chroma == chord.chroma) {
+            return i;
         }
     }
+    return dictionary.size();
+}
+
+// Add an alias to the chord and the index
+void addAlias(const ChordType& chord, const std::string& alias) {
+    ensureInitialized();
+    std::lock_guard<std::mutex> writer(writerMutex);
+    const std::size_t i = position(chord);
+    if (i < dictionary.size()) {
+        std::unique_lock<std::shared_mutex> lock(dictionaryMutex);
+        dictionary[i].aliases.push_back(alias);
+        index[alias] = i;
+    }
+}
+
+// Add a chord to the dictionary
+void add(const std::vector<std::string>& intervals, 
+         const std::vector<std::string>& aliases, 
+         const std::string& fullName) {
+    ensureInitialized();
+    ChordType chord = makeChordType(intervals, aliases, fullName);
+    std::lock_guard<std::mutex> writer(writerMutex);
+    std::unique_lock<std::shared_mutex> lock(dictionaryMutex);
+    dictionary.push_back(std::move(chord));
+    indexChordType(index, dictionary.back(), dictionary.size() - 1);
+}
+
+// Add the chords to a copy of the dictionary, and publish it. The caller
+// holds writerMutex, so the dictionary doesn't change meanwhile
+static void addChordTypes(std::vector<ChordType> chords) {
+    std::vector<ChordType> next;
+    next.reserve(dictionary.size() + chords.size());
+    next.insert(next.end(), dictionary.begin(), dictionary.end());
+    helpers::mergeTypes(next, std::move(chords));
+    publish(std::move(next));
+}
+
+bool addAll(const Definition* definitions, std::size_t count) {
+    ensureInitialized();
+    std::vector<ChordType> chords(count);
+    // The normalized chroma of each set number, when needed
+    std::vector<std::string> normalized(4096);
+    for (std::size_t i = 0; i < count; i++) {
+        const Definition& definition = definitions[i];
+        ChordType& chord = chords[i];
+        chord.chroma = pcset::intervalsChroma(definition.intervals);
+        if (chord.chroma.empty()) {
+            return false;
+        }
+        chord.empty = false;
+        chord.setNum = pcset::chromaToNumber(chord.chroma);
+        if (normalized[chord.setNum].empty()) {
+            normalized[chord.setNum] = pcset::getPcset(chord.chroma).normalized;
+        }
+        chord.normalized = normalized[chord.setNum];
+        chord.intervals = definition.intervals;
+        chord.name = definition.name;
+        chord.quality = getQuality(definition.intervals);
+        chord.aliases = definition.aliases;
+    }
+    
+    std::lock_guard<std::mutex> writer(writerMutex);
+    addChordTypes(std::move(chords));
+    return true;
+}
+
+bool addAll(const std::vector<Definition>& definitions) {
+    return addAll(definitions.data(), definitions.size());
+}
+
+void addAll(const ChordType* types, std::size_t count) {
+    ensureInitialized();
+    std::vector<ChordType> chords(types, types + count);
+    std::lock_guard<std::mutex> writer(writerMutex);
+    addChordTypes(std::move(chords));
+}
+
+// Get chord type by name, chroma, or set number
+ChordType getChordType(std::string_view type) {
+    ensureInitialized();
+    std::shared_lock<std::shared_mutex> lock(dictionaryMutex);
+    if (const std::size_t* found = index.find(type)) {
+        return dictionary[*found];
+    }
     
     return NoChordType;
 }
@@ -243,6 +349,8 @@ ChordType getChordType(int type) {
 
 // Get all chord names
 std::vector<std::string> names() {
+    ensureInitialized();
+    std::shared_lock<std::shared_mutex> lock(dictionaryMutex);
     std::vector<std::string> result;
     
     for (const auto& chord : dictionary) {
@@ -256,6 +364,8 @@ std::vector<std::string> names() {
 
 // Get all chord symbols
 std::vector<std::string> symbols() {
+    ensureInitialized();
+    std::shared_lock<std::shared_mutex> lock(dictionaryMutex);
     std::vector<std::string> result;
     
     for (const auto& chord : dictionary) {
@@ -269,10 +379,12 @@ std::vector<std::string> symbols() {
 
 // Get all keys in the index
 std::vector<std::string> keys() {
+    ensureInitialized();
+    std::shared_lock<std::shared_mutex> lock(dictionaryMutex);
     std::vector<std::string> result;
     
     for (const auto& pair : index) {
-        result.push_back(pair.first);
+        result.emplace_back(pair.first);
     }
     
     return result;
@@ -280,19 +392,24 @@ std::vector<std::string> keys() {
 
 // Get all chord types
 std::vector<ChordType> all() {
+    ensureInitialized();
+    std::shared_lock<std::shared_mutex> lock(dictionaryMutex);
     return dictionary;
 }
 
 // Clear the dictionary
 void removeAll() {
+    ensureInitialized();
+    std::lock_guard<std::mutex> writer(writerMutex);
+    std::unique_lock<std::shared_mutex> lock(dictionaryMutex);
     dictionary.clear();
     index.clear();
 }
 
-// Initialize the chord dictionary with the predefined data
-void initChordTypes() {
-    // Clear any existing data
-    removeAll();
+// Fill the chord dictionary with the predefined data
+static void loadChordTypes() {
+    std::vector<ChordType> chords;
+    chords.reserve(CHORDS.size());
     
     // Add each chord from the CHORDS data
     for (const auto& chordData : CHORDS) {
@@ -301,27 +418,31 @@ void initChordTypes() {
         const auto& fullName = chordData[1];
         const auto& aliases = helpers::split(chordData[2]);
         
-        // Add to the dictionary
-        add(intervals, aliases, fullName);
+        chords.push_back(makeChordType(intervals, aliases, fullName));
     }
     
-    // Sort dictionary by setNum (as in the TypeScript code)
-    std::sort(dictionary.begin(), dictionary.end(), 
+    // Sort dictionary by setNum (as in the TypeScript code). The sort is
+    // stable, so the chords with the same chroma keep their order and the
+    // index finds the last one defined
+    std::stable_sort(chords.begin(), chords.end(), 
         [](const ChordType& a, const ChordType& b) {
             return a.setNum < b.setNum;
         });
+    std::lock_guard<std::mutex> writer(writerMutex);
+    publish(std::move(chords));
 }
 
-// Constructor function to initialize dictionary when the module is loaded
-namespace {
-    struct InitializerHelper {
-        InitializerHelper() {
-            initChordTypes();
-        }
-    };
-    
-    // This instance's constructor will be called when the module is loaded
-    static InitializerHelper initializer;
+// Initialize the chord dictionary with the predefined data
+void initChordTypes() {
+    // Load them once: on the first use, ensureInitialized does it
+    bool first = false;
+    std::call_once(loaded, [&first]() {
+        loadChordTypes();
+        first = true;
+    });
+    if (!first) {
+        loadChordTypes();
+    }
 }
 
 } // namespace chord_type
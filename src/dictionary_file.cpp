@@ -0,0 +1,648 @@
+#include "tonalcpp/dictionary_file.h"
+#include "tonalcpp/pitch_interval.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+#include <utility>
+
+namespace tonalcpp {
+namespace dictionary_file {
+
+namespace {
+
+constexpr std::size_t HEADER_SIZE = 32;
+constexpr std::size_t ENTRY_SIZE = 12 * 4;
+constexpr std::size_t REF_SIZE = 2 * 4;
+constexpr std::size_t SLOT_SIZE = 3 * 4;
+// A compiled pattern: size, bottom semitones and fifths, semitones and
+// fifths of each voice, and a padding byte
+constexpr std::size_t COMPILED_PATTERN_SIZE = 3 + 2 * voicing_dictionary::MAX_VOICES + 1;
+// Files of this VERSION have 20 byte patterns: they can't be read with
+// another MAX_VOICES
+static_assert(COMPILED_PATTERN_SIZE == 20, "Bump VERSION when MAX_VOICES changes, and update this size");
+constexpr std::size_t PATTERN_SIZE = REF_SIZE + COMPILED_PATTERN_SIZE;
+constexpr std::size_t CHROMA_SIZE = 12;
+
+// Fields of an entry
+enum Field {
+    NAME_OFFSET, NAME_LENGTH, SET_NUM, QUALITY, CHROMA, NORMALIZED,
+    INTERVALS_FIRST, INTERVALS_COUNT, ALIASES_FIRST, ALIASES_COUNT, PATTERNS_FIRST, PATTERNS_COUNT,
+};
+
+std::uint32_t u32(const std::uint8_t* p) {
+    return std::uint32_t(p[0]) | (std::uint32_t(p[1]) << 8) | (std::uint32_t(p[2]) << 16) |
+           (std::uint32_t(p[3]) << 24);
+}
+
+std::uint16_t u16(const std::uint8_t* p) {
+    return static_cast<std::uint16_t>(p[0] | (p[1] << 8));
+}
+
+void putU32(std::vector<std::uint8_t>& out, std::uint32_t value) {
+    out.insert(out.end(), {std::uint8_t(value), std::uint8_t(value >> 8), std::uint8_t(value >> 16),
+                           std::uint8_t(value >> 24)});
+}
+
+// FNV-1a: stable between platforms and runs, so it can be stored
+std::uint32_t hash(std::string_view key) {
+    std::uint32_t h = 2166136261u;
+    for (char c : key) {
+        h = (h ^ static_cast<std::uint8_t>(c)) * 16777619u;
+    }
+    return h;
+}
+
+std::size_t align(std::size_t size) {
+    return (size + 3) & ~std::size_t(3);
+}
+
+// An entry before encoding
+struct Source {
+    std::string name;
+    int setNum = 0;
+    chord_type::ChordQuality quality = chord_type::ChordQuality::Unknown;
+    std::string chroma;
+    std::string normalized;
+    std::vector<std::string> intervals;
+    std::vector<std::string> aliases;
+    std::vector<std::string> patterns;
+};
+
+// Distinct strings, in insertion order
+class Pool {
+public:
+    std::uint32_t add(const std::string& str) {
+        auto found = offsets.find(str);
+        if (found != offsets.end()) {
+            return found->second;
+        }
+        const auto offset = static_cast<std::uint32_t>(bytes.size());
+        bytes.insert(bytes.end(), str.begin(), str.end());
+        offsets.emplace(str, offset);
+        return offset;
+    }
+
+    std::string bytes;
+
+private:
+    std::unordered_map<std::string, std::uint32_t> offsets;
+};
+
+std::vector<std::uint8_t> encode(Kind kind, const std::vector<Source>& sources) {
+    Pool pool;
+    std::vector<std::uint8_t> entries;
+    std::vector<std::uint8_t> refs;
+    std::vector<std::uint8_t> patterns;
+    std::size_t refCount = 0;
+    std::size_t patternCount = 0;
+
+    const auto addRefs = [&](const std::vector<std::string>& strings) {
+        putU32(entries, static_cast<std::uint32_t>(refCount));
+        putU32(entries, static_cast<std::uint32_t>(strings.size()));
+        for (const std::string& str : strings) {
+            putU32(refs, pool.add(str));
+            putU32(refs, static_cast<std::uint32_t>(str.size()));
+        }
+        refCount += strings.size();
+    };
+
+    // Keys in insertion order. A key added again points to the last entry
+    std::vector<std::string> keys;
+    std::unordered_map<std::string, std::uint32_t> keyEntries;
+    const auto addKey = [&](const std::string& key, std::uint32_t entry) {
+        if (keyEntries.emplace(key, entry).second) {
+            keys.push_back(key);
+        } else {
+            keyEntries[key] = entry;
+        }
+    };
+
+    for (std::size_t i = 0; i < sources.size(); i++) {
+        const Source& source = sources[i];
+        const auto entry = static_cast<std::uint32_t>(i);
+        putU32(entries, pool.add(source.name));
+        putU32(entries, static_cast<std::uint32_t>(source.name.size()));
+        putU32(entries, static_cast<std::uint32_t>(source.setNum));
+        putU32(entries, static_cast<std::uint32_t>(source.quality));
+        putU32(entries, pool.add(source.chroma));
+        putU32(entries, pool.add(source.normalized));
+        addRefs(source.intervals);
+        addRefs(source.aliases);
+        putU32(entries, static_cast<std::uint32_t>(patternCount));
+        putU32(entries, static_cast<std::uint32_t>(source.patterns.size()));
+        for (const std::string& str : source.patterns) {
+            const voicing_dictionary::VoicingPattern pattern = voicing_dictionary::compilePattern(str);
+            putU32(patterns, pool.add(str));
+            putU32(patterns, static_cast<std::uint32_t>(str.size()));
+            patterns.push_back(pattern.size);
+            patterns.push_back(static_cast<std::uint8_t>(pattern.bottomSemitones));
+            patterns.push_back(static_cast<std::uint8_t>(pattern.bottomFifths));
+            for (std::size_t v = 0; v < voicing_dictionary::MAX_VOICES; v++) {
+                patterns.push_back(static_cast<std::uint8_t>(pattern.semitones[v]));
+                patterns.push_back(static_cast<std::uint8_t>(pattern.fifths[v]));
+            }
+            patterns.push_back(0);  // Padding (see COMPILED_PATTERN_SIZE)
+        }
+        patternCount += source.patterns.size();
+
+        if (kind == Kind::Voicings) {
+            addKey(source.name, entry);
+            continue;
+        }
+        // The keys of the chord_type index, in the same order
+        if (!source.name.empty()) {
+            addKey(source.name, entry);
+        }
+        addKey(std::to_string(source.setNum), entry);
+        addKey(source.chroma, entry);
+        for (const std::string& alias : source.aliases) {
+            addKey(alias, entry);
+        }
+    }
+
+    // At most half full, so probes are short
+    std::size_t slotCount = 1;
+    while (slotCount < keys.size() * 2) {
+        slotCount *= 2;
+    }
+    std::vector<std::uint32_t> slots(slotCount * 3, 0);
+    for (const std::string& key : keys) {
+        std::size_t slot = hash(key) & (slotCount - 1);
+        while (slots[slot * 3 + 2] != 0) {
+            slot = (slot + 1) & (slotCount - 1);
+        }
+        slots[slot * 3] = pool.add(key);
+        slots[slot * 3 + 1] = static_cast<std::uint32_t>(key.size());
+        slots[slot * 3 + 2] = keyEntries[key] + 1;
+    }
+
+    std::vector<std::uint8_t> out = {'T', 'N', 'L', 'D', std::uint8_t(VERSION), std::uint8_t(VERSION >> 8),
+                                     std::uint8_t(kind), std::uint8_t(static_cast<std::uint16_t>(kind) >> 8)};
+    putU32(out, static_cast<std::uint32_t>(sources.size()));
+    putU32(out, static_cast<std::uint32_t>(slotCount));
+    putU32(out, static_cast<std::uint32_t>(refCount));
+    putU32(out, static_cast<std::uint32_t>(patternCount));
+    putU32(out, static_cast<std::uint32_t>(pool.bytes.size()));
+    putU32(out, 0);
+    out.insert(out.end(), entries.begin(), entries.end());
+    out.insert(out.end(), refs.begin(), refs.end());
+    for (std::uint32_t value : slots) {
+        putU32(out, value);
+    }
+    out.insert(out.end(), patterns.begin(), patterns.end());
+    out.insert(out.end(), pool.bytes.begin(), pool.bytes.end());
+    out.resize(align(out.size()), 0);
+    return out;
+}
+
+Source fromPcset(const pcset::Pcset& set, const std::vector<std::string>& aliases) {
+    Source source;
+    source.name = set.name;
+    source.setNum = set.setNum;
+    source.chroma = set.chroma;
+    source.normalized = set.normalized;
+    source.intervals = set.intervals;
+    source.aliases = aliases;
+    return source;
+}
+
+std::string_view trim(std::string_view str) {
+    const auto first = str.find_first_not_of(" \t\r");
+    if (first == std::string_view::npos) {
+        return {};
+    }
+    return str.substr(first, str.find_last_not_of(" \t\r") - first + 1);
+}
+
+// Parse "name = intervals | alias | alias"
+bool parseType(std::string_view line, Source& source) {
+    const auto equals = line.find('=');
+    if (equals == std::string_view::npos) {
+        return false;
+    }
+    std::vector<std::string_view> fields;
+    std::string_view rest = line.substr(equals + 1);
+    while (true) {
+        const auto bar = rest.find('|');
+        fields.push_back(trim(rest.substr(0, bar)));
+        if (bar == std::string_view::npos) break;
+        rest = rest.substr(bar + 1);
+    }
+
+    std::vector<std::string> intervals;
+    std::string_view list = fields[0];
+    while (!list.empty()) {
+        const auto space = list.find(' ');
+        const std::string_view name = list.substr(0, space);
+        if (!name.empty()) {
+            if (pitch_interval::interval(name).empty) {
+                return false;
+            }
+            intervals.emplace_back(name);
+        }
+        if (space == std::string_view::npos) break;
+        list = list.substr(space + 1);
+    }
+    if (intervals.empty()) {
+        return false;
+    }
+
+    const pcset::Pcset set = pcset::getPcset(intervals);
+    source = fromPcset(set, {});
+    source.name = std::string(trim(line.substr(0, equals)));
+    source.quality = chord_type::getQuality(intervals);
+    for (std::size_t i = 1; i < fields.size(); i++) {
+        if (fields[i].empty()) {
+            return false;
+        }
+        source.aliases.emplace_back(fields[i]);
+    }
+    return true;
+}
+
+} // namespace
+
+std::string_view Strings::operator[](std::size_t i) const {
+    const std::uint8_t* ref = refs + i * REF_SIZE;
+    return std::string_view(pool + u32(ref), u32(ref + 4));
+}
+
+std::vector<std::string> Strings::toVector() const {
+    std::vector<std::string> result;
+    result.reserve(count);
+    for (std::size_t i = 0; i < count; i++) {
+        result.emplace_back((*this)[i]);
+    }
+    return result;
+}
+
+std::uint32_t Entry::field(std::size_t i) const {
+    return u32(record + i * 4);
+}
+
+std::string_view Entry::name() const {
+    return std::string_view(dictionary->pool + field(NAME_OFFSET), field(NAME_LENGTH));
+}
+
+int Entry::setNum() const {
+    return static_cast<int>(field(SET_NUM));
+}
+
+std::string_view Entry::chroma() const {
+    return std::string_view(dictionary->pool + field(CHROMA), CHROMA_SIZE);
+}
+
+std::string_view Entry::normalized() const {
+    return std::string_view(dictionary->pool + field(NORMALIZED), CHROMA_SIZE);
+}
+
+chord_type::ChordQuality Entry::quality() const {
+    return static_cast<chord_type::ChordQuality>(field(QUALITY));
+}
+
+Strings Entry::intervals() const {
+    return Strings(dictionary->refTable + field(INTERVALS_FIRST) * REF_SIZE, dictionary->pool,
+                   field(INTERVALS_COUNT));
+}
+
+Strings Entry::aliases() const {
+    return Strings(dictionary->refTable + field(ALIASES_FIRST) * REF_SIZE, dictionary->pool,
+                   field(ALIASES_COUNT));
+}
+
+std::size_t Entry::patternCount() const {
+    return field(PATTERNS_COUNT);
+}
+
+std::string_view Entry::patternSource(std::size_t i) const {
+    return dictionary->string(dictionary->patternTable + (field(PATTERNS_FIRST) + i) * PATTERN_SIZE);
+}
+
+voicing_dictionary::VoicingPattern Entry::pattern(std::size_t i) const {
+    const std::uint8_t* p = dictionary->patternTable + (field(PATTERNS_FIRST) + i) * PATTERN_SIZE + REF_SIZE;
+    voicing_dictionary::VoicingPattern pattern;
+    pattern.size = p[0];
+    pattern.bottomSemitones = static_cast<std::int8_t>(p[1]);
+    pattern.bottomFifths = static_cast<std::int8_t>(p[2]);
+    for (std::size_t v = 0; v < voicing_dictionary::MAX_VOICES; v++) {
+        pattern.semitones[v] = static_cast<std::int8_t>(p[3 + v * 2]);
+        pattern.fifths[v] = static_cast<std::int8_t>(p[4 + v * 2]);
+    }
+    return pattern;
+}
+
+Dictionary::Dictionary(const std::string& path) : mapped(path) {
+    if (mapped.isOpen()) {
+        open(mapped.data(), mapped.size());
+    }
+}
+
+Dictionary::Dictionary(const std::uint8_t* data, std::size_t size) {
+    open(data, size);
+}
+
+Dictionary::Dictionary(std::vector<std::uint8_t> bytes) : owned(std::move(bytes)) {
+    open(owned.data(), owned.size());
+}
+
+// The views point into the mapping or the vector, which don't move
+Dictionary::Dictionary(Dictionary&& other) noexcept {
+    *this = std::move(other);
+}
+
+Dictionary& Dictionary::operator=(Dictionary&& other) noexcept {
+    if (this != &other) {
+        mapped = std::move(other.mapped);
+        owned = std::move(other.owned);
+        data = other.data;
+        length = other.length;
+        fileKind = other.fileKind;
+        entries = other.entries;
+        slots = other.slots;
+        refs = other.refs;
+        patterns = other.patterns;
+        entryTable = other.entryTable;
+        refTable = other.refTable;
+        slotTable = other.slotTable;
+        patternTable = other.patternTable;
+        pool = other.pool;
+        poolSize = other.poolSize;
+        other.reset();
+    }
+    return *this;
+}
+
+void Dictionary::reset() {
+    data = nullptr;
+    length = 0;
+    entries = slots = refs = patterns = poolSize = 0;
+    entryTable = refTable = slotTable = patternTable = nullptr;
+    pool = nullptr;
+}
+
+std::string_view Dictionary::string(const std::uint8_t* ref) const {
+    return std::string_view(pool + u32(ref), u32(ref + 4));
+}
+
+void Dictionary::open(const std::uint8_t* bytes, std::size_t size) {
+    reset();
+    if (bytes == nullptr || size < HEADER_SIZE || std::memcmp(bytes, "TNLD", 4) != 0 ||
+        u16(bytes + 4) != VERSION) {
+        return;
+    }
+    const std::uint16_t kind = u16(bytes + 6);
+    if (kind < 1 || kind > 3) {
+        return;
+    }
+    const std::uint64_t entryCount = u32(bytes + 8);
+    const std::uint64_t slotCount = u32(bytes + 12);
+    const std::uint64_t refCount = u32(bytes + 16);
+    const std::uint64_t patternCount = u32(bytes + 20);
+    const std::uint64_t stringsSize = u32(bytes + 24);
+    if (slotCount == 0 || (slotCount & (slotCount - 1)) != 0) {
+        return;
+    }
+    const std::uint64_t refsStart = HEADER_SIZE + entryCount * ENTRY_SIZE;
+    const std::uint64_t slotsStart = refsStart + refCount * REF_SIZE;
+    const std::uint64_t patternsStart = slotsStart + slotCount * SLOT_SIZE;
+    const std::uint64_t stringsStart = patternsStart + patternCount * PATTERN_SIZE;
+    if (stringsStart + stringsSize > size) {
+        return;
+    }
+
+    // Check every offset once, so the accessors don't need to
+    const auto validString = [&](std::uint64_t offset, std::uint64_t count) {
+        return offset + count <= stringsSize;
+    };
+    for (std::uint64_t i = 0; i < refCount; i++) {
+        const std::uint8_t* ref = bytes + refsStart + i * REF_SIZE;
+        if (!validString(u32(ref), u32(ref + 4))) return;
+    }
+    for (std::uint64_t i = 0; i < entryCount; i++) {
+        const std::uint8_t* e = bytes + HEADER_SIZE + i * ENTRY_SIZE;
+        const auto f = [e](Field field) -> std::uint64_t { return u32(e + field * 4); };
+        if (!validString(f(NAME_OFFSET), f(NAME_LENGTH)) || !validString(f(CHROMA), CHROMA_SIZE) ||
+            !validString(f(NORMALIZED), CHROMA_SIZE) || f(SET_NUM) > 4095 ||
+            f(QUALITY) > static_cast<std::uint64_t>(chord_type::ChordQuality::Unknown) ||
+            f(INTERVALS_FIRST) + f(INTERVALS_COUNT) > refCount || f(ALIASES_FIRST) + f(ALIASES_COUNT) > refCount ||
+            f(PATTERNS_FIRST) + f(PATTERNS_COUNT) > patternCount) {
+            return;
+        }
+    }
+    // A lookup of a missing key stops at an empty slot
+    bool emptySlot = false;
+    for (std::uint64_t i = 0; i < slotCount; i++) {
+        const std::uint8_t* slot = bytes + slotsStart + i * SLOT_SIZE;
+        if (!validString(u32(slot), u32(slot + 4)) || u32(slot + 8) > entryCount) return;
+        emptySlot = emptySlot || u32(slot + 8) == 0;
+    }
+    if (!emptySlot) {
+        return;
+    }
+    for (std::uint64_t i = 0; i < patternCount; i++) {
+        const std::uint8_t* p = bytes + patternsStart + i * PATTERN_SIZE;
+        if (!validString(u32(p), u32(p + 4)) || p[REF_SIZE] > voicing_dictionary::MAX_VOICES ||
+            p[PATTERN_SIZE - 1] != 0) {
+            return;
+        }
+    }
+
+    data = bytes;
+    length = size;
+    fileKind = static_cast<Kind>(kind);
+    entries = static_cast<std::size_t>(entryCount);
+    slots = static_cast<std::size_t>(slotCount);
+    refs = static_cast<std::size_t>(refCount);
+    patterns = static_cast<std::size_t>(patternCount);
+    entryTable = bytes + HEADER_SIZE;
+    refTable = bytes + refsStart;
+    slotTable = bytes + slotsStart;
+    patternTable = bytes + patternsStart;
+    pool = reinterpret_cast<const char*>(bytes + stringsStart);
+    poolSize = static_cast<std::size_t>(stringsSize);
+}
+
+Entry Dictionary::operator[](std::size_t i) const {
+    return Entry(this, entryTable + i * ENTRY_SIZE);
+}
+
+int Dictionary::indexOf(std::string_view key) const {
+    if (data == nullptr) {
+        return -1;
+    }
+    // open() checks there is an empty slot, but never probe more than the table
+    std::size_t slot = hash(key) & (slots - 1);
+    for (std::size_t probe = 0; probe < slots; probe++, slot = (slot + 1) & (slots - 1)) {
+        const std::uint8_t* s = slotTable + slot * SLOT_SIZE;
+        const std::uint32_t entry = u32(s + 8);
+        if (entry == 0) {
+            return -1;
+        }
+        if (string(s) == key) {
+            return static_cast<int>(entry - 1);
+        }
+    }
+    return -1;
+}
+
+int Dictionary::indexOf(int setNum) const {
+    char buffer[16];
+    const int size = std::snprintf(buffer, sizeof(buffer), "%d", setNum);
+    return indexOf(std::string_view(buffer, static_cast<std::size_t>(size)));
+}
+
+std::optional<Entry> Dictionary::find(std::string_view key) const {
+    const int i = indexOf(key);
+    if (i < 0) {
+        return std::nullopt;
+    }
+    return (*this)[static_cast<std::size_t>(i)];
+}
+
+std::vector<std::uint8_t> compile(const std::vector<chord_type::ChordType>& types) {
+    std::vector<Source> sources;
+    sources.reserve(types.size());
+    for (const chord_type::ChordType& type : types) {
+        // ChordType::name hides the (empty) name of the pcset
+        Source source = fromPcset(type, type.aliases);
+        source.name = type.name;
+        source.quality = type.quality;
+        sources.push_back(std::move(source));
+    }
+    return encode(Kind::ChordTypes, sources);
+}
+
+std::vector<std::uint8_t> compile(const std::vector<scale_type::ScaleType>& types) {
+    std::vector<Source> sources;
+    sources.reserve(types.size());
+    for (const scale_type::ScaleType& type : types) {
+        sources.push_back(fromPcset(type, type.aliases));
+    }
+    return encode(Kind::ScaleTypes, sources);
+}
+
+std::vector<std::uint8_t> compile(const voicing_dictionary::VoicingDictionary& dictionary) {
+    std::vector<Source> sources;
+    sources.reserve(dictionary.size());
+    for (const auto& entry : dictionary) {
+        Source source;
+        source.name = entry.first;
+        source.chroma = source.normalized = "000000000000";
+        source.patterns = entry.second;
+        sources.push_back(std::move(source));
+    }
+    return encode(Kind::Voicings, sources);
+}
+
+std::vector<std::uint8_t> compileText(Kind kind, std::string_view text) {
+    if (kind == Kind::Voicings) {
+        const auto compiled = voicing_dictionary::parseDictionary(std::string(text));
+        if (compiled.empty() && !trim(text).empty()) {
+            return {};
+        }
+        return compile(compiled.toDictionary());
+    }
+
+    std::vector<Source> sources;
+    while (!text.empty()) {
+        const auto newline = text.find('\n');
+        const std::string_view line = trim(text.substr(0, newline));
+        text = newline == std::string_view::npos ? std::string_view() : text.substr(newline + 1);
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        Source source;
+        if (!parseType(line, source) || (kind == Kind::ScaleTypes && source.name.empty())) {
+            return {};
+        }
+        if (kind == Kind::ScaleTypes) {
+            source.quality = chord_type::ChordQuality::Unknown;
+        }
+        sources.push_back(std::move(source));
+    }
+    return encode(kind, sources);
+}
+
+bool compileFile(Kind kind, const std::string& source, const std::string& destination) {
+    std::ifstream in(source, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+    std::ostringstream text;
+    text << in.rdbuf();
+    const std::vector<std::uint8_t> bytes = compileText(kind, text.str());
+    if (bytes.empty()) {
+        return false;
+    }
+    std::ofstream out(destination, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return static_cast<bool>(out);
+}
+
+chord_type::ChordType toChordType(const Entry& entry) {
+    chord_type::ChordType type;
+    type.empty = false;
+    type.setNum = entry.setNum();
+    type.chroma = std::string(entry.chroma());
+    type.normalized = std::string(entry.normalized());
+    type.intervals = entry.intervals().toVector();
+    type.name = std::string(entry.name());
+    type.quality = entry.quality();
+    type.aliases = entry.aliases().toVector();
+    return type;
+}
+
+scale_type::ScaleType toScaleType(const Entry& entry) {
+    scale_type::ScaleType type;
+    type.name = std::string(entry.name());
+    type.empty = false;
+    type.setNum = entry.setNum();
+    type.chroma = std::string(entry.chroma());
+    type.normalized = std::string(entry.normalized());
+    type.intervals = entry.intervals().toVector();
+    type.aliases = entry.aliases().toVector();
+    return type;
+}
+
+voicing_dictionary::VoicingDictionary toVoicingDictionary(const Dictionary& dictionary) {
+    voicing_dictionary::VoicingDictionary result;
+    for (std::size_t i = 0; i < dictionary.size(); i++) {
+        const Entry entry = dictionary[i];
+        std::vector<std::string>& patterns = result[std::string(entry.name())];
+        for (std::size_t p = 0; p < entry.patternCount(); p++) {
+            patterns.emplace_back(entry.patternSource(p));
+        }
+    }
+    return result;
+}
+
+bool install(const Dictionary& dictionary) {
+    if (!dictionary.isOpen()) {
+        return false;
+    }
+    // The entries have the pitch class sets and qualities: nothing is parsed
+    if (dictionary.kind() == Kind::ChordTypes) {
+        std::vector<chord_type::ChordType> types;
+        types.reserve(dictionary.size());
+        for (std::size_t i = 0; i < dictionary.size(); i++) {
+            types.push_back(toChordType(dictionary[i]));
+        }
+        chord_type::addAll(types.data(), types.size());
+        return true;
+    }
+    if (dictionary.kind() == Kind::ScaleTypes) {
+        std::vector<scale_type::ScaleType> types;
+        types.reserve(dictionary.size());
+        for (std::size_t i = 0; i < dictionary.size(); i++) {
+            types.push_back(toScaleType(dictionary[i]));
+        }
+        scale_type::addAll(types.data(), types.size());
+        return true;
+    }
+    return false;
+}
+
+} // namespace dictionary_file
+} // namespace tonalcpp
@@ -1,4 +1,15 @@
 #include "tonalcpp/helpers.h"
+#include <fstream>
+#include <iterator>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define TONAL_HAS_MMAP 1
+#endif
 
 namespace tonalcpp {
 namespace helpers {
@@ -27,5 +38,76 @@ std::vector<std::string> split(const std::string& str) {
     return tokens;
 }
 
+MappedFile::MappedFile(const std::string& path) {
+#ifdef TONAL_HAS_MMAP
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+        ::close(fd);
+        return;
+    }
+    length = static_cast<std::size_t>(info.st_size);
+    if (length > 0) {
+        void* address = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address == MAP_FAILED) {
+            ::close(fd);
+            length = 0;
+            return;
+        }
+        // The mapping stays valid after closing the descriptor
+        bytes = static_cast<const std::uint8_t*>(address);
+        mapped = true;
+    }
+    ::close(fd);
+    opened = true;
+#else
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return;
+    }
+    buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    bytes = buffer.data();
+    length = buffer.size();
+    opened = true;
+#endif
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        opened = std::exchange(other.opened, false);
+        mapped = std::exchange(other.mapped, false);
+        bytes = std::exchange(other.bytes, nullptr);
+        length = std::exchange(other.length, 0);
+        // Moving a vector keeps its data pointer
+        buffer = std::move(other.buffer);
+    }
+    return *this;
+}
+
+void MappedFile::close() {
+#ifdef TONAL_HAS_MMAP
+    if (mapped) {
+        ::munmap(const_cast<std::uint8_t*>(bytes), length);
+    }
+#endif
+    opened = false;
+    mapped = false;
+    bytes = nullptr;
+    length = 0;
+    buffer.clear();
+}
+
 } // namespace helpers
 } // namespace tonalcpp
\ No newline at end of file
@@ -0,0 +1,126 @@
+#include "tonalcpp/instrumentation.h"
+#include <cstring>
+#include <deque>
+#include <mutex>
+
+namespace tonalcpp {
+namespace instrumentation {
+
+namespace {
+
+std::mutex probesMutex;
+std::deque<Probe>& probes() {
+    // Never destroyed: probes can be hit during static destruction
+    static std::deque<Probe>* all = new std::deque<Probe>();
+    return *all;
+}
+
+const char* const CACHE_NAMES[CACHE_COUNT] = {"noteCache", "intervalCache", "pcsetCache"};
+std::array<std::atomic<std::uint64_t>, CACHE_COUNT> cacheHits{};
+std::array<std::atomic<std::uint64_t>, CACHE_COUNT> cacheMisses{};
+
+std::atomic<std::uint64_t> allocations{0};
+std::atomic<std::uint64_t> allocatedBytes{0};
+thread_local AllocationCount threadCount;
+
+std::size_t bucket(std::uint64_t ns) {
+    std::size_t i = 0;
+    while (ns > 1 && i < HISTOGRAM_BUCKETS - 1) {
+        ns >>= 1;
+        i++;
+    }
+    return i;
+}
+
+} // namespace
+
+Probe& probe(const char* name) {
+    std::lock_guard<std::mutex> lock(probesMutex);
+    for (auto& p : probes()) {
+        if (std::strcmp(p.name, name) == 0) {
+            return p;
+        }
+    }
+    return probes().emplace_back(name);
+}
+
+void recordAllocation(std::size_t size) {
+    threadCount.allocations++;
+    threadCount.bytes += size;
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+AllocationCount threadAllocations() {
+    return threadCount;
+}
+
+void recordCacheLookup(Cache cache, bool hit) {
+    auto& counters = hit ? cacheHits : cacheMisses;
+    counters[static_cast<std::size_t>(cache)].fetch_add(1, std::memory_order_relaxed);
+}
+
+ScopedProbe::~ScopedProbe() {
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    const auto ns = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    const AllocationCount now = threadAllocations();
+
+    target.calls.fetch_add(1, std::memory_order_relaxed);
+    target.totalNs.fetch_add(ns, std::memory_order_relaxed);
+    target.allocations.fetch_add(now.allocations - allocationsAtStart.allocations, std::memory_order_relaxed);
+    target.allocatedBytes.fetch_add(now.bytes - allocationsAtStart.bytes, std::memory_order_relaxed);
+    target.histogram[bucket(ns)].fetch_add(1, std::memory_order_relaxed);
+}
+
+Snapshot snapshot() {
+    Snapshot result;
+    {
+        std::lock_guard<std::mutex> lock(probesMutex);
+        for (const auto& p : probes()) {
+            ProbeStats stats;
+            stats.name = p.name;
+            stats.calls = p.calls.load(std::memory_order_relaxed);
+            stats.totalNs = p.totalNs.load(std::memory_order_relaxed);
+            stats.allocations = p.allocations.load(std::memory_order_relaxed);
+            stats.allocatedBytes = p.allocatedBytes.load(std::memory_order_relaxed);
+            for (std::size_t i = 0; i < HISTOGRAM_BUCKETS; i++) {
+                stats.histogram[i] = p.histogram[i].load(std::memory_order_relaxed);
+            }
+            result.probes.push_back(std::move(stats));
+        }
+    }
+    if (enabled()) {
+        for (std::size_t i = 0; i < CACHE_COUNT; i++) {
+            result.caches.push_back({CACHE_NAMES[i], cacheHits[i].load(std::memory_order_relaxed),
+                                     cacheMisses[i].load(std::memory_order_relaxed)});
+        }
+    }
+    result.allocations = allocations.load(std::memory_order_relaxed);
+    result.allocatedBytes = allocatedBytes.load(std::memory_order_relaxed);
+    return result;
+}
+
+void reset() {
+    {
+        std::lock_guard<std::mutex> lock(probesMutex);
+        for (auto& p : probes()) {
+            p.calls = 0;
+            p.totalNs = 0;
+            p.allocations = 0;
+            p.allocatedBytes = 0;
+            for (auto& count : p.histogram) {
+                count = 0;
+            }
+        }
+    }
+    for (std::size_t i = 0; i < CACHE_COUNT; i++) {
+        cacheHits[i] = 0;
+        cacheMisses[i] = 0;
+    }
+    allocations = 0;
+    allocatedBytes = 0;
+}
+
+} // namespace instrumentation
+} // namespace tonalcpp
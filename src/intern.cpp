@@ -0,0 +1,72 @@
+#include "tonalcpp/intern.h"
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace tonalcpp {
+namespace intern {
+
+namespace {
+
+struct Table {
+    std::shared_mutex mutex;
+    // Names by id. Growing a deque doesn't move its elements, so the
+    // references handed out stay valid
+    std::deque<std::string> names{std::string()};
+    std::unordered_map<std::string_view, std::uint32_t> ids{{names[0], 0}};
+};
+
+Table& table() {
+    static Table instance;
+    return instance;
+}
+
+} // namespace
+
+const std::string& Handle::str() const {
+    Table& t = table();
+    std::shared_lock<std::shared_mutex> lock(t.mutex);
+    return t.names[index];
+}
+
+Handle intern(std::string_view name) {
+    Table& t = table();
+    {
+        std::shared_lock<std::shared_mutex> lock(t.mutex);
+        auto it = t.ids.find(name);
+        if (it != t.ids.end()) {
+            return Handle(it->second);
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(t.mutex);
+    // Another thread may have added it meanwhile
+    auto it = t.ids.find(name);
+    if (it != t.ids.end()) {
+        return Handle(it->second);
+    }
+    const auto id = static_cast<std::uint32_t>(t.names.size());
+    t.names.emplace_back(name);
+    t.ids.emplace(t.names.back(), id);
+    return Handle(id);
+}
+
+std::optional<Handle> find(std::string_view name) {
+    Table& t = table();
+    std::shared_lock<std::shared_mutex> lock(t.mutex);
+    auto it = t.ids.find(name);
+    if (it == t.ids.end()) {
+        return std::nullopt;
+    }
+    return Handle(it->second);
+}
+
+std::size_t size() {
+    Table& t = table();
+    std::shared_lock<std::shared_mutex> lock(t.mutex);
+    return t.names.size();
+}
+
+} // namespace intern
+} // namespace tonalcpp
@@ -1,5 +1,7 @@
 #include "tonalcpp/midi.h"
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <algorithm>
 #include <string>
 #include <limits>
@@ -43,7 +45,23 @@ std::optional<int> toMidi(int note) {
     return std::nullopt;
 }
 
+// Frequency ratio of every midi note relative to A4 (same formula as
+// midiToFreq, so table lookups give exactly the same results)
+static const std::array<double, 128>& freqRatios() {
+    static const std::array<double, 128> ratios = []() {
+        std::array<double, 128> result;
+        for (int midi = 0; midi < 128; midi++) {
+            result[midi] = std::pow(2.0, (midi - 69.0) / 12.0);
+        }
+        return result;
+    }();
+    return ratios;
+}
+
 double midiToFreq(int midi, double tuning) {
+    if (midi >= 0 && midi <= 127) {
+        return freqRatios()[midi] * tuning;
+    }
     return std::pow(2.0, (midi - 69.0) / 12.0) * tuning;
 }
 
@@ -53,6 +71,91 @@ double freqToMidi(double freq) {
     return std::round(v * 100.0) / 100.0;
 }
 
+TuningTable::TuningTable(double tuning) : tuning(tuning) {
+    const auto& ratios = freqRatios();
+    for (int midi = 0; midi < 128; midi++) {
+        freqs[midi] = ratios[midi] * tuning;
+    }
+}
+
+TuningTable::TuningTable(const std::array<double, 128>& freqs, double tuning)
+    : tuning(tuning), equalTempered(false), freqs(freqs) {}
+
+double TuningTable::compute(int midi) const {
+    return equalTempered ? midiToFreq(midi, tuning) : 0.0;
+}
+
+// Branch free float approximations used by the batch conversions. They only
+// use arithmetic and bit operations, so the compiler can vectorize the loops
+// that call them (std::pow and std::log can't be).
+namespace {
+
+inline float bitsToFloat(std::uint32_t bits) {
+    float f;
+    std::memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+inline std::uint32_t floatToBits(float f) {
+    std::uint32_t bits;
+    std::memcpy(&bits, &f, sizeof(bits));
+    return bits;
+}
+
+// 2^x for x in the normal float range
+inline float fastExp2(float x) {
+    // Split in integer part and a fraction in [-0.5, 0.5]
+    const float shifted = x + 0.5f;
+    int i = static_cast<int>(shifted);
+    i -= shifted < static_cast<float>(i) ? 1 : 0;
+    const float f = x - static_cast<float>(i);
+    
+    // Taylor series of 2^f up to the 6th power
+    const float p = 1.0f + f * (0.69314718f + f * (0.24022651f + f * (0.05550411f +
+                    f * (0.00961813f + f * (0.00133336f + f * 0.00015404f)))));
+    
+    return p * bitsToFloat(static_cast<std::uint32_t>(i + 127) << 23);
+}
+
+// log2(x) for positive normal floats
+inline float fastLog2(float x) {
+    const std::uint32_t bits = floatToBits(x);
+    const int exponent = static_cast<int>((bits >> 23) & 0xFF) - 127;
+    // Mantissa in [1, 2)
+    const float m = bitsToFloat((bits & 0x007FFFFF) | 0x3F800000);
+    
+    // log2(m) = 2/ln(2) * atanh(t) with t = (m - 1) / (m + 1) in [0, 1/3]
+    const float t = (m - 1.0f) / (m + 1.0f);
+    const float t2 = t * t;
+    const float series = t * (1.0f + t2 * (1.0f / 3 + t2 * (1.0f / 5 + t2 * (1.0f / 7 +
+                         t2 * (1.0f / 9 + t2 * (1.0f / 11))))));
+    
+    return static_cast<float>(exponent) + 2.88539008f * series;
+}
+
+} // namespace
+
+void midiToFreq(const float* midi, std::size_t count, float* out, double tuning) {
+    const float ref = static_cast<float>(tuning);
+    for (std::size_t i = 0; i < count; i++) {
+        out[i] = ref * fastExp2((midi[i] - 69.0f) * (1.0f / 12.0f));
+    }
+}
+
+void freqToMidi(const float* freq, std::size_t count, float* out, double tuning) {
+    const float refLog2 = static_cast<float>(std::log2(tuning));
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    for (std::size_t i = 0; i < count; i++) {
+        const float f = freq[i];
+        const float midi = 69.0f + 12.0f * (fastLog2(f) - refLog2);
+        // Select with a mask so the loop has no branches. NaN fails both
+        // comparisons, and infinity the second one
+        const bool valid = f > 0.0f && f <= std::numeric_limits<float>::max();
+        const std::uint32_t mask = valid ? 0xFFFFFFFFu : 0u;
+        out[i] = bitsToFloat((floatToBits(midi) & mask) | (floatToBits(nan) & ~mask));
+    }
+}
+
 std::string midiToNoteName(int midi, const ToNoteNameOptions& options) {
     // Handle invalid inputs
     if (midi == std::numeric_limits<int>::min() || 
@@ -79,6 +182,30 @@ std::string midiToNoteName(int midi, const ToNoteNameOptions& options) {
     return pc + std::to_string(octave);
 }
 
+intern::Handle midiToNoteHandle(int midi, const ToNoteNameOptions& options) {
+    using Handles = std::array<intern::Handle, 128>;
+    // By [sharps][pitchClass][midi]
+    static const std::array<std::array<Handles, 2>, 2> handles = []() {
+        std::array<std::array<Handles, 2>, 2> result;
+        ToNoteNameOptions o;
+        for (int s = 0; s < 2; s++) {
+            for (int p = 0; p < 2; p++) {
+                o.sharps = s == 1;
+                o.pitchClass = p == 1;
+                for (int m = 0; m < 128; m++) {
+                    result[s][p][m] = intern::intern(midiToNoteName(m, o));
+                }
+            }
+        }
+        return result;
+    }();
+
+    if (isMidi(midi)) {
+        return handles[options.sharps ? 1 : 0][options.pitchClass ? 1 : 0][midi];
+    }
+    return intern::intern(midiToNoteName(midi, options));
+}
+
 int chroma(int midi) {
     return midi % 12;
 }
@@ -152,62 +279,42 @@ std::function<std::optional<int>(int)> pcsetNearest(const std::string& chroma) {
     return pcsetNearest(pcsetFromChroma(chroma));
 }
 
+PcsetSteps::PcsetSteps(const std::vector<int>& notes, int tonic) : tonic(tonic) {
+    for (int pc : pcset(notes)) {
+        set[len++] = pc;
+    }
+}
+
+PcsetSteps::PcsetSteps(const std::string& chroma, int tonic)
+    : PcsetSteps(pcsetFromChroma(chroma), tonic) {}
+
+void PcsetSteps::operator()(const int* steps, std::size_t count, int* out) const {
+    for (std::size_t i = 0; i < count; i++) {
+        out[i] = (*this)(steps[i]);
+    }
+}
+
+void PcsetDegrees::operator()(const int* degrees, std::size_t count, int* out, int fallback) const {
+    for (std::size_t i = 0; i < count; i++) {
+        const int degree = degrees[i];
+        out[i] = degree == 0 ? fallback : steps(degree > 0 ? degree - 1 : degree);
+    }
+}
+
 std::function<int(int)> pcsetSteps(const std::vector<int>& notes, int tonic) {
-    const std::vector<int> set = pcset(notes);
-    const int len = static_cast<int>(set.size());
-    
-    return [set, len, tonic](int step) -> int {
-        // Calculate the index within the set, matching the TypeScript behavior
-        int index;
-        if (step < 0) {
-            // In TypeScript: (len - (-step % len)) % len
-            // C++ modulo for negative numbers behaves differently than JavaScript
-            int modStep = (-step) % len;  // This is positive in C++
-            if (modStep == 0) {
-                index = 0;
-            } else {
-                index = len - modStep;
-            }
-        } else {
-            index = step % len;
-        }
-        
-        // Calculate octave displacement
-        int octaves;
-        if (step < 0) {
-            // For negative steps, Math.floor(step / len) in JS
-            // Equivalent in C++ for negative values:
-            octaves = (step - len + 1) / len;
-        } else {
-            octaves = step / len;
-        }
-        
-        // Return the note
-        return set[index] + octaves * 12 + tonic;
-    };
+    return PcsetSteps(notes, tonic);
 }
 
 std::function<int(int)> pcsetSteps(const std::string& chroma, int tonic) {
-    return pcsetSteps(pcsetFromChroma(chroma), tonic);
+    return PcsetSteps(chroma, tonic);
 }
 
 std::function<std::optional<int>(int)> pcsetDegrees(const std::vector<int>& notes, int tonic) {
-    auto steps = pcsetSteps(notes, tonic);
-    
-    return [steps](int degree) -> std::optional<int> {
-        if (degree == 0) {
-            return std::nullopt;
-        }
-        
-        // Match TypeScript behavior
-        // For positive degrees, we adjust by -1 (1-based to 0-based)
-        // For negative degrees, we keep as is (already correct mapping)
-        return steps(degree > 0 ? degree - 1 : degree);
-    };
+    return PcsetDegrees(notes, tonic);
 }
 
 std::function<std::optional<int>(int)> pcsetDegrees(const std::string& chroma, int tonic) {
-    return pcsetDegrees(pcsetFromChroma(chroma), tonic);
+    return PcsetDegrees(chroma, tonic);
 }
 
 } // namespace midi
@@ -1,5 +1,8 @@
 #include "tonalcpp/note.h"
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <unordered_set>
 
 namespace tonalcpp {
@@ -81,22 +84,61 @@ std::string fromMidiSharps(int midiNum) {
     return midi::midiToNoteName(midiNum, options);
 }
 
+intern::Handle fromMidiHandle(int midiNum) {
+    return midi::midiToNoteHandle(midiNum);
+}
+
+intern::Handle fromMidiSharpsHandle(int midiNum) {
+    midi::ToNoteNameOptions options;
+    options.sharps = true;
+    return midi::midiToNoteHandle(midiNum, options);
+}
+
+FreqNote fromFreqId(double frequency, double tuning) {
+    if (!(frequency > 0.0) || std::isinf(frequency)) {
+        return {-1, 0.0};
+    }
+    const double exact = 69.0 + 12.0 * std::log2(frequency / tuning);
+    const double nearest = std::round(exact);
+    return {static_cast<int>(nearest), (exact - nearest) * 100.0};
+}
+
+void fromFreqIds(const float* freqs, std::size_t count, int* midi, float* cents,
+                 double tuning) {
+    // Convert in place in the cents buffer, then split in note and deviation
+    midi::freqToMidi(freqs, count, cents, tuning);
+    // Written without branches (and NaN comparisons) so it can be vectorized
+    for (std::size_t i = 0; i < count; i++) {
+        std::uint32_t bits;
+        std::memcpy(&bits, &cents[i], sizeof(bits));
+        const bool valid = (bits & 0x7FFFFFFFu) < 0x7F800000u;  // finite
+        const float exact = valid ? cents[i] : 0.0f;
+        
+        // Round to nearest
+        int nearest = static_cast<int>(exact + 0.5f);
+        nearest -= exact + 0.5f < static_cast<float>(nearest) ? 1 : 0;
+        
+        midi[i] = valid ? nearest : -1;
+        cents[i] = (exact - static_cast<float>(nearest)) * 100.0f;
+    }
+}
+
 std::string fromFreq(double frequency) {
-    double midiNumber = midi::freqToMidi(frequency);
-    if (std::isnan(midiNumber)) {
+    const FreqNote n = fromFreqId(frequency);
+    if (n.midi < 0) {
         return "";
     }
-    return midi::midiToNoteName(static_cast<int>(midiNumber));
+    return midi::midiToNoteName(n.midi);
 }
 
 std::string fromFreqSharps(double frequency) {
-    double midiNumber = midi::freqToMidi(frequency);
-    if (std::isnan(midiNumber)) {
+    const FreqNote n = fromFreqId(frequency);
+    if (n.midi < 0) {
         return "";
     }
     midi::ToNoteNameOptions options;
     options.sharps = true;
-    return midi::midiToNoteName(static_cast<int>(midiNumber), options);
+    return midi::midiToNoteName(n.midi, options);
 }
 
 std::string distance(const std::string& from, const std::string& to) {
@@ -153,6 +195,30 @@ std::vector<std::string> sortedNames(
     return result;
 }
 
+std::pmr::vector<std::pmr::string> sortedNames(
+    std::pmr::memory_resource* resource,
+    const std::vector<std::string>& notes,
+    const NoteComparator& comparator) {
+    
+    std::pmr::vector<pitch_note::Note> validNotes(resource);
+    validNotes.reserve(notes.size());
+    for (const auto& item : notes) {
+        pitch_note::Note n = pitch_note::note(item);
+        if (!n.empty) {
+            validNotes.push_back(std::move(n));
+        }
+    }
+    std::sort(validNotes.begin(), validNotes.end(), comparator);
+    
+    std::pmr::vector<std::pmr::string> result(resource);
+    result.reserve(validNotes.size());
+    for (const auto& note : validNotes) {
+        result.emplace_back(note.name);
+    }
+    
+    return result;
+}
+
 std::vector<std::string> sortedUniqNames(const std::vector<std::string>& notes) {
     std::vector<std::string> sorted = sortedNames(notes, ascending);
     std::vector<std::string> result;
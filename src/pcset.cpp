@@ -1,4 +1,5 @@
 #include "tonalcpp/pcset.h"
+#include "tonalcpp/instrumentation.h"
 #include "tonalcpp/collection.h"
 #include "tonalcpp/pitch_note.h"
 #include "tonalcpp/pitch_interval.h"
@@ -7,6 +8,9 @@
 #include <algorithm>
 #include <cmath>
 #include <unordered_map>
+#include <mutex>
+#include <shared_mutex>
+#include <array>
 #include <bitset>
 
 namespace tonalcpp {
@@ -24,6 +28,7 @@ const Pcset EmptyPcset = {
 
 // Cache for computed pcsets
 static std::unordered_map<std::string, Pcset> pcsetCache = { {EmptyPcset.chroma, EmptyPcset} };
+static std::shared_mutex pcsetCacheMutex;
 
 // Regex for validating chromas
 const std::regex CHROMA_REGEX("^[01]{12}$");
@@ -167,13 +172,20 @@ Pcset chromaToPcset(const std::string& chroma) {
 
 // Get implementation
 Pcset getPcset(const std::string& src) {
+    TONAL_PROBE("pcset::getPcset");
     // Check if it's a chroma
     if (isChroma(src)) {
-        if (pcsetCache.find(src) != pcsetCache.end()) {
-            return pcsetCache[src];
+        {
+            std::shared_lock<std::shared_mutex> lock(pcsetCacheMutex);
+            auto it = pcsetCache.find(src);
+            TONAL_CACHE_LOOKUP(Pcset, it != pcsetCache.end());
+            if (it != pcsetCache.end()) {
+                return it->second;
+            }
         }
         
         Pcset pcset = chromaToPcset(src);
+        std::unique_lock<std::shared_mutex> lock(pcsetCacheMutex);
         pcsetCache[src] = pcset;
         return pcset;
     }
@@ -202,6 +214,12 @@ Pcset getPcset(const Pcset& pcset) {
     return EmptyPcset;
 }
 
+void clearCache() {
+    std::unique_lock<std::shared_mutex> lock(pcsetCacheMutex);
+    pcsetCache.clear();
+    pcsetCache[EmptyPcset.chroma] = EmptyPcset;
+}
+
 // Interval implementations
 std::vector<std::string> intervals(const std::string& src) {
     return getPcset(src).intervals;
@@ -219,6 +237,40 @@ std::vector<std::string> intervals(const Pcset& pcset) {
     return getPcset(pcset).intervals;
 }
 
+std::pmr::vector<std::pmr::string> intervals(std::pmr::memory_resource* resource, const std::string& src) {
+    std::pmr::vector<std::pmr::string> result(resource);
+    if (!isChroma(src)) {
+        return result;
+    }
+    const auto copy = [&](const Pcset& pcset) {
+        result.reserve(pcset.intervals.size());
+        for (const auto& ivl : pcset.intervals) {
+            result.emplace_back(ivl);
+        }
+    };
+    {
+        std::shared_lock<std::shared_mutex> lock(pcsetCacheMutex);
+        auto it = pcsetCache.find(src);
+        if (it != pcsetCache.end()) {
+            copy(it->second);
+            return result;
+        }
+    }
+    copy(getPcset(src));
+    return result;
+}
+
+std::pmr::vector<std::pmr::string> intervals(std::pmr::memory_resource* resource, int src) {
+    if (!isPcsetNum(src)) {
+        return std::pmr::vector<std::pmr::string>(resource);
+    }
+    return intervals(resource, setNumToChroma(src));
+}
+
+std::pmr::vector<std::pmr::string> intervals(std::pmr::memory_resource* resource, const std::vector<std::string>& src) {
+    return intervals(resource, listToChroma(src));
+}
+
 // Chroma implementations
 std::string chroma(const std::string& src) {
     return getPcset(src).chroma;
@@ -232,6 +284,23 @@ std::string chroma(const std::vector<std::string>& src) {
     return getPcset(src).chroma;
 }
 
+std::string intervalsChroma(const std::vector<std::string>& intervals) {
+    if (intervals.empty()) {
+        return "";
+    }
+    std::string result(12, '0');
+    for (const auto& name : intervals) {
+        const pitch_interval::Interval interval = pitch_interval::interval(name);
+        if (interval.empty) {
+            return "";
+        }
+        if (interval.chroma >= 0 && interval.chroma < 12) {
+            result[interval.chroma] = '1';
+        }
+    }
+    return result;
+}
+
 std::string chroma(const Pcset& pcset) {
     return getPcset(pcset).chroma;
 }
@@ -277,6 +346,40 @@ std::vector<std::string> notes(const Pcset& pcset) {
     return pitch_distance::tonicIntervalsTransposer(pcset.intervals, "C");
 }
 
+std::vector<intern::Handle> noteHandles(const std::string& src) {
+    return noteHandles(getPcset(src));
+}
+
+std::vector<intern::Handle> noteHandles(int src) {
+    return noteHandles(getPcset(src));
+}
+
+std::vector<intern::Handle> noteHandles(const std::vector<std::string>& src) {
+    return noteHandles(getPcset(src));
+}
+
+std::vector<intern::Handle> noteHandles(const Pcset& pcset) {
+    // The note of each chroma position: the interval transposed from C
+    static const std::array<intern::Handle, 12> NOTES = []() {
+        std::array<intern::Handle, 12> result;
+        for (std::size_t i = 0; i < INTERVALS.size(); i++) {
+            result[i] = intern::intern(pitch_distance::transpose("C", INTERVALS[i]));
+        }
+        return result;
+    }();
+
+    std::vector<intern::Handle> result;
+    if (pcset.empty) {
+        return result;
+    }
+    for (std::size_t i = 0; i < pcset.chroma.size() && i < NOTES.size(); i++) {
+        if (pcset.chroma[i] == '1') {
+            result.push_back(NOTES[i]);
+        }
+    }
+    return result;
+}
+
 // Get all possible chromas
 std::vector<std::string> chromas() {
     std::vector<std::string> result;
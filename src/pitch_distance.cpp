@@ -1,4 +1,5 @@
 #include "tonalcpp/pitch_distance.h"
+#include "tonalcpp/instrumentation.h"
 #include <cmath>
 #include <algorithm>
 #include <unordered_map>
@@ -30,8 +31,7 @@ pitch_interval::Interval coordToIntervalObj(const pitch::PitchCoordinates& coord
     }
     
     // Convert to an interval
-    // Convert array to vector for coordToInterval
-    std::vector<int> coords = {intervalCoord[0], intervalCoord[1], intervalCoord[2]};
+    const pitch::PitchCoordinates coords = {intervalCoord[0], intervalCoord[1], intervalCoord[2]};
     return pitch_interval::coordToInterval(coords, forceDescending);
 }
 
@@ -40,6 +40,7 @@ pitch_interval::Interval coordToIntervalObj(const pitch::PitchCoordinates& coord
  * Precisely follows the TypeScript implementation
  */
 std::string transpose(const std::string& noteName, const std::string& intervalName) {
+    TONAL_PROBE("pitch_distance::transpose");
     // Parse note and interval
     pitch_note::Note n = pitch_note::note(noteName);
     pitch_interval::Interval i = pitch_interval::interval(intervalName);
@@ -77,6 +78,7 @@ std::string transpose(const std::string& noteName, const std::string& intervalNa
  * Precisely follows the TypeScript implementation
  */
 std::string distance(const std::string& fromNoteName, const std::string& toNoteName) {
+    TONAL_PROBE("pitch_distance::distance");
     // Parse notes
     pitch_note::Note fromNote = pitch_note::note(fromNoteName);
     pitch_note::Note toNote = pitch_note::note(toNoteName);
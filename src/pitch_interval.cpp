@@ -1,10 +1,14 @@
 #include "tonalcpp/pitch_interval.h"
+#include "tonalcpp/helpers.h"
+#include "tonalcpp/instrumentation.h"
 #include "tonalcpp/pitch.h"
-#include <regex>
+#include <charconv>
 #include <cmath>
 #include <vector>
 #include <algorithm>
 #include <unordered_map>
+#include <mutex>
+#include <shared_mutex>
 #include <iostream>
 #include <limits>
 
@@ -40,7 +44,8 @@ std::string intervalFillStr(const std::string& s, int n) {
 }
 
 // Cache for interval objects to improve performance
-static std::unordered_map<std::string, Interval> intervalCache;
+static helpers::StringMap<Interval> intervalCache;
+static std::shared_mutex intervalCacheMutex;
 
 // Arrays and constants - match TypeScript implementation
 const std::vector<int> SIZES = {0, 2, 4, 5, 7, 9, 11};
@@ -65,26 +70,54 @@ Interval::Interval(bool emp, const IntervalName& n, int nu, const Quality& qu, I
       empty(emp), name(n), num(nu), q(qu), type(ty),
       simple(sim), semitones(semi), chroma(ch), oct(o), coord(co) {}
 
-// Tokenize interval string exactly as in TypeScript
-std::pair<std::string, std::string> tokenizeInterval(const std::string& str) {
+namespace {
+
+bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+// Length of the [-+]?\d+ number at the start of the string (0 if none)
+size_t numberLength(std::string_view str) {
+    size_t i = !str.empty() && (str[0] == '-' || str[0] == '+') ? 1 : 0;
+    const size_t digits = i;
+    while (i < str.size() && isDigit(str[i])) i++;
+    return i == digits ? 0 : i;
+}
+
+// d{1,4}|m|M|P|A{1,4}
+bool isQuality(std::string_view q) {
+    if (q == "m" || q == "M" || q == "P") {
+        return true;
+    }
+    return !q.empty() && q.size() <= 4 && (q[0] == 'd' || q[0] == 'A') &&
+           q.find_first_not_of(q[0]) == std::string_view::npos;
+}
+
+// AA|A|P|M|m|d|dd
+bool isShorthandQuality(std::string_view q) {
+    return q == "AA" || q == "A" || q == "P" || q == "M" || q == "m" || q == "d" || q == "dd";
+}
+
+} // namespace
+
+// Tokenize interval string exactly as in TypeScript: like the regex
+// ^([-+]?\d+)(d{1,4}|m|M|P|A{1,4})|(AA|A|P|M|m|d|dd)([-+]?\d+)$
+std::pair<std::string, std::string> tokenizeInterval(std::string_view str) {
     if (str.empty()) {
         return {"", ""};
     }
 
-    // Regular expressions based on TypeScript implementation
-    static const std::regex tonal_regex("([-+]?\\d+)(d{1,4}|m|M|P|A{1,4})");
-    static const std::regex shorthand_regex("(AA|A|P|M|m|d|dd)([-+]?\\d+)");
-    static const std::regex combined_regex("^([-+]?\\d+)(d{1,4}|m|M|P|A{1,4})|(AA|A|P|M|m|d|dd)([-+]?\\d+)$");
-
-    std::smatch match;
-    if (std::regex_match(str, match, combined_regex)) {
-        if (match[1].matched) {
-            // Format: [number][quality]
-            return {match[1].str(), match[2].str()};
-        } else {
-            // Format: [quality][number] (shorthand)
-            return {match[4].str(), match[3].str()};
-        }
+    // Format: [number][quality]
+    const size_t numLength = numberLength(str);
+    if (numLength > 0 && isQuality(str.substr(numLength))) {
+        return {std::string(str.substr(0, numLength)), std::string(str.substr(numLength))};
+    }
+
+    // Format: [quality][number] (shorthand)
+    const size_t qLength = str.find_first_of("+-0123456789");
+    if (qLength != std::string_view::npos && isShorthandQuality(str.substr(0, qLength)) &&
+        numberLength(str.substr(qLength)) == str.size() - qLength) {
+        return {std::string(str.substr(qLength)), std::string(str.substr(0, qLength))};
     }
     
     return {"", ""};
@@ -92,13 +125,19 @@ std::pair<std::string, std::string> tokenizeInterval(const std::string& str) {
 
 // Internal parse function - follows TypeScript implementation
 // Renamed to avoid conflict with pitch_note.cpp
-Interval parseInterval(const std::string& str) {
+Interval parseInterval(std::string_view str) {
     auto [numStr, qStr] = tokenizeInterval(str);
     if (numStr.empty()) {
         return NoInterval;
     }
 
-    int num = std::stoi(numStr);
+    // from_chars doesn't accept a "+" sign. Out of range numbers are not valid
+    int num = 0;
+    const char* first = numStr.data() + (numStr[0] == '+' ? 1 : 0);
+    const char* last = numStr.data() + numStr.size();
+    if (std::from_chars(first, last, num).ec != std::errc()) {
+        return NoInterval;
+    }
     Quality q = qStr;
     int step = (std::abs(num) - 1) % 7;
     char typeChar = TYPES[step];
@@ -111,6 +150,10 @@ Interval parseInterval(const std::string& str) {
     IntervalType type = (typeChar == 'M') ? IntervalType::Majorable : IntervalType::Perfectable;
 
     std::string name = numStr + q;
+    // Names are stored inline (see pitch::NameString)
+    if (!pitch::NameString::fits(name)) {
+        return NoInterval;
+    }
     int dirValue = (num < 0) ? -1 : 1;
     int simple = (num == 8 || num == -8) ? num : dirValue * (step + 1);
     int alt = qToAlt(type, q);
@@ -240,14 +283,20 @@ Interval coordToInterval(const pitch::PitchCoordinates& coord, bool forceDescend
 }
 
 // Main interval function with caching
-Interval interval(const std::string& src, bool useCache) {
+Interval interval(std::string_view src, bool useCache) {
+    TONAL_PROBE("pitch_interval::interval");
     if (src.empty()) {
         return NoInterval;
     }
     
     // Check cache first
-    if (useCache && intervalCache.find(src) != intervalCache.end()) {
-        return intervalCache[src];
+    if (useCache) {
+        std::shared_lock<std::shared_mutex> lock(intervalCacheMutex);
+        const Interval* cached = intervalCache.find(src);
+        TONAL_CACHE_LOOKUP(Interval, cached != nullptr);
+        if (cached) {
+            return *cached;
+        }
     }
     
     // Parse string - using renamed function
@@ -255,14 +304,20 @@ Interval interval(const std::string& src, bool useCache) {
     
     // Cache result if valid
     if (useCache && !result.empty) {
+        std::unique_lock<std::shared_mutex> lock(intervalCacheMutex);
         intervalCache[src] = result;
     }
     
     return result;
 }
 
+void clearCache() {
+    std::unique_lock<std::shared_mutex> lock(intervalCacheMutex);
+    intervalCache.clear();
+}
+
 // Default interval function (uses cache)
-Interval interval(const std::string& src) {
+Interval interval(std::string_view src) {
 
     return interval(src, true);
 }
@@ -1,7 +1,12 @@
 #include "tonalcpp/pitch_note.h"
+#include "tonalcpp/helpers.h"
+#include "tonalcpp/instrumentation.h"
+#include "tonalcpp/midi.h"
+#include <cctype>
+#include <charconv>
 #include <cmath>
-#include <regex>
-#include <map>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <algorithm>
 #include <limits>
@@ -31,7 +36,8 @@ const Note NoNote = []() {
 }();
 
 // Cache for parsed notes for performance
-static std::map<std::string, Note> noteCache;
+static helpers::StringMap<Note> noteCache;
+static std::shared_mutex noteCacheMutex;
 
 // Helper function to fill a string with repeated characters
 std::string fillStr(const std::string& s, int n) {
@@ -61,7 +67,7 @@ std::string altToAcc(int alt) {
 }
 
 // Convert accidental string to alteration value
-int accToAlt(const std::string& acc) {
+int accToAlt(std::string_view acc) {
     if (acc.empty()) {
         return 0;
     }
@@ -77,36 +83,96 @@ int mod(int n, int m) {
     return ((n % m) + m) % m;
 }
 
+namespace {
+
+// The parts of a note name, as slices of it
+struct NoteTokens {
+    std::string_view letter;
+    std::string_view acc;   // As written (double sharps as "x")
+    std::string_view oct;
+    std::string_view rest;
+    bool matched = false;
+};
+
+bool isSpace(char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+// Split a note name like the regex
+// ^([a-gA-G]?)(#{1,}|b{1,}|x{1,}|)(-?\d*)\s*(.*)$ (that never backtracks)
+NoteTokens scanNote(std::string_view str) {
+    NoteTokens tokens;
+    const size_t size = str.size();
+    size_t i = 0;
+
+    if (i < size && ((str[i] >= 'a' && str[i] <= 'g') || (str[i] >= 'A' && str[i] <= 'G'))) {
+        i++;
+    }
+    tokens.letter = str.substr(0, i);
+
+    size_t start = i;
+    if (i < size && (str[i] == '#' || str[i] == 'b' || str[i] == 'x')) {
+        const char acc = str[i];
+        while (i < size && str[i] == acc) i++;
+    }
+    tokens.acc = str.substr(start, i - start);
+
+    start = i;
+    if (i < size && str[i] == '-') i++;
+    while (i < size && str[i] >= '0' && str[i] <= '9') i++;
+    tokens.oct = str.substr(start, i - start);
+
+    while (i < size && isSpace(str[i])) i++;
+    tokens.rest = str.substr(i);
+    // (.*) doesn't match line terminators
+    tokens.matched = tokens.rest.find_first_of("\n\r") == std::string_view::npos;
+    return tokens;
+}
+
+// The accidentals with "x" replaced by "##"
+std::string accidentals(std::string_view acc) {
+    if (!acc.empty() && acc[0] == 'x') {
+        return std::string(acc.size() * 2, '#');
+    }
+    return std::string(acc);
+}
+
+} // namespace
+
 // Parse a note name into tokens
-std::tuple<std::string, std::string, std::string, std::string> tokenizeNote(const std::string& noteName) {
-    static const std::regex REGEX("^([a-gA-G]?)(#{1,}|b{1,}|x{1,}|)(-?\\d*)\\s*(.*)$");
-    std::smatch matches;
-    
-    if (std::regex_match(noteName, matches, REGEX)) {
-        std::string letter = matches[1].str();
-        std::transform(letter.begin(), letter.end(), letter.begin(), ::toupper);
-        
-        std::string acc = matches[2].str();
-        // Replace 'x' with '##' (double sharp)
-        acc = std::regex_replace(acc, std::regex("x"), "##");
-        
-        return std::make_tuple(letter, acc, matches[3].str(), matches[4].str());
+std::tuple<std::string, std::string, std::string, std::string> tokenizeNote(std::string_view noteName) {
+    const NoteTokens tokens = scanNote(noteName);
+    if (!tokens.matched) {
+        return std::make_tuple("", "", "", "");
     }
-    
-    return std::make_tuple("", "", "", "");
+
+    std::string letter(tokens.letter);
+    std::transform(letter.begin(), letter.end(), letter.begin(), ::toupper);
+    return std::make_tuple(letter, accidentals(tokens.acc), std::string(tokens.oct), std::string(tokens.rest));
 }
 
-Note parse(const std::string& noteName) {
-    auto tokens = tokenizeNote(noteName);
-    std::string letter = std::get<0>(tokens);
-    std::string acc = std::get<1>(tokens);
-    std::string octStr = std::get<2>(tokens);
-    std::string remainder = std::get<3>(tokens);
-    
+Note parse(std::string_view noteName) {
+    const NoteTokens tokens = scanNote(noteName);
+
     // Return NoNote if parsing failed or has remainder
-    if (letter.empty() || !remainder.empty()) {
+    if (!tokens.matched || tokens.letter.empty() || !tokens.rest.empty()) {
         return NoNote;
     }
+
+    const std::string letter(1, static_cast<char>(std::toupper(static_cast<unsigned char>(tokens.letter[0]))));
+    const std::string acc = accidentals(tokens.acc);
+    const std::string_view octStr = tokens.oct;
+
+    // Octave: a "-" alone or an out of range number is not valid
+    std::optional<int> oct;
+    if (!octStr.empty()) {
+        int value = 0;
+        const auto [end, error] = std::from_chars(octStr.data(), octStr.data() + octStr.size(), value);
+        if (error != std::errc() || end != octStr.data() + octStr.size()) {
+            return NoNote;
+        }
+        oct = value;
+    }
     
     // Calculate step: Use ASCII offset
     // In TypeScript this is: step = (letter.charCodeAt(0) + 3) % 7
@@ -115,7 +181,6 @@ Note parse(const std::string& noteName) {
     // Note: In TS, 'A' has step 5, 'B' has step 6, 'C' has step 0, etc.
     int step = (letter[0] - 'A' + 5) % 7;
     int alt = accToAlt(acc);
-    std::optional<int> oct = octStr.empty() ? std::nullopt : std::optional<int>(std::stoi(octStr));
     
     // Generate coordinates
     pitch::Pitch p;
@@ -125,8 +190,13 @@ Note parse(const std::string& noteName) {
     pitch::PitchCoordinates coord = pitch::coordinates(p);
     
     // Create note name and pitch class
-    std::string name = letter + acc + octStr;
+    std::string name = letter + acc;
+    name += octStr;
     std::string pc = letter + acc;
+    // Names are stored inline (see pitch::NameString)
+    if (!pitch::NameString::fits(name)) {
+        return NoNote;
+    }
     
     // Calculate chroma, height, and MIDI
     // Match TypeScript implementation: (SEMI[step] + alt + 120) % 12
@@ -140,9 +210,9 @@ Note parse(const std::string& noteName) {
     
     std::optional<int> midi = (height >= 0 && height <= 127) ? std::optional<int>(height) : std::nullopt;
     
-    // Calculate frequency
+    // Calculate frequency (table lookup for midi notes)
     std::optional<double> freq = oct.has_value() 
-        ? std::optional<double>(std::pow(2.0, (height - 69.0) / 12.0) * 440.0) 
+        ? std::optional<double>(midi::midiToFreq(height)) 
         : std::nullopt;
     
     // Create and return the note
@@ -182,18 +252,29 @@ std::string pitchName(const pitch::Pitch& pitch) {
     }
 }
 
+intern::Handle pitchNameHandle(const pitch::Pitch& pitch) {
+    return intern::intern(pitchName(pitch));
+}
+
 Note coordToNote(const pitch::PitchCoordinates& coord) {
     return note(pitch::pitchFromCoordinates(coord));
 }
 
 // Main note function implementations
-Note note(const std::string& src) {
+Note note(std::string_view src) {
+    TONAL_PROBE("pitch_note::note");
     // Check cache first
-    if (noteCache.find(src) != noteCache.end()) {
-        return noteCache[src];
+    {
+        std::shared_lock<std::shared_mutex> lock(noteCacheMutex);
+        const Note* cached = noteCache.find(src);
+        TONAL_CACHE_LOOKUP(Note, cached != nullptr);
+        if (cached) {
+            return *cached;
+        }
     }
     
     Note result = parse(src);
+    std::unique_lock<std::shared_mutex> lock(noteCacheMutex);
     noteCache[src] = result;
     return result;
 }
@@ -206,5 +287,10 @@ Note note(const pitch::NamedPitch& src) {
     return note(src.name);
 }
 
+void clearCache() {
+    std::unique_lock<std::shared_mutex> lock(noteCacheMutex);
+    noteCache.clear();
+}
+
 } // namespace pitch_note
 } // namespace tonalcpp
\ No newline at end of file
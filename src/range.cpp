@@ -1,68 +1,219 @@
 #include "tonalcpp/range.h"
-#include "tonalcpp/collection.h"
 #include "tonalcpp/midi.h"
 #include "tonalcpp/note.h"
+#include <array>
+#include <bitset>
 #include <optional>
 #include <algorithm>
 
 namespace tonalcpp {
 namespace range {
 
-std::vector<int> numeric(const std::vector<std::string>& notes) {
-    if (notes.empty()) {
-        return {};
+namespace {
+
+bool hasChroma(unsigned mask, int midi) {
+    return (mask >> (((midi % 12) + 12) % 12)) & 1u;
+}
+
+// Number of midi numbers in [low, high] of the pitch classes of the mask
+std::size_t countChromas(int low, int high, unsigned mask) {
+    if (low > high) {
+        return 0;
     }
-    
-    // Convert notes to MIDI numbers, filter out invalid ones
-    std::vector<int> midiNotes;
-    midiNotes.reserve(notes.size());
-    
-    for (const auto& note : notes) {
-        auto midiValue = midi::toMidi(note);
-        if (midiValue.has_value()) {
-            midiNotes.push_back(midiValue.value());
+    const int length = high - low + 1;
+    std::size_t count = static_cast<std::size_t>(length / 12) * std::bitset<12>(mask).count();
+    for (int m = low + (length / 12) * 12; m <= high; m++) {
+        count += hasChroma(mask, m);
+    }
+    return count;
+}
+
+// Number of notes of segment s of a range: the notes after ends[s - 1]
+// up to ends[s] (the first note of the range is counted apart)
+std::size_t segmentCount(const std::vector<int>& ends, std::size_t s, unsigned mask) {
+    const int from = ends[s - 1];
+    const int to = ends[s];
+    return from < to ? countChromas(from + 1, to, mask) : countChromas(to, from - 1, mask);
+}
+
+// Interned note names of all the midi numbers
+const std::string& noteName(int midi, bool sharps) {
+    using Names = std::array<std::string, 128>;
+    static const std::array<Names, 2> names = []() {
+        std::array<Names, 2> result;
+        midi::ToNoteNameOptions options;
+        for (int s = 0; s < 2; s++) {
+            options.sharps = s == 1;
+            for (int m = 0; m < 128; m++) {
+                result[s][m] = midi::midiToNoteName(m, options);
+            }
+        }
+        return result;
+    }();
+    return names[sharps ? 1 : 0][midi];
+}
+
+} // namespace
+
+NumericView::NumericView(std::vector<int> ends, unsigned mask)
+    : ends(std::move(ends)), mask(mask & ALL_CHROMAS) {
+    if (this->ends.empty()) {
+        return;
+    }
+    count = hasChroma(this->mask, this->ends[0]) ? 1 : 0;
+    for (std::size_t s = 1; s < this->ends.size(); s++) {
+        count += segmentCount(this->ends, s, this->mask);
+    }
+}
+
+int NumericView::operator[](std::size_t index) const {
+    if (hasChroma(mask, ends[0])) {
+        if (index == 0) {
+            return ends[0];
+        }
+        index--;
+    }
+    for (std::size_t s = 1; s < ends.size(); s++) {
+        const std::size_t notes = segmentCount(ends, s, mask);
+        if (index >= notes) {
+            index -= notes;
+            continue;
+        }
+        const int dir = ends[s] > ends[s - 1] ? 1 : -1;
+        const int first = ends[s - 1] + dir;
+        if (mask == ALL_CHROMAS) {
+            return first + dir * static_cast<int>(index);
+        }
+        // Skip whole octaves, then walk to the note
+        const std::size_t perOctave = std::bitset<12>(mask).count();
+        int m = first + dir * 12 * static_cast<int>(index / perOctave);
+        index %= perOctave;
+        for (;; m += dir) {
+            if (hasChroma(mask, m) && index-- == 0) {
+                return m;
+            }
         }
     }
-    
-    if (midiNotes.empty() || midiNotes.size() != notes.size()) {
-        // There are invalid notes
-        return {};
+    return 0;
+}
+
+NumericView::Iterator NumericView::begin() const {
+    if (count == 0) {
+        return end();
     }
-    
-    // Build the range by connecting consecutive MIDI notes
-    std::vector<int> result;
-    result.push_back(midiNotes[0]);
-    
-    for (size_t i = 1; i < midiNotes.size(); ++i) {
-        int last = result.back();
-        int current = midiNotes[i];
-        
-        // Get the range from last to current (excluding the first element since it's already in result)
-        auto subRange = collection::range(last, current);
-        if (subRange.size() > 1) {
-            result.insert(result.end(), subRange.begin() + 1, subRange.end());
+    Iterator it(this, 0, ends[0]);
+    if (!hasChroma(mask, ends[0])) {
+        it.advance();
+    }
+    return it;
+}
+
+void NumericView::Iterator::advance() {
+    const unsigned mask = view->mask;
+    for (;;) {
+        // Move to the next segment when the end of this one is reached
+        if (value == target) {
+            const auto& ends = view->ends;
+            if (++segment >= ends.size()) {
+                segment = ends.size();
+                value = 0;
+                return;
+            }
+            target = ends[segment];
+            step = target > value ? 1 : -1;
+            continue;
+        }
+        value += step;
+        if (mask == ALL_CHROMAS || hasChroma(mask, value)) {
+            return;
+        }
+    }
+}
+
+std::vector<int> NumericView::toVector() const {
+    if (mask != ALL_CHROMAS) {
+        return std::vector<int>(begin(), end());
+    }
+    // Fill the segments directly
+    std::vector<int> result(count);
+    if (count == 0) {
+        return result;
+    }
+    std::size_t i = 0;
+    result[i++] = ends[0];
+    for (std::size_t s = 1; s < ends.size(); s++) {
+        const int dir = ends[s] > ends[s - 1] ? 1 : -1;
+        for (int m = ends[s - 1]; m != ends[s];) {
+            m += dir;
+            result[i++] = m;
         }
     }
-    
     return result;
 }
 
-std::vector<std::string> chromatic(const std::vector<std::string>& notes, bool sharps) {
-    auto midiNumbers = numeric(notes);
-    
+const std::string& ChromaticView::Iterator::operator*() const {
+    return noteName(*it, sharps);
+}
+
+const std::string& ChromaticView::operator[](std::size_t index) const {
+    return noteName(midi[index], sharps);
+}
+
+std::vector<std::string> ChromaticView::toVector() const {
     std::vector<std::string> result;
-    result.reserve(midiNumbers.size());
-    
-    for (int midiNum : midiNumbers) {
-        midi::ToNoteNameOptions options;
-        options.sharps = sharps;
-        options.pitchClass = false;
-        std::string noteName = midi::midiToNoteName(midiNum, options);
-        result.push_back(noteName);
+    result.reserve(size());
+    for (const auto& name : *this) {
+        result.push_back(name);
     }
-    
     return result;
 }
 
+NumericView numericView(const std::vector<std::string>& notes) {
+    // Convert notes to MIDI numbers. Any invalid note makes the range invalid
+    std::vector<int> ends;
+    ends.reserve(notes.size());
+    for (const auto& note : notes) {
+        auto midiValue = midi::toMidi(note);
+        if (!midiValue.has_value()) {
+            return NumericView();
+        }
+        ends.push_back(midiValue.value());
+    }
+    return NumericView(std::move(ends));
+}
+
+ChromaticView chromaticView(const std::vector<std::string>& notes, bool sharps) {
+    return ChromaticView(numericView(notes), sharps);
+}
+
+std::pmr::vector<int> numeric(std::pmr::memory_resource* resource, const std::vector<std::string>& notes) {
+    const NumericView view = numericView(notes);
+    std::pmr::vector<int> result(resource);
+    result.reserve(view.size());
+    result.insert(result.end(), view.begin(), view.end());
+    return result;
+}
+
+std::pmr::vector<std::pmr::string> chromatic(
+    std::pmr::memory_resource* resource,
+    const std::vector<std::string>& notes,
+    bool sharps) {
+    const ChromaticView view = chromaticView(notes, sharps);
+    std::pmr::vector<std::pmr::string> result(resource);
+    result.reserve(view.size());
+    for (const auto& name : view) {
+        result.emplace_back(name);
+    }
+    return result;
+}
+
+std::vector<int> numeric(const std::vector<std::string>& notes) {
+    return numericView(notes).toVector();
+}
+
+std::vector<std::string> chromatic(const std::vector<std::string>& notes, bool sharps) {
+    return chromaticView(notes, sharps).toVector();
+}
+
 } // namespace range
-} // namespace tonalcpp
\ No newline at end of file
+} // namespace tonalcpp
@@ -1,4 +1,5 @@
 #include "tonalcpp/scale.h"
+#include "tonalcpp/instrumentation.h"
 
 #include <algorithm>
 #include <set>
@@ -33,7 +34,7 @@ const Scale NoScale = []() {
     return s;
 }();
 
-ScaleNameTokens tokenize(const ScaleName& name) {
+ScaleNameTokens tokenize(std::string_view name) {
     if (name.empty()) {
         return std::make_tuple("", "");
     }
@@ -44,7 +45,7 @@ ScaleNameTokens tokenize(const ScaleName& name) {
     if (noteObj.empty) {
         const pitch_note::Note n = pitch_note::note(name);
         if (n.empty) {
-            std::string lowerName = name;
+            std::string lowerName(name);
             std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(), 
                           [](unsigned char c){ return std::tolower(c); });
             return std::make_tuple("", lowerName);
@@ -54,7 +55,7 @@ ScaleNameTokens tokenize(const ScaleName& name) {
     }
 
     std::string type;
-    if (i != std::string::npos && i + 1 < name.size()) {
+    if (i != std::string_view::npos && i + 1 < name.size()) {
         type = name.substr(i + 1);
         std::transform(type.begin(), type.end(), type.begin(), 
                       [](unsigned char c){ return std::tolower(c); });
@@ -67,11 +68,12 @@ std::vector<std::string> names() {
     return scale_type::names();
 }
 
-Scale get(const ScaleName& src) {
+Scale get(std::string_view src) {
     return get(tokenize(src));
 }
 
 Scale get(const ScaleNameTokens& tokens) {
+    TONAL_PROBE("scale::get");
     const std::string& tokenTonic = std::get<0>(tokens);
     const pitch_note::Note tonicNote = pitch_note::note(tokenTonic);
     const scale_type::ScaleType st = scale_type::get(std::get<1>(tokens));
@@ -115,6 +117,7 @@ std::vector<std::string> detect(
     const std::vector<std::string>& notes,
     const std::string& inputTonic,
     const std::string& match) {
+    TONAL_PROBE("scale::detect");
     
     const std::string notesChroma = pcset::chroma(notes);
     
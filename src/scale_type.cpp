@@ -1,5 +1,9 @@
 #include "tonalcpp/scale_type.h"
+#include "tonalcpp/helpers.h"
 #include <algorithm>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
 
 namespace tonalcpp {
 namespace scale_type {
@@ -20,8 +24,13 @@ const ScaleType NoScaleType = {
 // Internal storage for the scale type dictionary
 namespace {
     std::vector<ScaleType> dictionary;
-    std::unordered_map<std::string, ScaleType*> index;
-    std::unordered_map<int, ScaleType*> numIndex;
+    // Positions of the keys and set numbers in the dictionary
+    helpers::StringMap<std::size_t> index;
+    std::unordered_map<int, std::size_t> numIndex;
+    // Readers take a shared lock. Writers take writerMutex for the whole
+    // update, and a unique lock only while they change the dictionary
+    std::shared_mutex dictionaryMutex;
+    std::mutex writerMutex;
 }
 
 // SCALES data formatted as ["intervals", "name", "alias1", "alias2", ...]
@@ -145,6 +154,7 @@ bool ensureInitialized();
 
 std::vector<std::string> names() {
     ensureInitialized();
+    std::shared_lock<std::shared_mutex> lock(dictionaryMutex);
     std::vector<std::string> result;
     result.reserve(dictionary.size());
     for (const auto& scale : dictionary) {
@@ -153,57 +163,63 @@ std::vector<std::string> names() {
     return result;
 }
 
-ScaleType get(const ScaleTypeName& type) {
+ScaleType get(std::string_view type) {
     ensureInitialized();
-    auto it = index.find(type);
-    if (it != index.end()) {
-        return *(it->second);
+    std::shared_lock<std::shared_mutex> lock(dictionaryMutex);
+    if (const std::size_t* found = index.find(type)) {
+        return dictionary[*found];
     }
     return NoScaleType;
 }
 
 ScaleType get(int setNum) {
     ensureInitialized();
+    std::shared_lock<std::shared_mutex> lock(dictionaryMutex);
     auto it = numIndex.find(setNum);
     if (it != numIndex.end()) {
-        return *(it->second);
+        return dictionary[it->second];
     }
     return NoScaleType;
 }
 
 std::vector<ScaleType> all() {
     ensureInitialized();
+    std::shared_lock<std::shared_mutex> lock(dictionaryMutex);
     return dictionary;
 }
 
 std::vector<std::string> keys() {
     ensureInitialized();
+    std::shared_lock<std::shared_mutex> lock(dictionaryMutex);
     std::vector<std::string> result;
     result.reserve(index.size());
     for (const auto& entry : index) {
-        result.push_back(entry.first);
+        result.emplace_back(entry.first);
     }
     return result;
 }
 
-void removeAll() {
+// Clear the dictionary and the indexes
+static void clear() {
     dictionary.clear();
     index.clear();
     numIndex.clear();
 }
 
-ScaleType add(const std::vector<std::string>& intervals, 
-              const std::string& name, 
-              const std::vector<std::string>& aliases) {
-    
+void removeAll() {
+    ensureInitialized();
+    std::lock_guard<std::mutex> writer(writerMutex);
+    std::unique_lock<std::shared_mutex> lock(dictionaryMutex);
+    clear();
+}
+
+// Create a scale type
+static ScaleType makeScaleType(const std::vector<std::string>& intervals,
+                               const std::string& name,
+                               const std::vector<std::string>& aliases) {
     // Create scale type from intervals
     pcset::Pcset pcsetBase = pcset::getPcset(intervals);
     
-    // Pre-allocate space to avoid reallocation during additions
-    if (dictionary.capacity() == dictionary.size()) {
-        dictionary.reserve(dictionary.size() + 100);
-    }
-    
     // Create new scale
     ScaleType scale;
     
@@ -215,34 +231,116 @@ ScaleType add(const std::vector<std::string>& intervals,
     scale.normalized = pcsetBase.normalized;
     scale.intervals = intervals;
     scale.aliases = aliases;
-    
-    // Add to dictionary
-    dictionary.push_back(scale);
-    
-    // Get a reference to the actual scale in the dictionary
-    ScaleType* storedScale = &dictionary.back();
-    
-    // Add all indexes
-    index[storedScale->name] = storedScale;
-    numIndex[storedScale->setNum] = storedScale;
-    index[storedScale->chroma] = storedScale;
+    return scale;
+}
+
+// Add the keys of the scale at a position of the dictionary to the indexes
+static void indexScaleType(helpers::StringMap<std::size_t>& target,
+                           std::unordered_map<int, std::size_t>& numTarget,
+                           const ScaleType& scale,
+                           std::size_t position) {
+    target[scale.name] = position;
+    numTarget[scale.setNum] = position;
+    target[scale.chroma] = position;
     
     // Add all aliases
-    for (const auto& alias : storedScale->aliases) {
-        index[alias] = storedScale;
+    for (const auto& alias : scale.aliases) {
+        target[alias] = position;
+    }
+}
+
+// Replace the dictionary, indexing it in one pass: a key of several scales
+// finds the last one. The caller holds writerMutex
+static void publish(std::vector<ScaleType> scales) {
+    std::size_t keyCount = 0;
+    for (const auto& scale : scales) {
+        keyCount += 2 + scale.aliases.size();
+    }
+    helpers::StringMap<std::size_t> nextIndex;
+    std::unordered_map<int, std::size_t> nextNumIndex;
+    nextIndex.reserve(keyCount);
+    nextNumIndex.reserve(scales.size());
+    for (std::size_t i = 0; i < scales.size(); i++) {
+        indexScaleType(nextIndex, nextNumIndex, scales[i], i);
+    }
+    
+    std::unique_lock<std::shared_mutex> lock(dictionaryMutex);
+    dictionary.swap(scales);
+    index = std::move(nextIndex);
+    numIndex.swap(nextNumIndex);
+}
+
+ScaleType add(const std::vector<std::string>& intervals, 
+              const std::string& name, 
+              const std::vector<std::string>& aliases) {
+    ensureInitialized();
+    ScaleType scale = makeScaleType(intervals, name, aliases);
+    std::lock_guard<std::mutex> writer(writerMutex);
+    std::unique_lock<std::shared_mutex> lock(dictionaryMutex);
+    dictionary.push_back(scale);
+    indexScaleType(index, numIndex, dictionary.back(), dictionary.size() - 1);
+    return scale;
+}
+
+// Add the scales to a copy of the dictionary, and publish it. The caller
+// holds writerMutex, so the dictionary doesn't change meanwhile
+static void addScaleTypes(std::vector<ScaleType> scales) {
+    std::vector<ScaleType> next;
+    next.reserve(dictionary.size() + scales.size());
+    next.insert(next.end(), dictionary.begin(), dictionary.end());
+    helpers::mergeTypes(next, std::move(scales));
+    publish(std::move(next));
+}
+
+bool addAll(const Definition* definitions, std::size_t count) {
+    ensureInitialized();
+    std::vector<ScaleType> scales(count);
+    // The normalized chroma of each set number, when needed
+    std::vector<std::string> normalized(4096);
+    for (std::size_t i = 0; i < count; i++) {
+        const Definition& definition = definitions[i];
+        ScaleType& scale = scales[i];
+        scale.chroma = pcset::intervalsChroma(definition.intervals);
+        if (scale.chroma.empty() || definition.name.empty()) {
+            return false;
+        }
+        scale.name = definition.name;
+        scale.empty = false;
+        scale.setNum = pcset::chromaToNumber(scale.chroma);
+        if (normalized[scale.setNum].empty()) {
+            normalized[scale.setNum] = pcset::getPcset(scale.chroma).normalized;
+        }
+        scale.normalized = normalized[scale.setNum];
+        scale.intervals = definition.intervals;
+        scale.aliases = definition.aliases;
     }
     
-    return *storedScale;
+    std::lock_guard<std::mutex> writer(writerMutex);
+    addScaleTypes(std::move(scales));
+    return true;
+}
+
+bool addAll(const std::vector<Definition>& definitions) {
+    return addAll(definitions.data(), definitions.size());
+}
+
+void addAll(const ScaleType* types, std::size_t count) {
+    ensureInitialized();
+    std::vector<ScaleType> scales(types, types + count);
+    std::lock_guard<std::mutex> writer(writerMutex);
+    addScaleTypes(std::move(scales));
 }
 
 void addAlias(const ScaleType& scale, const std::string& alias) {
+    ensureInitialized();
+    std::lock_guard<std::mutex> writer(writerMutex);
+    std::unique_lock<std::shared_mutex> lock(dictionaryMutex);
     // Find the scale in the dictionary by name (safer than comparing by reference)
-    for (auto& entry : dictionary) {
-        if (entry.name == scale.name) {
+    for (std::size_t i = 0; i < dictionary.size(); i++) {
+        if (dictionary[i].name == scale.name) {
             // Add the alias to the entry's aliases
-            entry.aliases.push_back(alias);
-            // Add to index - use pointer to the element in the dictionary
-            index[alias] = &entry;
+            dictionary[i].aliases.push_back(alias);
+            index[alias] = i;
             break;
         }
     }
@@ -267,12 +365,10 @@ std::vector<std::string> splitString(const std::string& str) {
     return result;
 }
 
-void initialize() {
-    // Clear any existing data
-    removeAll();
-    
-    // Pre-allocate space to avoid reallocations
-    dictionary.reserve(SCALES.size());
+// Fill the dictionary with the predefined scales
+static void loadScaleTypes() {
+    std::vector<ScaleType> scales;
+    scales.reserve(SCALES.size());
     
     // Add all scales from data
     for (const auto& scale : SCALES) {
@@ -286,25 +382,33 @@ void initialize() {
                 aliases.push_back(scale[i]);
             }
             
-            add(intervals, name, aliases);
+            scales.push_back(makeScaleType(intervals, name, aliases));
         }
     }
+    std::lock_guard<std::mutex> writer(writerMutex);
+    publish(std::move(scales));
 }
 
-// Call initialize explicitly in the first function access to ensure it's properly initialized
-// This is another safeguard in case static initialization didn't work as expected
-bool ensureInitialized() {
-    static bool initialized = false;
-    if (!initialized) {
-        initialize();
-        initialized = true;
+static std::once_flag loaded;
+
+void initialize() {
+    // Load them once: on the first use, ensureInitialized does it
+    bool first = false;
+    std::call_once(loaded, [&first]() {
+        loadScaleTypes();
+        first = true;
+    });
+    if (!first) {
+        loadScaleTypes();
     }
-    return initialized;
 }
 
-namespace {
-    // Force initialization
-    const bool initialized = ensureInitialized();
+// Initialize the dictionary on first access (only once, even with several
+// threads). It's not done during static initialization because it depends
+// on the note and pcset caches of other translation units
+bool ensureInitialized() {
+    std::call_once(loaded, loadScaleTypes);
+    return true;
 }
 
 } // namespace scale_type
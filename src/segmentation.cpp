@@ -0,0 +1,237 @@
+#include "tonalcpp/segmentation.h"
+#include "tonalcpp/midi.h"
+#include "tonalcpp/pcset.h"
+#include <algorithm>
+#include <array>
+
+namespace tonalcpp {
+namespace segmentation {
+
+ChordLabeler::ChordLabeler(const chord_detect::DetectOptions& options) : options(options) {}
+
+intern::Handle ChordLabeler::operator()(std::uint16_t mask, int bass) {
+    if (mask == 0 || mask > 4095 || bass < 0 || bass > 11) {
+        return intern::Handle();
+    }
+    if (labels.empty()) {
+        labels.resize(12 << 12);
+        known.resize(12 << 12);
+    }
+    const std::size_t key = (static_cast<std::size_t>(bass) << 12) | mask;
+    if (known[key]) {
+        return labels[key];
+    }
+
+    // The bass first: chord_detect takes it as the root of inversions
+    std::vector<std::string> notes = pcset::notes(mask);
+    int below = 0;
+    for (int chroma = 0; chroma < bass; chroma++) {
+        below += (mask >> (11 - chroma)) & 1;
+    }
+    std::rotate(notes.begin(), notes.begin() + below, notes.end());
+
+    const std::vector<std::string> chords = chord_detect::detect(notes, options);
+    count++;
+    known[key] = true;
+    labels[key] = chords.empty() ? intern::Handle() : intern::intern(chords[0]);
+    return labels[key];
+}
+
+namespace {
+
+// The notes sounding, counted by key (a key can be played by many tracks)
+class Sounding {
+public:
+    void apply(std::uint8_t key, bool on) {
+        if (on) {
+            keys[key]++;
+            if (pitchClasses[midi::chroma(key)]++ == 0) {
+                mask |= bit(key);
+            }
+        } else if (keys[key] > 0) {
+            keys[key]--;
+            if (--pitchClasses[midi::chroma(key)] == 0) {
+                mask &= ~bit(key);
+            }
+        }
+    }
+
+    std::uint16_t pitchClassMask() const { return mask; }
+
+    int bass() const {
+        for (int key = 0; key < 128; key++) {
+            if (keys[key] > 0) return key;
+        }
+        return -1;
+    }
+
+    static std::uint16_t bit(int key) {
+        return static_cast<std::uint16_t>(1 << (11 - midi::chroma(key)));
+    }
+
+private:
+    std::array<int, 128> keys = {};
+    std::array<int, 12> pitchClasses = {};
+    std::uint16_t mask = 0;
+};
+
+// Label the segments as they are found, merging equal chords
+class Builder {
+public:
+    explicit Builder(ChordLabeler& labeler) : labeler(labeler) {}
+
+    void add(std::uint32_t start, std::uint32_t end, std::uint16_t mask, int bass) {
+        if (mask == 0 || end <= start) {
+            return;
+        }
+        const intern::Handle chord = labeler(mask, midi::chroma(bass));
+        if (!segments.empty() && segments.back().end == start && segments.back().chord == chord) {
+            segments.back().end = end;
+            segments.back().mask |= mask;
+            return;
+        }
+        segments.push_back({start, end, mask, bass, chord});
+    }
+
+    std::vector<Segment> segments;
+
+private:
+    ChordLabeler& labeler;
+};
+
+// Apply the events of the tick of events[i]: note offs first, so a note
+// played again at the same tick keeps sounding. Returns the next index
+std::size_t applyTick(const smf::NoteEvents& events, std::size_t i, bool drums, Sounding& sounding) {
+    std::size_t end = i;
+    while (end < events.size() && events.ticks[end] == events.ticks[i]) {
+        end++;
+    }
+    for (bool on : {false, true}) {
+        for (std::size_t e = i; e < end; e++) {
+            if (events.isNoteOn(e) == on && (drums || events.channels[e] != 9)) {
+                sounding.apply(events.keys[e], on);
+            }
+        }
+    }
+    return end;
+}
+
+void byOnsets(const smf::NoteEvents& events, bool drums, Builder& builder) {
+    Sounding sounding;
+    std::uint32_t start = 0;
+    std::uint16_t mask = 0;
+    int bass = -1;
+    for (std::size_t i = 0; i < events.size();) {
+        const std::uint32_t tick = events.ticks[i];
+        i = applyTick(events, i, drums, sounding);
+        const int nextBass = sounding.bass();
+        if (sounding.pitchClassMask() != mask || nextBass != bass) {
+            builder.add(start, tick, mask, bass);
+            start = tick;
+            mask = sounding.pitchClassMask();
+            bass = nextBass;
+        }
+    }
+}
+
+void byBeats(const smf::NoteEvents& events, std::uint32_t step, bool drums, Builder& builder) {
+    Sounding sounding;
+    std::size_t i = 0;
+    std::uint64_t start = 0;
+    while (i < events.size()) {
+        // Skip the silent steps
+        if (sounding.pitchClassMask() == 0) {
+            start = std::max<std::uint64_t>(start, events.ticks[i] / step * std::uint64_t(step));
+        }
+        const std::uint64_t end = start + step;
+        // The notes released at the start of the step are not in it
+        if (events.ticks[i] == start) {
+            i = applyTick(events, i, drums, sounding);
+        }
+        std::uint16_t mask = sounding.pitchClassMask();
+        int bass = sounding.bass();
+        while (i < events.size() && events.ticks[i] < end) {
+            i = applyTick(events, i, drums, sounding);
+            mask |= sounding.pitchClassMask();
+            const int lowest = sounding.bass();
+            if (lowest >= 0 && (bass < 0 || lowest < bass)) {
+                bass = lowest;
+            }
+        }
+        builder.add(static_cast<std::uint32_t>(start),
+                    static_cast<std::uint32_t>(std::min<std::uint64_t>(end, UINT32_MAX)), mask, bass);
+        start = end;
+    }
+}
+
+} // namespace
+
+std::vector<Segment> segment(
+    const smf::NoteEvents& events,
+    const SegmentOptions& options,
+    ChordLabeler& labeler
+) {
+    Builder builder(labeler);
+    if (options.slicing == Slicing::Onsets) {
+        byOnsets(events, options.drums, builder);
+    } else if (options.step > 0) {
+        byBeats(events, options.step, options.drums, builder);
+    }
+    return std::move(builder.segments);
+}
+
+// A step of 0 is a quarter note, if the division is in ticks per quarter
+static SegmentOptions withStep(const SegmentOptions& options, const smf::MidiFile& file) {
+    SegmentOptions result = options;
+    if (result.step == 0 && file.division > 0) {
+        result.step = static_cast<std::uint32_t>(file.division);
+    }
+    return result;
+}
+
+std::vector<Segment> segment(const smf::MidiFile& file, const SegmentOptions& options) {
+    ChordLabeler labeler(options.detect);
+    return segment(file.events, withStep(options, file), labeler);
+}
+
+std::vector<std::vector<Segment>> segmentBatch(
+    const smf::MidiFile* files,
+    std::size_t count,
+    const SegmentOptions& options,
+    thread_pool::ThreadPool& pool
+) {
+    std::vector<std::vector<Segment>> result(count);
+    std::vector<ChordLabeler> labelers(pool.size(), ChordLabeler(options.detect));
+    pool.parallelFor(count, [&](std::size_t begin, std::size_t end, std::size_t worker) {
+        for (std::size_t i = begin; i < end; i++) {
+            result[i] = segment(files[i].events, withStep(options, files[i]), labelers[worker]);
+        }
+    });
+    return result;
+}
+
+std::vector<std::vector<Segment>> segmentFiles(
+    const std::string* paths,
+    std::size_t count,
+    const SegmentOptions& options,
+    thread_pool::ThreadPool& pool
+) {
+    struct Worker {
+        ChordLabeler labeler;
+        smf::MidiFile file;
+    };
+    std::vector<std::vector<Segment>> result(count);
+    std::vector<Worker> workers(pool.size(), Worker{ChordLabeler(options.detect), smf::MidiFile()});
+    pool.parallelFor(count, [&](std::size_t begin, std::size_t end, std::size_t worker) {
+        Worker& w = workers[worker];
+        for (std::size_t i = begin; i < end; i++) {
+            if (smf::load(paths[i], w.file)) {
+                result[i] = segment(w.file.events, withStep(options, w.file), w.labeler);
+            }
+        }
+    });
+    return result;
+}
+
+} // namespace segmentation
+} // namespace tonalcpp
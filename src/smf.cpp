@@ -0,0 +1,396 @@
+#include "tonalcpp/smf.h"
+#include "tonalcpp/helpers.h"
+#include "tonalcpp/midi.h"
+#include "tonalcpp/voice_leading.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <numeric>
+
+namespace tonalcpp {
+namespace smf {
+
+namespace {
+
+// Reads big endian values and variable length quantities within bounds
+struct Reader {
+    const std::uint8_t* pos;
+    const std::uint8_t* end;
+
+    bool has(std::size_t count) const {
+        return static_cast<std::size_t>(end - pos) >= count;
+    }
+
+    bool skip(std::size_t count) {
+        if (!has(count)) return false;
+        pos += count;
+        return true;
+    }
+
+    std::uint16_t u16() {
+        const std::uint16_t value = static_cast<std::uint16_t>((pos[0] << 8) | pos[1]);
+        pos += 2;
+        return value;
+    }
+
+    std::uint32_t u32() {
+        const std::uint32_t value = (std::uint32_t(pos[0]) << 24) | (std::uint32_t(pos[1]) << 16) |
+                                    (std::uint32_t(pos[2]) << 8) | std::uint32_t(pos[3]);
+        pos += 4;
+        return value;
+    }
+
+    // Variable length quantity: 7 bits per byte, the high bit set on all
+    // the bytes but the last one. At most 4 bytes
+    bool vlq(std::uint32_t& value) {
+        value = 0;
+        for (int i = 0; i < 4 && pos != end; i++) {
+            const std::uint8_t byte = *pos++;
+            value = (value << 7) | (byte & 0x7F);
+            if (!(byte & 0x80)) return true;
+        }
+        return false;
+    }
+};
+
+bool readTrack(Reader track, std::uint16_t index, NoteEvents& events) {
+    std::uint64_t tick = 0;
+    std::uint8_t running = 0;  // Status of the last channel message (0 = none)
+
+    while (track.pos != track.end) {
+        std::uint32_t delta;
+        if (!track.vlq(delta) || !track.has(1)) return false;
+        tick += delta;
+        if (tick > std::numeric_limits<std::uint32_t>::max()) return false;
+
+        // Running status: the status byte can be left out after a channel message
+        std::uint8_t status = *track.pos;
+        if (status & 0x80) {
+            track.pos++;
+        } else if (running != 0) {
+            status = running;
+        } else {
+            return false;
+        }
+
+        if (status < 0xF0) {
+            // Channel message: program change and channel pressure have one data byte
+            running = status;
+            const std::size_t length = (status & 0xE0) == 0xC0 ? 1 : 2;
+            if (!track.has(length)) return false;
+            const std::uint8_t type = status & 0xF0;
+            if (type == 0x90 || type == 0x80) {
+                const std::uint8_t velocity = type == 0x90 ? track.pos[1] & 0x7F : 0;
+                events.push_back(static_cast<std::uint32_t>(tick), status & 0x0F, track.pos[0] & 0x7F,
+                                 velocity, index);
+            }
+            track.pos += length;
+        } else if (status == 0xFF) {
+            // Meta event: type, length and data. It cancels the running status
+            running = 0;
+            std::uint32_t length;
+            if (!track.has(1)) return false;
+            const std::uint8_t type = *track.pos++;
+            if (!track.vlq(length) || !track.skip(length)) return false;
+            if (type == 0x2F) break;  // End of track
+        } else if (status == 0xF0 || status == 0xF7) {
+            // Sysex event: length and data
+            running = 0;
+            std::uint32_t length;
+            if (!track.vlq(length) || !track.skip(length)) return false;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Reorder values in place, through a scratch buffer wide enough for every
+// column: values keeps its capacity, and one buffer serves all the columns
+template<typename T>
+void permute(std::vector<T>& values, const std::vector<std::uint32_t>& order,
+             std::vector<std::uint32_t>& scratch) {
+    static_assert(sizeof(T) <= sizeof(std::uint32_t), "The scratch buffer holds 32 bits");
+    scratch.resize(order.size());
+    for (std::size_t i = 0; i < order.size(); i++) {
+        scratch[i] = values[order[i]];
+    }
+    for (std::size_t i = 0; i < order.size(); i++) {
+        values[i] = static_cast<T>(scratch[i]);
+    }
+}
+
+// Merge the tracks by tick. The events of each track are sorted and
+// contiguous (bounds[i] to bounds[i + 1]): the tracks are merged two by two,
+// keeping the track order for events at the same tick
+void mergeTracks(NoteEvents& events, const std::vector<std::size_t>& bounds) {
+    if (std::is_sorted(events.ticks.begin(), events.ticks.end())) {
+        return;
+    }
+    std::vector<std::uint32_t> order(events.size());
+    std::iota(order.begin(), order.end(), 0);
+    const auto byTick = [&](std::uint32_t a, std::uint32_t b) { return events.ticks[a] < events.ticks[b]; };
+    const std::size_t runs = bounds.size() - 1;
+    for (std::size_t width = 1; width < runs; width *= 2) {
+        for (std::size_t i = 0; i + width < runs; i += 2 * width) {
+            std::inplace_merge(order.begin() + bounds[i], order.begin() + bounds[i + width],
+                               order.begin() + bounds[std::min(i + 2 * width, runs)], byTick);
+        }
+    }
+    std::vector<std::uint32_t> scratch;
+    scratch.reserve(order.size());
+    permute(events.ticks, order, scratch);
+    permute(events.channels, order, scratch);
+    permute(events.keys, order, scratch);
+    permute(events.velocities, order, scratch);
+    permute(events.tracks, order, scratch);
+}
+
+bool fail(MidiFile& file) {
+    file.empty = true;
+    file.format = 0;
+    file.tracks = 0;
+    file.division = 0;
+    file.events.clear();
+    return false;
+}
+
+} // namespace
+
+bool parse(const std::uint8_t* data, std::size_t size, MidiFile& file) {
+    fail(file);
+    Reader reader{data, data + size};
+
+    // Header chunk: "MThd", length, format, number of tracks and division
+    if (data == nullptr || !reader.has(14) || std::memcmp(reader.pos, "MThd", 4) != 0) {
+        return fail(file);
+    }
+    reader.pos += 4;
+    const std::uint32_t headerLength = reader.u32();
+    if (headerLength < 6 || !reader.has(headerLength)) {
+        return fail(file);
+    }
+    Reader header{reader.pos, reader.pos + headerLength};
+    const int format = header.u16();
+    header.u16();  // Number of tracks (the chunks found are used instead)
+    const int division = static_cast<std::int16_t>(header.u16());
+    reader.pos += headerLength;
+    if (format > 1) {
+        return fail(file);
+    }
+
+    // A note event takes 3 bytes at least (delta time and two data bytes
+    // with running status): no reallocation while decoding
+    file.events.reserve(size / 3);
+
+    // Track chunks. Chunks of other types are skipped
+    int tracks = 0;
+    std::vector<std::size_t> bounds = {0};
+    while (reader.has(8)) {
+        const std::uint8_t* type = reader.pos;
+        reader.pos += 4;
+        const std::uint32_t length = reader.u32();
+        if (!reader.has(length) || tracks > std::numeric_limits<std::uint16_t>::max()) {
+            return fail(file);
+        }
+        if (std::memcmp(type, "MTrk", 4) == 0) {
+            if (!readTrack(Reader{reader.pos, reader.pos + length}, static_cast<std::uint16_t>(tracks),
+                           file.events)) {
+                return fail(file);
+            }
+            bounds.push_back(file.events.size());
+            tracks++;
+        }
+        reader.pos += length;
+    }
+
+    mergeTracks(file.events, bounds);
+    file.empty = false;
+    file.format = format;
+    file.tracks = tracks;
+    file.division = division;
+    return true;
+}
+
+MidiFile parse(const std::uint8_t* data, std::size_t size) {
+    MidiFile file;
+    parse(data, size, file);
+    return file;
+}
+
+bool load(const std::string& path, MidiFile& file) {
+    const helpers::MappedFile mapped(path);
+    if (!mapped.isOpen()) {
+        return fail(file);
+    }
+    return parse(mapped.data(), mapped.size(), file);
+}
+
+MidiFile load(const std::string& path) {
+    MidiFile file;
+    load(path, file);
+    return file;
+}
+
+Writer::Writer(int division) : division(division) {
+    clear();
+}
+
+void Writer::clear() {
+    // Header chunk. The format and the number of tracks are set by finish
+    bytes.assign({'M', 'T', 'h', 'd', 0, 0, 0, 6, 0, 0, 0, 0,
+                  static_cast<std::uint8_t>(division >> 8), static_cast<std::uint8_t>(division)});
+    pending.clear();
+    tracks = 0;
+    trackStart = 0;
+    last = 0;
+    running = 0;
+}
+
+void Writer::beginTrack() {
+    endTrack();
+    trackStart = bytes.size();
+    bytes.insert(bytes.end(), {'M', 'T', 'r', 'k', 0, 0, 0, 0});
+    tracks++;
+    last = 0;
+    running = 0;
+}
+
+void Writer::endTrack() {
+    if (trackStart == 0) {
+        return;
+    }
+    flush(std::numeric_limits<std::uint32_t>::max());
+    delta(last);
+    bytes.insert(bytes.end(), {0xFF, 0x2F, 0x00});  // End of track
+
+    const std::size_t length = bytes.size() - trackStart - 8;
+    for (int i = 0; i < 4; i++) {
+        bytes[trackStart + 4 + i] = static_cast<std::uint8_t>(length >> (24 - 8 * i));
+    }
+    trackStart = 0;
+}
+
+void Writer::delta(std::uint32_t tick) {
+    // Deltas over 28 bits can't be encoded in 4 bytes: a larger gap is
+    // split with empty text events, so the later events keep their ticks
+    constexpr std::uint32_t MAX_DELTA = 0x0FFFFFFF;
+    while (tick - last > MAX_DELTA) {
+        bytes.insert(bytes.end(), {0xFF, 0xFF, 0xFF, 0x7F, 0xFF, 0x01, 0x00});
+        last += MAX_DELTA;
+        // Meta events cancel the running status
+        running = 0;
+    }
+    std::uint32_t value = tick - last;
+    last = tick;
+
+    std::uint8_t buffer[4];
+    int size = 0;
+    do {
+        buffer[size++] = value & 0x7F;
+        value >>= 7;
+    } while (value > 0);
+    while (size > 1) {
+        bytes.push_back(buffer[--size] | 0x80);
+    }
+    bytes.push_back(buffer[0]);
+}
+
+void Writer::event(std::uint32_t tick, std::uint8_t status, std::uint8_t data1, std::uint8_t data2) {
+    delta(std::max(tick, last));
+    if (status != running) {
+        bytes.push_back(status);
+        running = status;
+    }
+    bytes.push_back(data1 & 0x7F);
+    bytes.push_back(data2 & 0x7F);
+}
+
+// Write the note offs up to a tick
+void Writer::flush(std::uint32_t tick) {
+    while (!pending.empty() && pending.front().tick <= tick) {
+        const NoteOff off = pending.front();
+        std::pop_heap(pending.begin(), pending.end(), Later());
+        pending.pop_back();
+        event(off.tick, 0x90 | off.channel, off.key, 0);
+    }
+}
+
+void Writer::note(std::uint32_t tick, std::uint32_t duration, std::uint8_t key, std::uint8_t velocity,
+                  std::uint8_t channel) {
+    if (trackStart == 0) {
+        beginTrack();
+    }
+    flush(tick);
+    channel &= 0x0F;
+    event(tick, 0x90 | channel, key, std::max<std::uint8_t>(velocity & 0x7F, 1));
+
+    const std::uint32_t end = std::max(tick, last) + duration;
+    pending.push_back({end, channel, static_cast<std::uint8_t>(key & 0x7F)});
+    std::push_heap(pending.begin(), pending.end(), Later());
+}
+
+void Writer::chord(std::uint32_t tick, std::uint32_t duration, const voice_leading::Voicing& voicing,
+                   std::uint8_t velocity, std::uint8_t channel) {
+    for (std::size_t i = 0; i < voicing.size; i++) {
+        note(tick, duration, voicing.midi[i], velocity, channel);
+    }
+}
+
+void Writer::chord(std::uint32_t tick, std::uint32_t duration, const std::vector<std::string>& notes,
+                   std::uint8_t velocity, std::uint8_t channel) {
+    for (const std::string& name : notes) {
+        const std::optional<int> key = midi::toMidi(name);
+        if (key) {
+            note(tick, duration, static_cast<std::uint8_t>(*key), velocity, channel);
+        }
+    }
+}
+
+std::uint32_t Writer::progression(std::uint32_t tick, const voice_leading::Voicing* voicings, std::size_t count,
+                                  std::uint32_t duration, std::uint8_t velocity, std::uint8_t channel) {
+    for (std::size_t i = 0; i < count; i++) {
+        chord(tick, duration, voicings[i], velocity, channel);
+        tick += duration;
+    }
+    return tick;
+}
+
+void Writer::tempo(std::uint32_t tick, std::uint32_t microsecondsPerQuarter) {
+    if (trackStart == 0) {
+        beginTrack();
+    }
+    flush(tick);
+    delta(std::max(tick, last));
+    bytes.insert(bytes.end(), {0xFF, 0x51, 0x03, static_cast<std::uint8_t>(microsecondsPerQuarter >> 16),
+                               static_cast<std::uint8_t>(microsecondsPerQuarter >> 8),
+                               static_cast<std::uint8_t>(microsecondsPerQuarter)});
+    // Meta events cancel the running status
+    running = 0;
+}
+
+const std::vector<std::uint8_t>& Writer::finish() {
+    endTrack();
+    bytes[9] = tracks > 1 ? 1 : 0;
+    bytes[10] = static_cast<std::uint8_t>(tracks >> 8);
+    bytes[11] = static_cast<std::uint8_t>(tracks);
+    return bytes;
+}
+
+bool Writer::save(const std::string& path) {
+    finish();
+    std::ofstream out(path, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return static_cast<bool>(out);
+}
+
+bool saveProgression(const std::string& path, const std::vector<voice_leading::Voicing>& voicings,
+                     std::uint32_t duration) {
+    Writer writer;
+    writer.progression(0, voicings.data(), voicings.size(), duration);
+    return writer.save(path);
+}
+
+} // namespace smf
+} // namespace tonalcpp
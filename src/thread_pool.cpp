@@ -0,0 +1,120 @@
+#include "tonalcpp/thread_pool.h"
+#include <algorithm>
+
+namespace tonalcpp {
+namespace thread_pool {
+
+ThreadPool::ThreadPool(std::size_t threads) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (std::size_t i = 0; i < threads; i++) {
+        queues.push_back(std::make_unique<Queue>());
+    }
+    for (std::size_t i = 0; i < threads; i++) {
+        workers.emplace_back([this, i]() { work(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::parallelFor(std::size_t count, const ChunkFunction& function, std::size_t grain) {
+    if (count == 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> loop(loopMutex);
+
+    // Give each worker a contiguous share of the chunks
+    grain = std::max<std::size_t>(grain, 1);
+    const std::size_t chunks = (count + grain - 1) / grain;
+    const std::size_t threads = workers.size();
+    for (std::size_t w = 0; w < threads; w++) {
+        std::lock_guard<std::mutex> lock(queues[w]->mutex);
+        for (std::size_t c = chunks * w / threads; c < chunks * (w + 1) / threads; c++) {
+            queues[w]->chunks.emplace_back(c * grain, std::min(count, (c + 1) * grain));
+        }
+    }
+
+    std::unique_lock<std::mutex> lock(stateMutex);
+    body = &function;
+    error = nullptr;
+    running = threads;
+    generation++;
+    wake.notify_all();
+    finished.wait(lock, [this]() { return running == 0; });
+    body = nullptr;
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+bool ThreadPool::next(std::size_t worker, Chunk& chunk) {
+    // Own chunks in order
+    {
+        std::lock_guard<std::mutex> lock(queues[worker]->mutex);
+        auto& own = queues[worker]->chunks;
+        if (!own.empty()) {
+            chunk = own.front();
+            own.pop_front();
+            return true;
+        }
+    }
+
+    // Steal from the end of the other queues
+    for (std::size_t i = 1; i < queues.size(); i++) {
+        auto& victim = *queues[(worker + i) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.chunks.empty()) {
+            chunk = victim.chunks.back();
+            victim.chunks.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::work(std::size_t worker) {
+    std::size_t seen = 0;
+    for (;;) {
+        const ChunkFunction* function;
+        {
+            std::unique_lock<std::mutex> lock(stateMutex);
+            wake.wait(lock, [&]() { return stopping || generation != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+            function = body;
+        }
+
+        Chunk chunk;
+        while (next(worker, chunk)) {
+            try {
+                (*function)(chunk.first, chunk.second, worker);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(stateMutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(stateMutex);
+        if (--running == 0) {
+            finished.notify_all();
+        }
+    }
+}
+
+} // namespace thread_pool
+} // namespace tonalcpp
@@ -0,0 +1,299 @@
+#include "tonalcpp/tuning.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace tonalcpp {
+namespace tuning {
+
+// Read a whole file. Returns false if it can't be opened
+static bool readFile(const std::string& path, std::string& contents) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    std::ostringstream buffer;
+    buffer << file.rdbuf();
+    contents = buffer.str();
+    return true;
+}
+
+// Get the lines that are not comments (comments start with "!")
+static std::vector<std::string> dataLines(const std::string& text) {
+    std::vector<std::string> lines;
+    std::istringstream stream(text);
+    std::string line;
+    while (std::getline(stream, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (!line.empty() && line[0] == '!') {
+            continue;
+        }
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+// Get the first whitespace separated token of a line
+static std::string firstToken(const std::string& line) {
+    std::istringstream stream(line);
+    std::string token;
+    stream >> token;
+    return token;
+}
+
+// Parse an integer token. Returns false if it's not an integer
+static bool parseInt(const std::string& token, int& value) {
+    if (token.empty()) {
+        return false;
+    }
+    char* end;
+    const long v = std::strtol(token.c_str(), &end, 10);
+    if (*end != '\0') {
+        return false;
+    }
+    value = static_cast<int>(v);
+    return true;
+}
+
+// Parse a pitch: cents if it has a dot, a ratio (or integer) otherwise
+static bool parsePitch(const std::string& token, double& cents) {
+    if (token.empty()) {
+        return false;
+    }
+    char* end;
+    if (token.find('.') != std::string::npos) {
+        cents = std::strtod(token.c_str(), &end);
+        return *end == '\0';
+    }
+    const double num = std::strtod(token.c_str(), &end);
+    double den = 1.0;
+    if (*end == '/') {
+        den = std::strtod(end + 1, &end);
+    }
+    if (*end != '\0' || num <= 0.0 || den <= 0.0) {
+        return false;
+    }
+    cents = 1200.0 * std::log2(num / den);
+    return true;
+}
+
+ScalaScale parseScl(const std::string& text) {
+    const auto lines = dataLines(text);
+    ScalaScale scale;
+    if (lines.size() < 2) {
+        return scale;
+    }
+
+    int count;
+    if (!parseInt(firstToken(lines[1]), count) || count < 1 ||
+        lines.size() < static_cast<size_t>(count) + 2) {
+        return scale;
+    }
+
+    scale.description = lines[0];
+    scale.cents.reserve(count);
+    for (int i = 0; i < count; i++) {
+        double cents;
+        if (!parsePitch(firstToken(lines[i + 2]), cents)) {
+            return ScalaScale();
+        }
+        scale.cents.push_back(cents);
+    }
+
+    scale.empty = false;
+    return scale;
+}
+
+ScalaScale loadScl(const std::string& path) {
+    std::string contents;
+    return readFile(path, contents) ? parseScl(contents) : ScalaScale();
+}
+
+KeyboardMapping parseKbm(const std::string& text) {
+    const auto lines = dataLines(text);
+    KeyboardMapping kbm;
+    if (lines.size() < 7) {
+        return kbm;
+    }
+
+    char* end;
+    const std::string freqToken = firstToken(lines[5]);
+    kbm.referenceFreq = std::strtod(freqToken.c_str(), &end);
+
+    if (!parseInt(firstToken(lines[0]), kbm.size) || kbm.size < 0 ||
+        !parseInt(firstToken(lines[1]), kbm.firstMidi) ||
+        !parseInt(firstToken(lines[2]), kbm.lastMidi) ||
+        !parseInt(firstToken(lines[3]), kbm.middleNote) ||
+        !parseInt(firstToken(lines[4]), kbm.referenceNote) ||
+        freqToken.empty() || *end != '\0' || kbm.referenceFreq <= 0.0 ||
+        !parseInt(firstToken(lines[6]), kbm.octaveDegree)) {
+        return KeyboardMapping();
+    }
+
+    // Missing entries at the end of the mapping are unmapped keys
+    kbm.mapping.assign(kbm.size, -1);
+    for (int i = 0; i < kbm.size && static_cast<size_t>(i) + 7 < lines.size(); i++) {
+        const std::string token = firstToken(lines[i + 7]);
+        if (token == "x" || token.empty()) {
+            continue;
+        }
+        if (!parseInt(token, kbm.mapping[i])) {
+            return KeyboardMapping();
+        }
+    }
+
+    kbm.empty = false;
+    return kbm;
+}
+
+KeyboardMapping loadKbm(const std::string& path) {
+    std::string contents;
+    return readFile(path, contents) ? parseKbm(contents) : KeyboardMapping();
+}
+
+// Floored division and modulo
+static int floorDiv(int a, int b) {
+    return a / b - (a % b != 0 && (a < 0) != (b < 0) ? 1 : 0);
+}
+
+static int floorMod(int a, int b) {
+    return a - floorDiv(a, b) * b;
+}
+
+Tuning::Tuning() : isEmpty(false), table(440.0) {
+    for (int midi = 0; midi < 128; midi++) {
+        degrees[midi] = midi % 12;
+        sortedLog2.push_back(std::log2(table[midi]));
+        sortedMidi.push_back(midi);
+    }
+}
+
+Tuning::Tuning(const ScalaScale& scale, const KeyboardMapping& keyboard)
+    : isEmpty(true), table(std::array<double, 128>{}, 0.0) {
+    degrees.fill(-1);
+    if (scale.empty || scale.cents.empty()) {
+        return;
+    }
+
+    const int notes = static_cast<int>(scale.cents.size());
+    const double period = scale.cents.back();
+
+    // Linear mapping if none is given
+    KeyboardMapping kbm = keyboard;
+    if (kbm.empty || kbm.size == 0) {
+        const KeyboardMapping defaults;
+        if (kbm.empty) {
+            kbm = defaults;
+        }
+        kbm.size = notes;
+        kbm.octaveDegree = notes;
+        kbm.mapping.resize(notes);
+        for (int i = 0; i < notes; i++) {
+            kbm.mapping[i] = i;
+        }
+    }
+
+    // Pitch in cents of any (possibly negative or bigger than the scale) degree
+    auto degreeCents = [&](int degree) {
+        const int octave = floorDiv(degree, notes);
+        const int index = floorMod(degree, notes);
+        return octave * period + (index == 0 ? 0.0 : scale.cents[index - 1]);
+    };
+    const double octaveCents = degreeCents(kbm.octaveDegree == 0 ? notes : kbm.octaveDegree);
+
+    // Scale degree (relative to the middle note) of a key, or false if unmapped
+    auto keyDegree = [&](int key, int& degree, double& cents) {
+        const int offset = key - kbm.middleNote;
+        const int index = floorMod(offset, kbm.size);
+        const int repeat = floorDiv(offset, kbm.size);
+        const int mapped = kbm.mapping[index];
+        if (mapped < 0) {
+            return false;
+        }
+        degree = mapped;
+        cents = degreeCents(mapped) + repeat * octaveCents;
+        return true;
+    };
+
+    int referenceDegree;
+    double referenceCents;
+    if (!keyDegree(kbm.referenceNote, referenceDegree, referenceCents)) {
+        return;
+    }
+
+    std::array<double, 128> freqs{};
+    for (int midi = std::max(0, kbm.firstMidi); midi <= std::min(127, kbm.lastMidi); midi++) {
+        int degree;
+        double cents;
+        if (keyDegree(midi, degree, cents)) {
+            freqs[midi] = kbm.referenceFreq * std::pow(2.0, (cents - referenceCents) / 1200.0);
+            degrees[midi] = floorMod(degree, notes);
+        }
+    }
+
+    table = midi::TuningTable(freqs, kbm.referenceFreq);
+    isEmpty = false;
+
+    // Sort the mapped notes by pitch for the nearest lookups
+    for (int midi = 0; midi < 128; midi++) {
+        if (degrees[midi] >= 0) {
+            sortedMidi.push_back(midi);
+        }
+    }
+    std::stable_sort(sortedMidi.begin(), sortedMidi.end(),
+        [&](int a, int b) { return freqs[a] < freqs[b]; });
+    for (int midi : sortedMidi) {
+        sortedLog2.push_back(std::log2(freqs[midi]));
+    }
+}
+
+void Tuning::midiToFreq(const int* midi, std::size_t count, double* out) const {
+    for (std::size_t i = 0; i < count; i++) {
+        out[i] = table[midi[i]];
+    }
+}
+
+Nearest Tuning::freqToNearest(double freq) const {
+    if (!(freq > 0.0) || sortedLog2.empty()) {
+        return {-1, -1, 0.0};
+    }
+
+    // Binary search in the log domain (at most 7 steps for 128 notes)
+    const double target = std::log2(freq);
+    auto it = std::lower_bound(sortedLog2.begin(), sortedLog2.end(), target);
+    size_t index = static_cast<size_t>(it - sortedLog2.begin());
+    if (index == sortedLog2.size() ||
+        (index > 0 && target - sortedLog2[index - 1] < sortedLog2[index] - target)) {
+        index -= 1;
+    }
+
+    const int midi = sortedMidi[index];
+    return {midi, degrees[midi], (target - sortedLog2[index]) * 1200.0};
+}
+
+void Tuning::freqToNearest(const float* freqs, std::size_t count, int* midi, float* cents) const {
+    for (std::size_t i = 0; i < count; i++) {
+        const Nearest n = freqToNearest(freqs[i]);
+        midi[i] = n.midi;
+        cents[i] = static_cast<float>(n.cents);
+    }
+}
+
+Tuning load(const std::string& sclPath, const std::string& kbmPath) {
+    const ScalaScale scale = loadScl(sclPath);
+    if (kbmPath.empty()) {
+        return Tuning(scale);
+    }
+    const KeyboardMapping kbm = loadKbm(kbmPath);
+    if (kbm.empty) {
+        return Tuning(ScalaScale());
+    }
+    return Tuning(scale, kbm);
+}
+
+} // namespace tuning
+} // namespace tonalcpp
@@ -1,5 +1,6 @@
 #include "tonalcpp/voice_leading.h"
 #include "tonalcpp/note.h"
+#include "tonalcpp/pitch_note.h"
 #include <algorithm>
 #include <cmath>
 #include <limits>
@@ -26,18 +27,50 @@ std::vector<std::string> topNoteDiff(
         return midi.value_or(0);
     };
     
-    // Helper function to calculate difference between top notes
-    auto diff = [&](const std::vector<std::string>& voicing) -> int {
-        return std::abs(topNoteMidi(lastVoicing) - topNoteMidi(voicing));
-    };
-    
-    // Find the voicing with minimum difference
-    auto minVoicing = std::min_element(voicings.begin(), voicings.end(),
-        [&](const std::vector<std::string>& a, const std::vector<std::string>& b) {
-            return diff(a) < diff(b);
-        });
+    // Find the voicing with minimum difference (each voicing is parsed once)
+    const int lastTop = topNoteMidi(lastVoicing);
+    std::size_t best = 0;
+    int minDiff = std::numeric_limits<int>::max();
+    for (std::size_t i = 0; i < voicings.size(); i++) {
+        const int diff = std::abs(lastTop - topNoteMidi(voicings[i]));
+        if (diff < minDiff) {
+            minDiff = diff;
+            best = i;
+        }
+    }
     
-    return *minVoicing;
+    return voicings[best];
+}
+
+// Steps indexed by the position in the circle of fifths (F, C, G, D, A, E, B)
+static const std::array<int, 7> FIFTHS_TO_STEPS = {3, 0, 4, 1, 5, 2, 6};
+static const std::array<int, 7> STEP_SEMITONES = {0, 2, 4, 5, 7, 9, 11};
+
+static int floorMod(int n, int m) {
+    return ((n % m) + m) % m;
+}
+
+std::string Voicing::name(std::size_t i) const {
+    const int f = fifths[i];
+    const int step = FIFTHS_TO_STEPS[floorMod(f + 1, 7)];
+    const int alt = (f + 1 >= 0) ? (f + 1) / 7 : -((-(f + 1) + 6) / 7);
+    const int oct = (midi[i] - STEP_SEMITONES[step] - alt) / 12 - 1;
+    return pitch_note::pitchName(pitch::Pitch(step, alt, oct, std::nullopt));
+}
+
+std::vector<std::string> Voicing::names() const {
+    std::vector<std::string> result;
+    result.reserve(size);
+    for (std::size_t i = 0; i < size; i++) {
+        result.push_back(name(i));
+    }
+    return result;
+}
+
+bool Voicing::operator==(const Voicing& other) const {
+    return size == other.size &&
+        std::equal(midi.begin(), midi.begin() + size, other.midi.begin()) &&
+        std::equal(fifths.begin(), fifths.begin() + size, other.fifths.begin());
 }
 
 } // namespace voice_leading
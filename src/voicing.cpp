@@ -1,4 +1,5 @@
 #include "tonalcpp/voicing.h"
+#include "tonalcpp/instrumentation.h"
 #include "tonalcpp/chord.h"
 #include "tonalcpp/interval.h"
 #include "tonalcpp/note.h"
@@ -7,6 +8,7 @@
 #include "tonalcpp/voicing_dictionary.h"
 #include "tonalcpp/helpers.h"
 #include <algorithm>
+#include <unordered_map>
 
 namespace tonalcpp {
 namespace voicing {
@@ -38,80 +40,234 @@ std::vector<std::string> get(
     }
 }
 
-std::vector<std::vector<std::string>> search(
+static int floorMod(int n, int m) {
+    return ((n % m) + m) % m;
+}
+
+Voicing fromNames(const std::vector<std::string>& notes) {
+    Voicing voicing;
+    if (notes.size() > voicing_dictionary::MAX_VOICES) {
+        return voicing;
+    }
+    for (std::size_t i = 0; i < notes.size(); i++) {
+        const pitch_note::Note n = pitch_note::note(notes[i]);
+        if (n.empty || !n.midi.has_value()) {
+            return Voicing();
+        }
+        voicing.midi[i] = static_cast<std::uint8_t>(n.midi.value());
+        voicing.fifths[i] = static_cast<std::int8_t>(n.coord[0]);
+    }
+    voicing.size = static_cast<std::uint8_t>(notes.size());
+    return voicing;
+}
+
+void searchMidi(
+    int tonicFifths,
+    const voicing_dictionary::VoicingPattern* patterns,
+    std::size_t count,
+    const std::vector<int>& range,
+    std::vector<Voicing>& out
+) {
+    if (range.empty()) {
+        return;
+    }
+    const int top = range.back();
+    
+    for (std::size_t p = 0; p < count; p++) {
+        const auto& pattern = patterns[p];
+        if (pattern.size == 0) continue;
+        
+        const int bottomFifths = tonicFifths + pattern.bottomFifths;
+        // Chroma of a position in the circle of fifths
+        const int bottomChroma = floorMod(bottomFifths * 7, 12);
+        const int span = pattern.semitones[pattern.size - 1];
+        
+        Voicing voicing;
+        voicing.size = pattern.size;
+        for (std::size_t i = 0; i < pattern.size; i++) {
+            voicing.fifths[i] = static_cast<std::int8_t>(bottomFifths + pattern.fifths[i]);
+        }
+        
+        auto render = [&](int start) {
+            // Filter out start notes that will overshoot the top end of the range
+            if (start + span > top) return;
+            for (std::size_t i = 0; i < pattern.size; i++) {
+                voicing.midi[i] = static_cast<std::uint8_t>(start + pattern.semitones[i]);
+            }
+            out.push_back(voicing);
+        };
+        
+        // Walk the range segments in order (like range::numeric, the first
+        // note of each segment after the first one is not repeated)
+        if (range.size() == 1) {
+            if (floorMod(range[0], 12) == bottomChroma) render(range[0]);
+            continue;
+        }
+        for (std::size_t s = 1; s < range.size(); s++) {
+            const int from = range[s - 1];
+            const int to = range[s];
+            if (from <= to) {
+                const int first = s == 1 ? from : from + 1;
+                for (int m = first + floorMod(bottomChroma - first, 12); m <= to; m += 12) {
+                    render(m);
+                }
+            } else {
+                const int first = s == 1 ? from : from - 1;
+                for (int m = first - floorMod(first - bottomChroma, 12); m >= to; m -= 12) {
+                    render(m);
+                }
+            }
+        }
+    }
+}
+
+// Range ends as midi numbers. The top of the range must be a note name
+static bool rangeEnds(const std::vector<std::string>& range, std::vector<int>& ends) {
+    if (range.empty()) {
+        return false;
+    }
+    ends.reserve(range.size());
+    for (const auto& n : range) {
+        auto m = midi::toMidi(n);
+        if (!m.has_value()) {
+            return false;
+        }
+        ends.push_back(m.value());
+    }
+    return note::midi(range.back()).has_value();
+}
+
+std::vector<Voicing> searchMidi(
     const std::string& chord,
     const std::vector<std::string>& range,
     const voicing_dictionary::VoicingDictionary& dictionary
 ) {
+    TONAL_PROBE("voicing::searchMidi");
+    // The built-in dictionaries are compiled only once
+    if (const auto* compiled = voicing_dictionary::builtin(dictionary)) {
+        return searchMidi(chord, range, *compiled);
+    }
+    
     // Tokenize the chord to get tonic and symbol
     auto tokens = chord::tokenize(chord);
-    std::string tonic = tokens[0];
-    std::string symbol = tokens[1];
-    
-    if (tonic.empty()) {
+    const pitch_note::Note tonic = pitch_note::note(tokens[0]);
+    if (tonic.empty) {
         return {};
     }
     
     // Look up voicing patterns for this chord symbol
-    auto voicingPatterns = voicing_dictionary::lookup(symbol, dictionary);
+    auto voicingPatterns = voicing_dictionary::lookup(tokens[1], dictionary);
     if (!voicingPatterns.has_value()) {
         return {};
     }
     
-    // Convert interval pattern strings to vector of intervals
-    std::vector<std::vector<std::string>> voicings;
+    std::vector<voicing_dictionary::VoicingPattern> patterns;
+    patterns.reserve(voicingPatterns->size());
     for (const auto& pattern : voicingPatterns.value()) {
-        // Split the pattern string by spaces using helpers
-        auto intervals = helpers::split(pattern);
-        voicings.push_back(intervals);
+        patterns.push_back(voicing_dictionary::compilePattern(pattern));
     }
     
-    // Get all notes in the specified range
-    auto notesInRange = range::chromatic(range);
+    std::vector<int> ends;
+    if (!rangeEnds(range, ends)) {
+        return {};
+    }
     
+    std::vector<Voicing> result;
+    searchMidi(tonic.coord[0], patterns.data(), patterns.size(), ends, result);
+    return result;
+}
+
+// Append the voicings of a chord found in a compiled dictionary
+static void searchCompiled(
+    const std::string& chord,
+    const std::vector<std::string>& range,
+    const voicing_dictionary::CompiledDictionary& dictionary,
+    std::vector<int>& ends,
+    std::vector<Voicing>& out
+) {
+    auto tokens = chord::tokenize(chord);
+    const pitch_note::Note tonic = pitch_note::note(tokens[0]);
+    if (tonic.empty) {
+        return;
+    }
+    
+    const voicing_dictionary::Patterns patterns = dictionary.find(tokens[1]);
+    if (patterns.empty()) {
+        return;
+    }
+    
+    ends.clear();
+    if (!rangeEnds(range, ends)) {
+        return;
+    }
+    
+    searchMidi(tonic.coord[0], patterns.begin(), patterns.size(), ends, out);
+}
+
+std::vector<Voicing> searchMidi(
+    const std::string& chord,
+    const std::vector<std::string>& range,
+    const voicing_dictionary::CompiledDictionary& dictionary
+) {
+    TONAL_PROBE("voicing::searchMidi compiled");
+    std::vector<int> ends;
+    std::vector<Voicing> result;
+    searchCompiled(chord, range, dictionary, ends, result);
+    return result;
+}
+
+// Get the note names of the voicings
+static std::vector<std::vector<std::string>> names(const std::vector<Voicing>& voicings) {
     std::vector<std::vector<std::string>> result;
+    result.reserve(voicings.size());
+    for (const auto& voicing : voicings) {
+        result.push_back(voicing.names());
+    }
+    return result;
+}
+
+std::vector<std::vector<std::string>> search(
+    const std::string& chord,
+    const std::vector<std::string>& range,
+    const voicing_dictionary::VoicingDictionary& dictionary
+) {
+    return names(searchMidi(chord, range, dictionary));
+}
+
+std::vector<std::vector<std::string>> search(
+    const std::string& chord,
+    const std::vector<std::string>& range,
+    const voicing_dictionary::CompiledDictionary& dictionary
+) {
+    return names(searchMidi(chord, range, dictionary));
+}
+
+std::pmr::vector<std::pmr::vector<std::pmr::string>> search(
+    std::pmr::memory_resource* resource,
+    const std::string& chord,
+    const std::vector<std::string>& range,
+    const voicing_dictionary::VoicingDictionary& dictionary
+) {
+    // Scratch buffers reused by the calls of each thread, so only the
+    // result is allocated (from the resource)
+    thread_local std::vector<int> ends;
+    thread_local std::vector<Voicing> voicings;
+    voicings.clear();
+    if (const auto* compiled = voicing_dictionary::builtin(dictionary)) {
+        searchCompiled(chord, range, *compiled, ends, voicings);
+    } else {
+        voicings = searchMidi(chord, range, dictionary);
+    }
     
+    std::pmr::vector<std::pmr::vector<std::pmr::string>> result(resource);
+    result.reserve(voicings.size());
     for (const auto& voicing : voicings) {
-        if (voicing.empty()) continue;
-        
-        // Transpose intervals relative to first interval (e.g. 3m 5P > 1P 3M)
-        std::vector<std::string> relativeIntervals;
-        for (const auto& intervalStr : voicing) {
-            auto subtracted = interval::subtract(intervalStr, voicing[0]);
-            relativeIntervals.push_back(subtracted);
-        }
-        
-        // Get enharmonic correct pitch class for the bottom note
-        std::string bottomPitchClass = note::transpose(tonic, voicing[0]);
-        
-        // Get all possible start notes for voicing
-        std::vector<std::string> starts;
-        for (const auto& noteInRange : notesInRange) {
-            // Only get notes that match the bottom pitch class
-            if (note::chroma(noteInRange) == note::chroma(bottomPitchClass)) {
-                // Filter out start notes that will overshoot the top end of the range
-                std::string topNote = note::transpose(noteInRange, relativeIntervals.back());
-                auto topMidi = note::midi(topNote);
-                auto rangeMidi = note::midi(range.back());
-                
-                if (topMidi.has_value() && rangeMidi.has_value() && 
-                    topMidi.value() <= rangeMidi.value()) {
-                    // Replace Range.chromatic notes with the correct enharmonic equivalents
-                    starts.push_back(note::enharmonic(noteInRange, bottomPitchClass));
-                }
-            }
-        }
-        
-        // Render one voicing for each start note
-        for (const auto& start : starts) {
-            std::vector<std::string> notes;
-            for (const auto& relativeInterval : relativeIntervals) {
-                notes.push_back(note::transpose(start, relativeInterval));
-            }
-            result.push_back(notes);
+        auto& notes = result.emplace_back();
+        notes.reserve(voicing.size);
+        for (std::size_t i = 0; i < voicing.size; i++) {
+            notes.emplace_back(voicing.name(i));
         }
     }
-    
     return result;
 }
 
@@ -122,6 +278,7 @@ std::vector<std::vector<std::string>> sequence(
     const voice_leading::VoiceLeadingFunction& voiceLeading,
     const std::vector<std::string>& lastVoicing
 ) {
+    TONAL_PROBE("voicing::sequence");
     std::vector<std::vector<std::string>> voicings;
     std::vector<std::string> currentLastVoicing = lastVoicing;
     
@@ -134,5 +291,143 @@ std::vector<std::vector<std::string>> sequence(
     return voicings;
 }
 
+std::vector<std::size_t> sequenceOptimal(
+    const std::vector<std::vector<Voicing>>& candidates,
+    const SequenceWeights& weights,
+    const Voicing& lastVoicing
+) {
+    const auto metric = voice_leading::sum(
+        voice_leading::weighted<voice_leading::TopNote>(weights.topNote),
+        voice_leading::weighted<voice_leading::TotalMotion>(weights.motion),
+        voice_leading::weighted<voice_leading::LostCommonTones>(weights.commonTones));
+    return sequenceOptimal(candidates, metric, lastVoicing);
+}
+
+std::vector<std::size_t> sequenceOptimal(
+    const std::vector<std::vector<Voicing>>& candidates,
+    const TransitionCost& cost,
+    const Voicing& lastVoicing
+) {
+    return sequenceOptimal<TransitionCost>(candidates, cost, lastVoicing);
+}
+
+std::vector<std::vector<std::string>> sequenceOptimal(
+    const std::vector<std::string>& chords,
+    const std::vector<std::string>& range,
+    const voicing_dictionary::VoicingDictionary& dictionary,
+    const SequenceWeights& weights,
+    const std::vector<std::string>& lastVoicing
+) {
+    std::vector<std::vector<Voicing>> candidates;
+    candidates.reserve(chords.size());
+    for (const auto& chord : chords) {
+        candidates.push_back(searchMidi(chord, range, dictionary));
+    }
+    
+    const auto chosen = sequenceOptimal(candidates, weights, fromNames(lastVoicing));
+    
+    std::vector<std::vector<std::string>> result;
+    result.reserve(chords.size());
+    for (std::size_t i = 0; i < chords.size(); i++) {
+        result.push_back(chosen[i] == NO_VOICING
+            ? std::vector<std::string>()
+            : candidates[i][chosen[i]].names());
+    }
+    return result;
+}
+
+std::vector<std::vector<std::string>> VoicedProgressions::names(std::size_t i) const {
+    std::vector<std::vector<std::string>> result;
+    result.reserve(offsets[i + 1] - offsets[i]);
+    for (const Voicing* v = begin(i); v != end(i); v++) {
+        result.push_back(v->names());
+    }
+    return result;
+}
+
+// Scratch data of a batch worker, reused across its progressions
+struct BatchArena {
+    // Candidates of each chord name seen by this worker
+    std::unordered_map<std::string, std::vector<Voicing>> candidates;
+    std::vector<std::vector<Voicing>> progression;
+};
+
+// Run a batch: each progression writes its voicings to its own slice of
+// the result, so the output is the same with any number of threads
+template<typename Voice>
+static VoicedProgressions runBatch(
+    const std::vector<std::string>* progressions,
+    std::size_t count,
+    const std::vector<std::string>& range,
+    const voicing_dictionary::CompiledDictionary& dictionary,
+    thread_pool::ThreadPool& pool,
+    const Voice& voice
+) {
+    VoicedProgressions result;
+    result.offsets.resize(count + 1, 0);
+    for (std::size_t i = 0; i < count; i++) {
+        result.offsets[i + 1] = result.offsets[i] + progressions[i].size();
+    }
+    result.voicings.resize(result.offsets[count]);
+    
+    std::vector<BatchArena> arenas(pool.size());
+    pool.parallelFor(count, [&](std::size_t begin, std::size_t end, std::size_t worker) {
+        BatchArena& arena = arenas[worker];
+        for (std::size_t i = begin; i < end; i++) {
+            const auto& chords = progressions[i];
+            arena.progression.resize(chords.size());
+            for (std::size_t c = 0; c < chords.size(); c++) {
+                auto found = arena.candidates.find(chords[c]);
+                if (found == arena.candidates.end()) {
+                    found = arena.candidates.emplace(
+                        chords[c], searchMidi(chords[c], range, dictionary)).first;
+                }
+                arena.progression[c] = found->second;
+            }
+            voice(arena.progression, result.voicings.data() + result.offsets[i]);
+        }
+    }, 4);
+    
+    return result;
+}
+
+VoicedProgressions sequenceBatch(
+    const std::vector<std::string>* progressions,
+    std::size_t count,
+    const std::vector<std::string>& range,
+    const voicing_dictionary::CompiledDictionary& dictionary,
+    thread_pool::ThreadPool& pool
+) {
+    // Greedy: closest top note to the previous voicing
+    auto voice = [](const std::vector<std::vector<Voicing>>& candidates, Voicing* out) {
+        Voicing last;
+        for (std::size_t c = 0; c < candidates.size(); c++) {
+            const auto& options = candidates[c];
+            const std::size_t chosen = voice_leading::best<voice_leading::TopNote>(
+                last, options.data(), options.size());
+            last = chosen < options.size() ? options[chosen] : Voicing();
+            out[c] = last;
+        }
+    };
+    return runBatch(progressions, count, range, dictionary, pool, voice);
+}
+
+VoicedProgressions sequenceOptimalBatch(
+    const std::vector<std::string>* progressions,
+    std::size_t count,
+    const std::vector<std::string>& range,
+    const voicing_dictionary::CompiledDictionary& dictionary,
+    thread_pool::ThreadPool& pool,
+    const SequenceWeights& weights
+) {
+    auto voice = [&](const std::vector<std::vector<Voicing>>& candidates, Voicing* out) {
+        const auto chosen = sequenceOptimal(candidates, weights);
+        for (std::size_t c = 0; c < candidates.size(); c++) {
+            out[c] = chosen[c] == NO_VOICING ? Voicing() : candidates[c][chosen[c]];
+        }
+    };
+    return runBatch(progressions, count, range, dictionary, pool, voice);
+}
+
 } // namespace voicing
 } // namespace tonalcpp
\ No newline at end of file
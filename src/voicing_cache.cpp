@@ -0,0 +1,205 @@
+#include "tonalcpp/voicing_cache.h"
+#include "tonalcpp/chord.h"
+#include "tonalcpp/midi.h"
+#include "tonalcpp/note.h"
+#include "tonalcpp/pitch_note.h"
+
+namespace tonalcpp {
+namespace voicing_cache {
+
+// The candidates of chords without voicings
+static const Candidates& noCandidates() {
+    static const Candidates empty = std::make_shared<const std::vector<voicing::Voicing>>();
+    return empty;
+}
+
+std::size_t VoicingCache::KeyHash::operator()(const Key& key) const {
+    std::size_t hash = std::hash<std::uint64_t>()(key.dictionary);
+    for (int value : {key.entry, key.tonicFifths, key.low, key.high}) {
+        hash ^= std::hash<int>()(value) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+}
+
+VoicingCache::VoicingCache(std::size_t capacity) : capacity(capacity) {
+    counters.capacity = capacity;
+}
+
+Candidates VoicingCache::searchMidi(
+    const std::string& chord,
+    const std::vector<std::string>& range,
+    const voicing_dictionary::CompiledDictionary& dictionary
+) {
+    // Only ranges with two ends are cached
+    if (range.size() != 2) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            counters.misses++;
+        }
+        return std::make_shared<const std::vector<voicing::Voicing>>(
+            voicing::searchMidi(chord, range, dictionary));
+    }
+    
+    const auto tokens = chord::tokenize(chord);
+    const pitch_note::Note tonic = pitch_note::note(tokens[0]);
+    const int entry = tonic.empty ? -1 : dictionary.indexOf(tokens[1]);
+    const auto low = midi::toMidi(range[0]);
+    const auto high = midi::toMidi(range[1]);
+    if (entry < 0 || !low.has_value() || !high.has_value() || !note::midi(range[1]).has_value()) {
+        std::lock_guard<std::mutex> lock(mutex);
+        counters.misses++;
+        return noCandidates();
+    }
+    
+    const Key key = {dictionary.id(), entry, tonic.coord[0], low.value(), high.value()};
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = positions.find(key);
+        if (it != positions.end()) {
+            counters.hits++;
+            entries.splice(entries.begin(), entries, it->second);
+            return it->second->second;
+        }
+        counters.misses++;
+    }
+    
+    // Search without holding the lock
+    const voicing_dictionary::Patterns patterns = dictionary.at(static_cast<std::size_t>(entry));
+    auto voicings = std::make_shared<std::vector<voicing::Voicing>>();
+    voicing::searchMidi(tonic.coord[0], patterns.begin(), patterns.size(),
+                        {low.value(), high.value()}, *voicings);
+    Candidates candidates = std::move(voicings);
+    
+    std::lock_guard<std::mutex> lock(mutex);
+    if (capacity == 0) {
+        return candidates;
+    }
+    auto it = positions.find(key);
+    if (it != positions.end()) {
+        // Another thread got here first
+        return it->second->second;
+    }
+    entries.emplace_front(key, candidates);
+    positions[key] = entries.begin();
+    cachedCounts[key.dictionary]++;
+    if (entries.size() > capacity) {
+        const std::uint64_t evicted = entries.back().first.dictionary;
+        positions.erase(entries.back().first);
+        entries.pop_back();
+        counters.evictions++;
+        // The compiled copy of a dictionary goes with its last candidates
+        auto count = cachedCounts.find(evicted);
+        if (--count->second == 0) {
+            cachedCounts.erase(count);
+            removeCompiled(evicted);
+        }
+    }
+    return candidates;
+}
+
+Candidates VoicingCache::searchMidi(
+    const std::string& chord,
+    const std::vector<std::string>& range,
+    const voicing_dictionary::VoicingDictionary& dictionary
+) {
+    if (const auto* builtin = voicing_dictionary::builtin(dictionary)) {
+        return searchMidi(chord, range, *builtin);
+    }
+    const auto compiledDictionary = compile(dictionary);
+    return searchMidi(chord, range, *compiledDictionary);
+}
+
+std::shared_ptr<const voicing_dictionary::CompiledDictionary> VoicingCache::compile(
+    const voicing_dictionary::VoicingDictionary& dictionary
+) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = compiled.find(&dictionary);
+        if (it != compiled.end() && it->second.size == dictionary.size()) {
+            return it->second.dictionary;
+        }
+    }
+    
+    auto result = std::make_shared<const voicing_dictionary::CompiledDictionary>(dictionary);
+    std::lock_guard<std::mutex> lock(mutex);
+    // Keep only the compiled copies with cached candidates, so there are
+    // never more copies than candidate lists
+    for (auto it = compiled.begin(); it != compiled.end();) {
+        if (it->first != &dictionary && cachedCounts.count(it->second.dictionary->id()) == 0) {
+            it = compiled.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    CompiledCopy& current = compiled[&dictionary];
+    if (current.dictionary && current.size == dictionary.size()) {
+        // Another thread got here first
+        return current.dictionary;
+    }
+    if (current.dictionary) {
+        // The dictionary changed size: its candidates are stale
+        removeDictionary(current.dictionary->id());
+    }
+    current = {dictionary.size(), result};
+    return result;
+}
+
+void VoicingCache::removeDictionary(std::uint64_t id) {
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (it->first.dictionary == id) {
+            positions.erase(it->first);
+            it = entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    cachedCounts.erase(id);
+}
+
+void VoicingCache::removeCompiled(std::uint64_t id) {
+    for (auto it = compiled.begin(); it != compiled.end(); ++it) {
+        if (it->second.dictionary->id() == id) {
+            compiled.erase(it);
+            return;
+        }
+    }
+}
+
+void VoicingCache::invalidate(const voicing_dictionary::VoicingDictionary& dictionary) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = compiled.find(&dictionary);
+    if (it != compiled.end()) {
+        removeDictionary(it->second.dictionary->id());
+        compiled.erase(it);
+    }
+}
+
+void VoicingCache::invalidate(const voicing_dictionary::CompiledDictionary& dictionary) {
+    std::lock_guard<std::mutex> lock(mutex);
+    removeDictionary(dictionary.id());
+}
+
+void VoicingCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    positions.clear();
+    cachedCounts.clear();
+    compiled.clear();
+}
+
+Stats VoicingCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    Stats result = counters;
+    result.size = entries.size();
+    return result;
+}
+
+void VoicingCache::resetStats() {
+    std::lock_guard<std::mutex> lock(mutex);
+    counters.hits = 0;
+    counters.misses = 0;
+    counters.evictions = 0;
+}
+
+} // namespace voicing_cache
+} // namespace tonalcpp
@@ -1,6 +1,14 @@
 #include "tonalcpp/voicing_dictionary.h"
 #include "tonalcpp/chord.h"
+#include "tonalcpp/chord_type.h"
+#include "tonalcpp/helpers.h"
+#include "tonalcpp/pitch_interval.h"
 #include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <mutex>
+#include <shared_mutex>
+#include <sstream>
 
 namespace tonalcpp {
 namespace voicing_dictionary {
@@ -29,27 +37,17 @@ const VoicingDictionary lefthand = {
     {"m6", {"3m 5P 6M 9M", "6M 9M 10m 12P"}}
 };
 
+// Merge two dictionaries (entries of the second one win)
+static VoicingDictionary merge(const VoicingDictionary& a, const VoicingDictionary& b) {
+    VoicingDictionary result = a;
+    for (const auto& entry : b) {
+        result[entry.first] = entry.second;
+    }
+    return result;
+}
+
 // Combined triads and left-hand voicings
-const VoicingDictionary all = {
-    // Triads
-    {"M", {"1P 3M 5P", "3M 5P 8P", "5P 8P 10M"}},
-    {"m", {"1P 3m 5P", "3m 5P 8P", "5P 8P 10m"}},
-    {"o", {"1P 3m 5d", "3m 5d 8P", "5d 8P 10m"}},
-    {"aug", {"1P 3m 5A", "3m 5A 8P", "5A 8P 10m"}},
-    // Left-hand voicings
-    {"m7", {"3m 5P 7m 9M", "7m 9M 10m 12P"}},
-    {"7", {"3M 6M 7m 9M", "7m 9M 10M 13M"}},
-    {"^7", {"3M 5P 7M 9M", "7M 9M 10M 12P"}},
-    {"69", {"3M 5P 6A 9M"}},
-    {"m7b5", {"3m 5d 7m 8P", "7m 8P 10m 12d"}},
-    {"7b9", {"3M 6m 7m 9m", "7m 9m 10M 13m"}}, // b9 / b13
-    {"7b13", {"3M 6m 7m 9m", "7m 9m 10M 13m"}}, // b9 / b13
-    {"o7", {"1P 3m 5d 6M", "5d 6M 8P 10m"}},
-    {"7#11", {"7m 9M 11A 13A"}},
-    {"7#9", {"3M 7m 9A"}},
-    {"mM7", {"3m 5P 7M 9M", "7M 9M 10m 12P"}},
-    {"m6", {"3m 5P 6M 9M", "6M 9M 10m 12P"}}
-};
+const VoicingDictionary all = merge(triads, lefthand);
 
 // Default dictionary reference
 const VoicingDictionary& defaultDictionary = lefthand;
@@ -58,6 +56,15 @@ std::optional<std::vector<std::string>> lookup(
     const std::string& symbol,
     const VoicingDictionary& dictionary
 ) {
+    // The built-in dictionaries have all the symbols resolved
+    if (const auto* compiled = builtin(dictionary)) {
+        const int index = compiled->indexOf(symbol);
+        if (index < 0) {
+            return std::nullopt;
+        }
+        return dictionary.at(compiled->symbols()[static_cast<std::size_t>(index)]);
+    }
+    
     // Direct lookup first
     auto it = dictionary.find(symbol);
     if (it != dictionary.end()) {
@@ -88,5 +95,229 @@ std::optional<std::vector<std::string>> lookup(
     return std::nullopt;
 }
 
+// Cache for compiled patterns
+static std::unordered_map<std::string, VoicingPattern> patternCache;
+static std::shared_mutex patternCacheMutex;
+
+VoicingPattern compilePattern(const std::string& pattern) {
+    {
+        std::shared_lock<std::shared_mutex> lock(patternCacheMutex);
+        auto cached = patternCache.find(pattern);
+        if (cached != patternCache.end()) {
+            return cached->second;
+        }
+    }
+    
+    VoicingPattern compiled;
+    const auto names = helpers::split(pattern);
+    if (!names.empty() && names.size() <= MAX_VOICES) {
+        std::vector<pitch_interval::Interval> intervals;
+        for (const auto& name : names) {
+            intervals.push_back(pitch_interval::interval(name));
+        }
+        
+        const bool valid = std::none_of(intervals.begin(), intervals.end(),
+            [](const pitch_interval::Interval& i) { return i.empty; });
+        
+        if (valid) {
+            const auto& bottom = intervals[0];
+            compiled.size = static_cast<std::uint8_t>(intervals.size());
+            compiled.bottomSemitones = bottom.semitones;
+            compiled.bottomFifths = bottom.coord[0];
+            
+            for (size_t i = 0; i < intervals.size(); i++) {
+                const auto& ivl = intervals[i];
+                compiled.semitones[i] = static_cast<std::int8_t>(ivl.semitones - bottom.semitones);
+                compiled.fifths[i] = static_cast<std::int8_t>(ivl.coord[0] - compiled.bottomFifths);
+            }
+        }
+    }
+    
+    std::unique_lock<std::shared_mutex> lock(patternCacheMutex);
+    patternCache[pattern] = compiled;
+    return compiled;
+}
+
+// Source of the compiled dictionary ids (0 is the empty dictionary)
+static std::atomic<std::uint64_t> lastDictionaryId{0};
+
+CompiledDictionary::CompiledDictionary(const VoicingDictionary& dictionary)
+    : dictionaryId(++lastDictionaryId) {
+    offsets.push_back(0);
+    
+    // Position of the symbol in the aliases of its chord type. When several
+    // symbols have the same chord type, the one that lookup would find first
+    // (the first alias) is used for the chord type id
+    std::unordered_map<int, std::size_t> aliasRank;
+    
+    for (const auto& entry : dictionary) {
+        const auto& symbol = entry.first;
+        const auto i = static_cast<std::uint32_t>(entrySymbols.size());
+        entrySymbols.push_back(symbol);
+        bySymbol[symbol] = i;
+        
+        for (const auto& source : entry.second) {
+            const VoicingPattern pattern = compilePattern(source);
+            if (pattern.size == 0) continue;
+            patterns.push_back(pattern);
+            sources.push_back(source);
+        }
+        offsets.push_back(static_cast<std::uint32_t>(patterns.size()));
+        
+        const chord_type::ChordType type = chord_type::getChordType(symbol);
+        if (type.empty) continue;
+        const auto rank = static_cast<std::size_t>(
+            std::find(type.aliases.begin(), type.aliases.end(), symbol) - type.aliases.begin());
+        auto ranked = aliasRank.find(type.setNum);
+        if (ranked == aliasRank.end() || rank < ranked->second) {
+            aliasRank[type.setNum] = rank;
+            byChordType[type.setNum] = i;
+        }
+    }
+    
+    // Resolve every known symbol once
+    std::vector<std::string> known = entrySymbols;
+    known.push_back("");
+    for (const auto& type : chord_type::all()) {
+        known.push_back(type.name);
+        known.insert(known.end(), type.aliases.begin(), type.aliases.end());
+    }
+    for (const auto& symbol : known) {
+        if (resolved.count(symbol)) continue;
+        const int index = resolve(symbol);
+        if (index >= 0) {
+            resolved.emplace(symbol, static_cast<std::uint32_t>(index));
+        }
+    }
+}
+
+Patterns CompiledDictionary::entry(std::uint32_t i) const {
+    return {patterns.data() + offsets[i], patterns.data() + offsets[i + 1]};
+}
+
+// Resolve a symbol the same way lookup does (slow: parses the chord)
+int CompiledDictionary::resolve(const std::string& symbol) const {
+    // Direct lookup first
+    auto it = bySymbol.find(symbol);
+    if (it != bySymbol.end()) {
+        return static_cast<int>(it->second);
+    }
+    
+    // Try to find using chord aliases (same order as lookup)
+    chord::Chord chordInfo = chord::get("C" + symbol);
+    for (const auto& alias : chordInfo.aliases) {
+        auto aliasIt = bySymbol.find(alias);
+        if (aliasIt != bySymbol.end()) {
+            return static_cast<int>(aliasIt->second);
+        }
+    }
+    
+    // Empty string resolves to major chord
+    if (symbol.empty()) {
+        auto majorIt = bySymbol.find("M");
+        if (majorIt != bySymbol.end()) {
+            return static_cast<int>(majorIt->second);
+        }
+    }
+    
+    return -1;
+}
+
+int CompiledDictionary::indexOf(const std::string& symbol) const {
+    auto it = resolved.find(symbol);
+    return it != resolved.end() ? static_cast<int>(it->second) : resolve(symbol);
+}
+
+void CompiledDictionary::indexOf(const std::string* symbols, std::size_t count, int* out) const {
+    for (std::size_t i = 0; i < count; i++) {
+        out[i] = indexOf(symbols[i]);
+    }
+}
+
+Patterns CompiledDictionary::find(const std::string& symbol) const {
+    const int index = indexOf(symbol);
+    return index >= 0 ? entry(static_cast<std::uint32_t>(index)) : Patterns();
+}
+
+Patterns CompiledDictionary::find(int chordTypeId) const {
+    auto it = byChordType.find(chordTypeId);
+    return it != byChordType.end() ? entry(it->second) : Patterns();
+}
+
+VoicingDictionary CompiledDictionary::toDictionary() const {
+    VoicingDictionary result;
+    for (std::uint32_t i = 0; i < entrySymbols.size(); i++) {
+        result[entrySymbols[i]] = std::vector<std::string>(
+            sources.begin() + offsets[i], sources.begin() + offsets[i + 1]);
+    }
+    return result;
+}
+
+const CompiledDictionary* builtin(const VoicingDictionary& dictionary) {
+    if (&dictionary == &triads) {
+        static const CompiledDictionary compiled(triads);
+        return &compiled;
+    }
+    if (&dictionary == &lefthand) {
+        static const CompiledDictionary compiled(lefthand);
+        return &compiled;
+    }
+    if (&dictionary == &all) {
+        static const CompiledDictionary compiled(all);
+        return &compiled;
+    }
+    return nullptr;
+}
+
+// Remove leading and trailing whitespace
+static std::string trim(const std::string& str) {
+    const auto first = str.find_first_not_of(" \t\r");
+    if (first == std::string::npos) {
+        return "";
+    }
+    const auto last = str.find_last_not_of(" \t\r");
+    return str.substr(first, last - first + 1);
+}
+
+CompiledDictionary parseDictionary(const std::string& text) {
+    VoicingDictionary dictionary;
+    std::istringstream stream(text);
+    std::string line;
+    while (std::getline(stream, line)) {
+        line = trim(line);
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        
+        const auto equals = line.find('=');
+        if (equals == std::string::npos) {
+            return CompiledDictionary();
+        }
+        
+        std::vector<std::string> patterns;
+        std::istringstream patternStream(line.substr(equals + 1));
+        std::string pattern;
+        while (std::getline(patternStream, pattern, '|')) {
+            pattern = trim(pattern);
+            if (compilePattern(pattern).size == 0) {
+                return CompiledDictionary();
+            }
+            patterns.push_back(pattern);
+        }
+        dictionary[trim(line.substr(0, equals))] = patterns;
+    }
+    return CompiledDictionary(dictionary);
+}
+
+CompiledDictionary loadDictionary(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return CompiledDictionary();
+    }
+    std::ostringstream buffer;
+    buffer << file.rdbuf();
+    return parseDictionary(buffer.str());
+}
+
 } // namespace voicing_dictionary
 } // namespace tonalcpp
\ No newline at end of file
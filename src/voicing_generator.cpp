@@ -0,0 +1,192 @@
+#include "tonalcpp/voicing_generator.h"
+#include "tonalcpp/chord.h"
+#include "tonalcpp/chord_type.h"
+#include "tonalcpp/midi.h"
+#include "tonalcpp/pitch_interval.h"
+#include "tonalcpp/pitch_note.h"
+#include <algorithm>
+#include <array>
+#include <bitset>
+
+namespace tonalcpp {
+namespace voicing_generator {
+
+using voicing::Voicing;
+
+namespace {
+
+// Depth first enumeration of the voicings, from the bottom note up.
+// Pitch classes are handled as 12 bit masks.
+struct Generator {
+    const Constraints& constraints;
+    std::array<int, 12> spelling{};  // Fifths of each pitch class of the chord
+    unsigned chordMask = 0;          // Pitch classes of the chord
+    unsigned requiredMask = 0;       // Pitch classes that must be present
+    unsigned tensionMask = 0;        // Pitch classes of the tensions
+    std::vector<int> notes;          // Chord notes of the range, ascending
+    std::vector<int> bottoms;        // Possible bottom notes, ascending
+    int maxVoices = 0;
+
+    Voicing current;
+    std::vector<Voicing> result;
+    std::vector<int> spans;          // Span of each result (only with a limit)
+
+    explicit Generator(const Constraints& c) : constraints(c) {}
+
+    static int missing(unsigned mask) {
+        return static_cast<int>(std::bitset<12>(mask).count());
+    }
+
+    int span() const {
+        return current.top() - current.bass();
+    }
+
+    // Whether the limit is reached and nothing as wide as `span` can get in
+    bool full(int width) const {
+        return constraints.limit != 0 && result.size() == constraints.limit && width >= spans.back();
+    }
+
+    void emit() {
+        if (constraints.limit == 0) {
+            result.push_back(current);
+            return;
+        }
+        const int width = span();
+        if (full(width)) return;
+        // After the voicings with the same span (they were found first)
+        const auto at = std::upper_bound(spans.begin(), spans.end(), width) - spans.begin();
+        spans.insert(spans.begin() + at, width);
+        result.insert(result.begin() + at, current);
+        if (result.size() > constraints.limit) {
+            spans.pop_back();
+            result.pop_back();
+        }
+    }
+
+    void push(int note) {
+        current.midi[current.size] = static_cast<std::uint8_t>(note);
+        current.fifths[current.size] = static_cast<std::int8_t>(spelling[note % 12]);
+        current.size++;
+    }
+
+    void extend(std::size_t next, unsigned mask, unsigned tensions) {
+        const int size = current.size;
+        if (size >= constraints.minVoices && (mask & requiredMask) == requiredMask) {
+            emit();
+        }
+        if (size == maxVoices) return;
+
+        const int bottom = current.bass();
+        const int last = current.top();
+        for (std::size_t i = next; i < notes.size(); i++) {
+            const int note = notes[i];
+            const int width = note - bottom;
+            // Notes are ascending: the next ones are even wider
+            if (width > constraints.maxSpan || full(width)) break;
+            if (last < constraints.lowRegister && note - last < constraints.minLowInterval) continue;
+
+            const unsigned bit = 1u << (note % 12);
+            if ((bit & tensionMask) && (tensions & bit) && !constraints.doubleTensions) continue;
+
+            // Enough voices left for the required notes still missing
+            const unsigned newMask = mask | bit;
+            if (missing(requiredMask & ~newMask) > maxVoices - size - 1) continue;
+
+            push(note);
+            extend(i + 1, newMask, tensions | (bit & tensionMask));
+            current.size--;
+        }
+    }
+
+    void run() {
+        for (int bottom : bottoms) {
+            const unsigned bit = (1u << (bottom % 12)) & chordMask;
+            if (missing(requiredMask & ~bit) > maxVoices - 1) continue;
+            if (full(0)) break;
+            current.size = 0;
+            push(bottom);
+            const auto next = std::upper_bound(notes.begin(), notes.end(), bottom) - notes.begin();
+            extend(static_cast<std::size_t>(next), bit, bit & tensionMask);
+        }
+    }
+};
+
+} // namespace
+
+std::vector<Voicing> generateMidi(
+    const std::string& chord,
+    const std::vector<std::string>& range,
+    const Constraints& constraints
+) {
+    const auto tokens = chord::tokenize(chord);
+    const pitch_note::Note tonic = pitch_note::note(tokens[0]);
+    const chord_type::ChordType type = chord_type::getChordType(tokens[1]);
+    const pitch_note::Note bass = pitch_note::note(tokens[2]);
+    if (tonic.empty || type.empty || (!tokens[2].empty() && bass.empty) || range.empty()) {
+        return {};
+    }
+
+    // Range ends
+    int low = 127;
+    int high = 0;
+    for (const auto& end : range) {
+        const auto m = midi::toMidi(end);
+        if (!m.has_value()) {
+            return {};
+        }
+        low = std::min(low, m.value());
+        high = std::max(high, m.value());
+    }
+
+    Generator generator(constraints);
+    generator.maxVoices = std::min<int>(constraints.maxVoices, static_cast<int>(voicing_dictionary::MAX_VOICES));
+    for (const auto& name : type.intervals) {
+        const pitch_interval::Interval ivl = pitch_interval::interval(name);
+        if (ivl.empty) continue;
+        const int pc = (tonic.chroma + ivl.chroma) % 12;
+        const unsigned bit = 1u << pc;
+        if (!(generator.chordMask & bit)) {
+            generator.spelling[pc] = tonic.coord[0] + ivl.coord[0];
+        }
+        generator.chordMask |= bit;
+        if (std::find(constraints.omittable.begin(), constraints.omittable.end(), name) ==
+            constraints.omittable.end()) {
+            generator.requiredMask |= bit;
+        }
+        // 2nds, 4ths and 6ths (9ths, 11ths and 13ths)
+        if (ivl.step == 1 || ivl.step == 3 || ivl.step == 5) {
+            generator.tensionMask |= bit;
+        }
+    }
+
+    for (int note = low; note <= high; note++) {
+        const bool chordNote = generator.chordMask & (1u << (note % 12));
+        if (bass.empty ? chordNote : note % 12 == bass.chroma) {
+            generator.bottoms.push_back(note);
+        }
+        if (chordNote) {
+            generator.notes.push_back(note);
+        }
+    }
+    if (!bass.empty && !(generator.chordMask & (1u << bass.chroma))) {
+        generator.spelling[bass.chroma] = bass.coord[0];
+    }
+
+    generator.run();
+    return generator.result;
+}
+
+std::vector<std::vector<std::string>> generate(
+    const std::string& chord,
+    const std::vector<std::string>& range,
+    const Constraints& constraints
+) {
+    std::vector<std::vector<std::string>> result;
+    for (const auto& voicing : generateMidi(chord, range, constraints)) {
+        result.push_back(voicing.names());
+    }
+    return result;
+}
+
+} // namespace voicing_generator
+} // namespace tonalcpp
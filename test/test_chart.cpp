@@ -0,0 +1,124 @@
+#include "doctest.h"
+#include "tonalcpp/chart.h"
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace tonalcpp;
+
+namespace {
+
+// The symbol of each chord of a chart
+std::vector<std::string> symbols(const chart::Chart& result) {
+    std::vector<std::string> list;
+    for (std::uint32_t id : result.events.chords) {
+        list.push_back(result.symbols[id]);
+    }
+    return list;
+}
+
+// A chart of many lines, with bar repeats and unknown symbols
+std::string corpus() {
+    const std::vector<std::string> lines = {
+        "| Dm7 G7 | Cmaj7 % |",
+        "% | Am7 D7 E7 | Gmaj7 |",
+        "# a comment",
+        "Bb7 Eb7",
+        "|| F#m7b5 | B7b9 | x | Em6 % % % |",
+        "",
+    };
+    std::string text;
+    for (int i = 0; i < 200; i++) {
+        text += lines[i % lines.size()] + "\n";
+    }
+    return text;
+}
+
+} // namespace
+
+TEST_CASE("chart::parse") {
+    SUBCASE("bars and beats") {
+        const auto result = chart::parse("| Dm7 G7 | Cmaj7 % |");
+        CHECK_FALSE(result.empty);
+        CHECK(result.bars == 2);
+        CHECK(result.events.bars == std::vector<std::uint32_t>{0, 0, 1, 1});
+        CHECK(result.events.beats == std::vector<std::uint8_t>{0, 2, 0, 2});
+        CHECK(result.events.chords == std::vector<std::uint32_t>{0, 1, 2, 2});
+        CHECK(result.symbols == std::vector<std::string>{"Dm7", "G7", "Cmaj7"});
+        REQUIRE(result.chords.size() == 3);
+        CHECK(result.chords[2].symbol == "Cmaj7");
+        CHECK(result.chord(1).tonic == "G");
+    }
+
+    SUBCASE("the chords of a bar split its beats") {
+        const auto result = chart::parse("C D E | F G A B C", {3});
+        CHECK(result.events.beats == std::vector<std::uint8_t>{0, 1, 2, 0, 0, 1, 1, 2});
+    }
+
+    SUBCASE("lines") {
+        const auto result = chart::parse("# Blues\nC7 | F7 |\r\n\nC7\n|   |\n  # also a comment\n| G7 ||");
+        CHECK(result.bars == 4);
+        CHECK(symbols(result) == std::vector<std::string>{"C7", "F7", "C7", "G7"});
+        CHECK(result.events.bars == std::vector<std::uint32_t>{0, 1, 2, 3});
+    }
+
+    SUBCASE("repeats") {
+        const auto result = chart::parse("| Dm7 G7 | % |\n% Cmaj7");
+        CHECK(symbols(result) == std::vector<std::string>{"Dm7", "G7", "G7", "G7", "Cmaj7"});
+        CHECK(result.symbols.size() == 3);
+        CHECK(symbols(chart::parse("% C")) == std::vector<std::string>{"%", "C"});
+    }
+
+    SUBCASE("unknown symbols") {
+        const auto result = chart::parse("| C | N.C. | Xyz |");
+        CHECK(result.symbols.size() == 3);
+        CHECK_FALSE(result.chords[0].empty);
+        CHECK(result.chords[1].empty);
+        CHECK(result.chords[2].empty);
+    }
+
+    SUBCASE("empty") {
+        const auto result = chart::parse("");
+        CHECK_FALSE(result.empty);
+        CHECK(result.bars == 0);
+        CHECK(result.events.empty());
+        CHECK(chart::parse("# nothing\n\n").symbols.empty());
+    }
+}
+
+TEST_CASE("chart::parse in parallel") {
+    const std::string text = corpus();
+    const auto expected = chart::parse(text);
+    thread_pool::ThreadPool pool(3);
+    // Small chunks: many of them start with a repeat
+    for (std::size_t chunkSize : {1, 7, 64, 1000, 1 << 20}) {
+        chart::ChartOptions options;
+        options.chunkSize = chunkSize;
+        const auto result = chart::parse(text, options, pool);
+        CHECK(result.bars == expected.bars);
+        CHECK(result.events.bars == expected.events.bars);
+        CHECK(result.events.beats == expected.events.beats);
+        CHECK(result.events.chords == expected.events.chords);
+        CHECK(result.symbols == expected.symbols);
+        CHECK(result.chords.size() == expected.chords.size());
+    }
+    CHECK(expected.symbols.size() == 13);
+    CHECK(chart::parse("% | C", {4, 1}, pool).symbols == std::vector<std::string>{"%", "C"});
+}
+
+TEST_CASE("chart::load") {
+    const std::string path = "tonalcpp_test_chart.txt";
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << corpus();
+    }
+    const auto expected = chart::parse(corpus());
+    CHECK(chart::load(path).events.chords == expected.events.chords);
+    thread_pool::ThreadPool pool(2);
+    CHECK(chart::load(path, {4, 256}, pool).events.bars == expected.events.bars);
+    CHECK(chart::load("does/not/exist.txt").empty);
+    CHECK(chart::load("does/not/exist.txt", {}, pool).empty);
+    std::remove(path.c_str());
+}
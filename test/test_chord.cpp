@@ -1,6 +1,9 @@
 #include "doctest.h"
 #include "tonalcpp/chord.h"
+#include "test_helpers.h"
+#include <memory_resource>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <functional>
 
@@ -26,6 +29,17 @@ TEST_CASE("tokenize") {
     // With bass
     CHECK(tokenize("Cmaj7/G") == ChordNameTokens({"C", "maj7", "G"}));
     CHECK(tokenize("bb6/a##") == ChordNameTokens({"Bb", "6", "A##"}));
+    CHECK(tokenize("Cmaj7/G4") == ChordNameTokens({"C", "maj7/G4", ""}));
+}
+
+TEST_CASE("get from a string_view") {
+    const std::string_view sheet = "| Dm7 | G7/B | Cmaj7 |";
+    const Chord dm7 = get(sheet.substr(2, 3));
+    CHECK(dm7.symbol == "Dm7");
+    CHECK(dm7.notes == std::vector<std::string>{"D", "F", "A", "C"});
+    CHECK(get(sheet.substr(8, 4)).notes == std::vector<std::string>{"B", "D", "F", "G"});
+    CHECK(tokenize(sheet.substr(15, 5)) == ChordNameTokens({"C", "maj7", ""}));
+    CHECK(get(sheet.substr(15, 6)).empty);
 }
 
 TEST_CASE("getChord") {
@@ -294,4 +308,16 @@ TEST_CASE("stepToNote") {
     }
 
     CHECK(result == std::vector<std::string>({"C3", "E3", "G#3", "C4", "E4", "G#4", "C5"}));
-}
\ No newline at end of file
+}
+TEST_CASE("notes with a memory resource") {
+    // Everything must come from the buffer
+    char buffer[4096];
+    std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+
+    const auto result = notes(&arena, "Cmaj7/B");
+    CHECK(result.get_allocator().resource() == &arena);
+    CHECK(tonalcpp::test::toStrings(result) == notes("Cmaj7/B"));
+    CHECK(tonalcpp::test::toStrings(notes(&arena, "maj7", "Eb")) == notes("maj7", "Eb"));
+    CHECK(notes(&arena, "blah").empty());
+    CHECK(notes(&arena, "maj7").empty());
+}
@@ -5,7 +5,9 @@
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <atomic>
 #include <set>
+#include <thread>
 
 using namespace tonalcpp;
 using namespace tonalcpp::chord_type;
@@ -71,6 +73,14 @@ TEST_CASE("chord_type - getChordType function") {
     
     CHECK_EQ(major.chroma, "100010010000");
     CHECK_EQ(major.normalized, "100001000100");
+
+    // By alias, chroma or set number, also from a slice of a larger string
+    const std::string_view names = "m7 100010010000";
+    CHECK_EQ(getChordType(names.substr(0, 2)).name, "minor seventh");
+    CHECK_EQ(getChordType(names.substr(3)).name, "major");
+    CHECK_EQ(getChordType(2192).name, "major");
+    CHECK(getChordType(names.substr(0, 1)).name == "minor");
+    CHECK(getChordType(names).empty);
 }
 
 TEST_CASE("chord_type - add a chord") {
@@ -103,6 +113,87 @@ TEST_CASE("chord_type - clear dictionary") {
     CHECK_EQ(all().size(), 106);
 }
 
+TEST_CASE("chord_type - add many chords") {
+    const std::size_t size = all().size();
+    const ChordType major = getChordType("M");
+
+    REQUIRE(addAll({
+        {{"1P", "4A", "7m", "10M", "13M"}, {"myst"}, "mystic"},
+        {{"1P", "5P"}, {"5th"}, "power"},
+        // The same chord again: only its new aliases are added
+        {{"1P", "5P"}, {"5th", "pow"}, "power"},
+    }));
+    CHECK_EQ(all().size(), size + 2);
+    CHECK_EQ(getChordType("myst").name, "mystic");
+    CHECK_EQ(getChordType("mystic").quality, ChordQuality::Unknown);
+    CHECK_EQ(getChordType("pow").name, "power");
+    CHECK_EQ(getChordType("power").aliases, std::vector<std::string>{"5th", "pow"});
+    CHECK_EQ(getChordType("maj7").name, "major seventh");
+    CHECK_EQ(getChordType("M").name, major.name);
+
+    SUBCASE("an invalid definition adds nothing") {
+        CHECK_FALSE(addAll({{{"1P", "3M"}, {"ok"}, "fine"}, {{"1P", "3X"}, {"bad"}, "broken"}}));
+        CHECK_FALSE(addAll({{{}, {"none"}, "no intervals"}}));
+        CHECK_EQ(all().size(), size + 2);
+        CHECK(getChordType("ok").empty);
+    }
+
+    SUBCASE("unnamed chords are not merged") {
+        REQUIRE(addAll({{{"1P", "2M", "3M"}, {"xa"}, ""}, {{"1P", "3M", "2M"}, {"xb"}, ""}}));
+        CHECK_EQ(all().size(), size + 4);
+        CHECK_EQ(getChordType("xa").aliases, std::vector<std::string>{"xa"});
+        CHECK_EQ(getChordType("xb").aliases, std::vector<std::string>{"xb"});
+    }
+
+    SUBCASE("lookups while adding") {
+        std::vector<Definition> definitions;
+        for (int i = 0; i < 64; i++) {
+            definitions.push_back({{"1P", "5P"}, {"p" + std::to_string(i)}, "power " + std::to_string(i)});
+        }
+        std::atomic<bool> done(false);
+        std::thread reader([&]() {
+            while (!done) {
+                // The old or the new dictionary, never a part of it
+                const ChordType chord = getChordType("p63");
+                CHECK((chord.empty || getChordType("p0").name == "power 0"));
+                CHECK_EQ(getChordType("maj7").name, "major seventh");
+            }
+        });
+        CHECK(addAll(definitions));
+        done = true;
+        reader.join();
+        CHECK_EQ(all().size(), size + 2 + 64);
+    }
+
+    SUBCASE("many chords") {
+        // Every pitch class set with a root: 2048 chords
+        std::vector<Definition> definitions;
+        const std::vector<std::string> intervals = {"2m", "2M", "3m", "3M", "4P", "4A", "5P", "6m", "6M", "7m", "7M"};
+        for (int set = 0; set < 2048; set++) {
+            Definition definition;
+            definition.intervals.push_back("1P");
+            for (int i = 0; i < 11; i++) {
+                if (set & (1 << i)) {
+                    definition.intervals.push_back(intervals[i]);
+                }
+            }
+            definition.name = "set " + std::to_string(set);
+            definition.aliases.push_back("s" + std::to_string(set));
+            definitions.push_back(definition);
+        }
+        REQUIRE(addAll(definitions));
+        CHECK_EQ(all().size(), size + 2 + 2048);
+        CHECK_EQ(getChordType("s2047").chroma, "111111111111");
+        CHECK_EQ(getChordType("set 0").intervals, std::vector<std::string>{"1P"});
+        // The last chord with a chroma is found
+        CHECK_EQ(getChordType("100000010000").name, "set 64");
+    }
+
+    initChordTypes();
+    CHECK_EQ(all().size(), 106);
+    CHECK(getChordType("myst").empty);
+}
+
 TEST_CASE("chord_type - split function matches JavaScript behavior") {
     // Test with standard chord alias string containing multiple spaces
     std::string test1 = "M ^  maj";
@@ -90,4 +90,83 @@ TEST_CASE("Collection permutations") {
             CHECK(found);
         }
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Collection seeded shuffle") {
+    const auto input = split("a b c d e f g h");
+    const auto result = shuffle(input, 42);
+    CHECK(result == shuffle(input, 42));
+    CHECK(result != shuffle(input, 43));
+    auto sorted = result;
+    std::sort(sorted.begin(), sorted.end());
+    CHECK(sorted == input);
+    CHECK(shuffle(std::vector<int>{}, 1).empty());
+
+    Random random(7);
+    for (int i = 0; i < 100; i++) {
+        const double value = random.uniform();
+        CHECK(value >= 0.0);
+        CHECK(value < 1.0);
+        CHECK(random.below(12) < 12u);
+    }
+    CHECK(Random(7)() == Random(7)());
+}
+
+TEST_CASE("Collection lazy generators") {
+    SUBCASE("permutationsView") {
+        const std::vector<std::string> input = {"c", "a", "b"};
+        std::vector<std::vector<std::string>> perms;
+        for (const auto& perm : permutationsView(input)) {
+            perms.push_back(perm);
+        }
+        CHECK(perms == permutations(input));
+        // Repeated values
+        std::size_t count = 0;
+        for (const auto& perm : permutationsView(std::vector<int>{1, 1, 2})) {
+            CHECK(perm.size() == 3);
+            count++;
+        }
+        CHECK(count == 3);
+    }
+
+    SUBCASE("early exit") {
+        // The 10! permutations are never stored
+        std::vector<int> input(10);
+        for (int i = 0; i < 10; i++) input[i] = i;
+        std::size_t count = 0;
+        for (const auto& perm : permutationsView(input)) {
+            if (perm[0] == 1) break;
+            count++;
+        }
+        CHECK(count == 362880);
+    }
+
+    SUBCASE("combinationsView") {
+        std::vector<std::vector<std::string>> result;
+        for (const auto& c : combinationsView(split("a b c d"), 2)) {
+            result.push_back(c);
+        }
+        CHECK(result == std::vector<std::vector<std::string>>{
+            {"a", "b"}, {"a", "c"}, {"a", "d"}, {"b", "c"}, {"b", "d"}, {"c", "d"}});
+
+        auto view = combinationsView(std::vector<int>{1, 2, 3}, 3);
+        CHECK(std::distance(view.begin(), view.end()) == 1);
+        auto none = combinationsView(std::vector<int>{1, 2}, 3);
+        CHECK(none.begin() == none.end());
+        auto empty = combinationsView(std::vector<int>{1, 2}, 0);
+        CHECK(std::distance(empty.begin(), empty.end()) == 1);
+        // Iterating again starts over
+        CHECK(std::distance(view.begin(), view.end()) == 1);
+    }
+
+    SUBCASE("subsetsView") {
+        std::vector<std::vector<std::string>> result;
+        for (const auto& s : subsetsView(split("a b c"))) {
+            result.push_back(s);
+        }
+        CHECK(result == std::vector<std::vector<std::string>>{
+            {}, {"a"}, {"b"}, {"a", "b"}, {"c"}, {"a", "c"}, {"b", "c"}, {"a", "b", "c"}});
+        auto empty = subsetsView(std::vector<int>{});
+        CHECK(std::distance(empty.begin(), empty.end()) == 1);
+    }
+}
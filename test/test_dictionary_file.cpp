@@ -0,0 +1,234 @@
+#include "doctest.h"
+#include "tonalcpp/dictionary_file.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace tonalcpp;
+using dictionary_file::Dictionary;
+using dictionary_file::Kind;
+
+namespace {
+
+std::vector<std::string> strings(const dictionary_file::Strings& list) {
+    return list.toVector();
+}
+
+void write(const std::string& path, const std::string& text) {
+    std::ofstream out(path, std::ios::binary);
+    out << text;
+}
+
+} // namespace
+
+TEST_CASE("dictionary_file chord types") {
+    const std::vector<chord_type::ChordType> types = chord_type::all();
+    const Dictionary dictionary(dictionary_file::compile(types));
+    REQUIRE(dictionary.isOpen());
+    CHECK(dictionary.kind() == Kind::ChordTypes);
+    REQUIRE(dictionary.size() == types.size());
+
+    SUBCASE("entries") {
+        for (std::size_t i = 0; i < types.size(); i++) {
+            const chord_type::ChordType type = dictionary_file::toChordType(dictionary[i]);
+            CHECK(type.name == types[i].name);
+            CHECK(type.setNum == types[i].setNum);
+            CHECK(type.chroma == types[i].chroma);
+            CHECK(type.normalized == types[i].normalized);
+            CHECK(type.intervals == types[i].intervals);
+            CHECK(type.aliases == types[i].aliases);
+            CHECK(type.quality == types[i].quality);
+        }
+    }
+
+    SUBCASE("lookup") {
+        const auto maj7 = dictionary.find("maj7");
+        REQUIRE(maj7);
+        CHECK(maj7->name() == "major seventh");
+        CHECK(maj7->chroma() == "100010010001");
+        CHECK(maj7->quality() == chord_type::ChordQuality::Major);
+        CHECK(strings(maj7->intervals()) == std::vector<std::string>{"1P", "3M", "5P", "7M"});
+        CHECK(dictionary.find("major seventh")->setNum() == maj7->setNum());
+        CHECK(dictionary.indexOf("100010010001") == dictionary.indexOf("maj7"));
+        CHECK(dictionary.indexOf(maj7->setNum()) == dictionary.indexOf("maj7"));
+        CHECK(dictionary.indexOf("not a chord") == -1);
+        // The major chord has an empty alias, so "C" is a chord
+        CHECK(dictionary.find("")->name() == "major");
+    }
+
+    SUBCASE("every name is found") {
+        for (const chord_type::ChordType& type : types) {
+            if (!type.name.empty()) {
+                const auto entry = dictionary.find(type.name);
+                REQUIRE(entry);
+                CHECK(entry->name() == type.name);
+            }
+        }
+    }
+}
+
+TEST_CASE("dictionary_file scale types") {
+    const std::vector<scale_type::ScaleType> types = scale_type::all();
+    const Dictionary dictionary(dictionary_file::compile(types));
+    REQUIRE(dictionary.isOpen());
+    CHECK(dictionary.kind() == Kind::ScaleTypes);
+    REQUIRE(dictionary.size() == types.size());
+    for (std::size_t i = 0; i < types.size(); i++) {
+        const scale_type::ScaleType type = dictionary_file::toScaleType(dictionary[i]);
+        CHECK(type.name == types[i].name);
+        CHECK(type.intervals == types[i].intervals);
+        CHECK(type.aliases == types[i].aliases);
+    }
+    CHECK(dictionary.find("ionian")->name() == "major");
+    CHECK(dictionary.find("dorian")->chroma() == "101101010110");
+}
+
+TEST_CASE("dictionary_file voicings") {
+    const Dictionary dictionary(dictionary_file::compile(voicing_dictionary::all));
+    REQUIRE(dictionary.isOpen());
+    CHECK(dictionary.kind() == Kind::Voicings);
+    CHECK(dictionary_file::toVoicingDictionary(dictionary) == voicing_dictionary::all);
+
+    const auto m7 = dictionary.find("m7");
+    REQUIRE(m7);
+    REQUIRE(m7->patternCount() == voicing_dictionary::all.at("m7").size());
+    for (std::size_t i = 0; i < m7->patternCount(); i++) {
+        CHECK(m7->patternSource(i) == voicing_dictionary::all.at("m7")[i]);
+        CHECK(m7->pattern(i) == voicing_dictionary::compilePattern(std::string(m7->patternSource(i))));
+    }
+}
+
+TEST_CASE("dictionary_file::compileText") {
+    SUBCASE("chord types") {
+        const Dictionary dictionary(dictionary_file::compileText(Kind::ChordTypes,
+            "# Custom chords\n"
+            "\n"
+            "mystic = 1P 4A 7m 10M 13M 18P | myst\n"
+            "power = 1P 5P | 5 | pow\r\n"));
+        REQUIRE(dictionary.isOpen());
+        REQUIRE(dictionary.size() == 2);
+        CHECK(dictionary[0].name() == "mystic");
+        CHECK(strings(dictionary[0].aliases()) == std::vector<std::string>{"myst"});
+        CHECK(dictionary.find("pow")->name() == "power");
+        CHECK(dictionary.find("5")->chroma() == "100000010000");
+        CHECK(dictionary.find("power")->quality() == chord_type::ChordQuality::Unknown);
+    }
+
+    SUBCASE("scale types") {
+        const Dictionary dictionary(dictionary_file::compileText(Kind::ScaleTypes,
+            "blues = 1P 3m 4P 5d 5P 7m | minor blues\n"));
+        REQUIRE(dictionary.isOpen());
+        CHECK(dictionary.find("minor blues")->setNum() == scale_type::get("blues").setNum);
+    }
+
+    SUBCASE("voicings") {
+        const Dictionary dictionary(dictionary_file::compileText(Kind::Voicings,
+            "m7 = 3m 5P 7m 9M | 7m 9M 10m 12P\n"));
+        REQUIRE(dictionary.isOpen());
+        CHECK(dictionary.find("m7")->patternCount() == 2);
+    }
+
+    SUBCASE("invalid lines") {
+        CHECK(dictionary_file::compileText(Kind::ChordTypes, "no intervals").empty());
+        CHECK(dictionary_file::compileText(Kind::ChordTypes, "bad = 1P 3X").empty());
+        CHECK(dictionary_file::compileText(Kind::ChordTypes, "bad = 1P 3M ||").empty());
+        CHECK(dictionary_file::compileText(Kind::ScaleTypes, " = 1P 3M 5P").empty());
+        CHECK(dictionary_file::compileText(Kind::Voicings, "m7 = 3m 5X").empty());
+    }
+
+    SUBCASE("an empty text is an empty dictionary") {
+        const Dictionary dictionary(dictionary_file::compileText(Kind::ChordTypes, "# nothing\n"));
+        CHECK(dictionary.isOpen());
+        CHECK(dictionary.empty());
+        CHECK(dictionary.indexOf("anything") == -1);
+    }
+}
+
+TEST_CASE("dictionary_file::Dictionary validation") {
+    const std::vector<std::uint8_t> bytes = dictionary_file::compile(chord_type::all());
+    CHECK(Dictionary(bytes.data(), bytes.size()).isOpen());
+
+    SUBCASE("not open") {
+        const Dictionary dictionary;
+        CHECK_FALSE(dictionary.isOpen());
+        CHECK(dictionary.empty());
+        CHECK(dictionary.indexOf("maj7") == -1);
+    }
+
+    SUBCASE("truncated") {
+        CHECK_FALSE(Dictionary(bytes.data(), bytes.size() / 2).isOpen());
+        CHECK_FALSE(Dictionary(bytes.data(), 16).isOpen());
+    }
+
+    SUBCASE("wrong magic or version") {
+        std::vector<std::uint8_t> copy = bytes;
+        copy[0] = 'X';
+        CHECK_FALSE(Dictionary(copy).isOpen());
+        copy = bytes;
+        copy[4] = dictionary_file::VERSION + 1;
+        CHECK_FALSE(Dictionary(copy).isOpen());
+    }
+
+    SUBCASE("offsets out of bounds") {
+        std::vector<std::uint8_t> copy = bytes;
+        // The name offset of the first entry, after the header
+        copy[32 + 3] = 0xFF;
+        CHECK_FALSE(Dictionary(copy).isOpen());
+    }
+
+    SUBCASE("a hash table without empty slots") {
+        // Point every empty slot to the first entry: a lookup would never end
+        std::vector<std::uint8_t> copy = bytes;
+        const auto u32 = [&](std::size_t at) {
+            return copy[at] | (copy[at + 1] << 8) | (copy[at + 2] << 16) | (copy[at + 3] << 24);
+        };
+        const std::size_t slotsStart = 32 + u32(8) * 48 + u32(16) * 8;
+        for (std::size_t slot = 0; slot < static_cast<std::size_t>(u32(12)); slot++) {
+            const std::size_t entry = slotsStart + slot * 12 + 8;
+            if (u32(entry) == 0) {
+                copy[entry] = 1;
+            }
+        }
+        CHECK_FALSE(Dictionary(copy).isOpen());
+    }
+}
+
+TEST_CASE("dictionary_file::install") {
+    const Dictionary chords(dictionary_file::compileText(Kind::ChordTypes, "mystic = 1P 4A 7m 10M 13M | myst\n"));
+    REQUIRE(dictionary_file::install(chords));
+    CHECK(chord_type::getChordType("myst").name == "mystic");
+    chord_type::initChordTypes();
+
+    const Dictionary scales(dictionary_file::compileText(Kind::ScaleTypes, "quinta = 1P 5P | q\n"));
+    REQUIRE(dictionary_file::install(scales));
+    CHECK(scale_type::get("q").name == "quinta");
+    scale_type::initialize();
+
+    CHECK_FALSE(dictionary_file::install(Dictionary(dictionary_file::compile(voicing_dictionary::all))));
+    CHECK_FALSE(dictionary_file::install(Dictionary()));
+}
+
+TEST_CASE("dictionary_file files") {
+    const std::string source = "tonalcpp_test_dictionary.txt";
+    const std::string path = "tonalcpp_test_dictionary.tnld";
+    write(source, "mystic = 1P 4A 7m 10M 13M 18P | myst\n");
+    REQUIRE(dictionary_file::compileFile(Kind::ChordTypes, source, path));
+
+    Dictionary dictionary(path);
+    REQUIRE(dictionary.isOpen());
+    CHECK(dictionary.find("myst")->name() == "mystic");
+
+    SUBCASE("moved dictionaries keep their entries") {
+        Dictionary moved = std::move(dictionary);
+        CHECK_FALSE(dictionary.isOpen());
+        CHECK(moved.find("mystic")->aliases()[0] == "myst");
+    }
+
+    CHECK_FALSE(Dictionary("does/not/exist.tnld").isOpen());
+    write(source, "invalid\n");
+    CHECK_FALSE(dictionary_file::compileFile(Kind::ChordTypes, source, path));
+    CHECK_FALSE(dictionary_file::compileFile(Kind::ChordTypes, "does/not/exist.txt", path));
+    std::remove(source.c_str());
+    std::remove(path.c_str());
+}
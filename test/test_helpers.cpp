@@ -8,5 +8,14 @@ bool approxEqual(double a, double b, double epsilon) {
     return std::abs(a - b) < epsilon;
 }
 
+std::vector<std::string> toStrings(const std::pmr::vector<std::pmr::string>& list) {
+    std::vector<std::string> result;
+    result.reserve(list.size());
+    for (const auto& str : list) {
+        result.emplace_back(str);
+    }
+    return result;
+}
+
 } // namespace test
 } // namespace tonalcpp
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define TEST_HELPERS_H
 
 #include "tonalcpp/helpers.h"
+#include <memory_resource>
 #include <vector>
 #include <string>
 
@@ -11,6 +12,9 @@ namespace test {
 // Helper function to check if two doubles are approximately equal
 bool approxEqual(double a, double b, double epsilon = 0.0001);
 
+// Copy a list of strings allocated from a memory resource
+std::vector<std::string> toStrings(const std::pmr::vector<std::pmr::string>& list);
+
 } // namespace test
 
 // Import helpers directly into the tonalcpp namespace for compatibility with existing tests
@@ -0,0 +1,74 @@
+#include "doctest.h"
+#include "tonalcpp/helpers.h"
+#include <functional>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+using namespace tonalcpp;
+
+TEST_CASE("helpers - StringMap finds keys from string views") {
+    helpers::StringMap<int> map;
+    std::string key = "maj7";
+    map[key] = 1;
+    map["m7"] = 2;
+    map[std::string_view(key).substr(0, 3)] += 3;
+    key = "xxxx"; // Keys are copied
+
+    CHECK(map.size() == 3);
+    REQUIRE(map.find("maj7") != nullptr);
+    CHECK(*map.find("maj7") == 1);
+    CHECK(*map.find(std::string_view("m7b5").substr(0, 2)) == 2);
+    CHECK(*map.find("maj") == 3);
+    CHECK(map.find("xxxx") == nullptr);
+
+    std::set<std::string> keys;
+    for (const auto& entry : map) {
+        keys.emplace(entry.first);
+    }
+    CHECK(keys == std::set<std::string>{"maj", "maj7", "m7"});
+
+    map.clear();
+    CHECK(map.empty());
+    CHECK(map.find("m7") == nullptr);
+}
+
+TEST_CASE("helpers - InlineString") {
+    using Name = helpers::InlineString<7>;
+    static_assert(sizeof(Name) == 8, "7 chars and the size");
+    static_assert(std::is_trivially_copyable_v<Name>, "copied with memcpy");
+
+    const Name empty;
+    CHECK(empty.empty());
+    CHECK(empty == "");
+
+    const Name name = std::string("Bbb-1");
+    CHECK(name.size() == 5);
+    CHECK(name == "Bbb-1");
+    CHECK("Bbb-1" == name);
+    CHECK(name == std::string("Bbb-1"));
+    CHECK(name != Name("Bb-1"));
+    CHECK(Name("A") < Name("B"));
+    CHECK(name.front() == 'B');
+    CHECK(name.back() == '1');
+
+    // Conversions and concatenation
+    const std::string str = name;
+    const std::string_view view = name;
+    CHECK(str == "Bbb-1");
+    CHECK(view == "Bbb-1");
+    CHECK(name + "/" + Name("C") == "Bbb-1/C");
+    CHECK('(' + name + ')' == "(Bbb-1)");
+
+    // Capacity
+    CHECK(Name::fits("1234567"));
+    CHECK_FALSE(Name::fits("12345678"));
+    CHECK(Name("1234567").size() == 7);
+    CHECK_THROWS_AS(Name("12345678"), std::length_error);
+
+    std::set<Name> names = {Name("E"), Name("C"), Name("E")};
+    CHECK(names.size() == 2);
+    CHECK(std::hash<Name>()(name) == std::hash<std::string_view>()("Bbb-1"));
+}
@@ -0,0 +1,90 @@
+#include "doctest.h"
+#include "tonalcpp/chord.h"
+#include "tonalcpp/instrumentation.h"
+#include "tonalcpp/pitch_note.h"
+#include "tonalcpp/voicing.h"
+#include <algorithm>
+#include <new>
+#include <numeric>
+#include <string>
+
+using namespace tonalcpp;
+using namespace tonalcpp::instrumentation;
+
+// Count the allocations of the test program (only when instrumented)
+TONAL_INSTRUMENTATION_ALLOCATION_HOOK()
+
+static const ProbeStats* findProbe(const Snapshot& snapshot, const std::string& name) {
+    auto it = std::find_if(snapshot.probes.begin(), snapshot.probes.end(),
+                           [&](const ProbeStats& p) { return p.name == name; });
+    return it == snapshot.probes.end() ? nullptr : &*it;
+}
+
+TEST_CASE("Instrumentation") {
+    reset();
+
+    if (!enabled()) {
+        chord::get("Cmaj7");
+        const Snapshot empty = snapshot();
+        CHECK(empty.probes.empty());
+        CHECK(empty.caches.empty());
+        CHECK(empty.allocations == 0);
+        return;
+    }
+
+    SUBCASE("call counters and histograms") {
+        chord::get("Cmaj7");
+        chord::get("Dm7");
+        const Snapshot stats = snapshot();
+        const ProbeStats* get = findProbe(stats, "chord::get");
+        REQUIRE(get != nullptr);
+        CHECK(get->calls == 2);
+        CHECK(std::accumulate(get->histogram.begin(), get->histogram.end(), std::uint64_t(0)) == 2);
+        CHECK(get->totalNs > 0);
+        CHECK(get->allocations > 0);
+        CHECK(get->allocatedBytes > 0);
+        CHECK(stats.allocations >= get->allocations);
+
+        // Nested calls are counted too
+        const ProbeStats* note = findProbe(stats, "pitch_note::note");
+        REQUIRE(note != nullptr);
+        CHECK(note->calls >= 2);
+    }
+
+    SUBCASE("cache hits and misses") {
+        pitch_note::clearCache();
+        reset();
+        pitch_note::note("Gb7");
+        pitch_note::note("Gb7");
+        pitch_note::note("Gb7");
+        const Snapshot stats = snapshot();
+        REQUIRE(stats.caches.size() == CACHE_COUNT);
+        const CacheStats& notes = stats.caches[static_cast<std::size_t>(Cache::Note)];
+        CHECK(notes.name == "noteCache");
+        CHECK(notes.hits == 2);
+        CHECK(notes.misses == 1);
+        CHECK(notes.hitRate() == doctest::Approx(2.0 / 3.0));
+    }
+
+    SUBCASE("nothrow allocations") {
+        const AllocationCount before = threadAllocations();
+        int* value = new (std::nothrow) int(7);
+        int* values = new (std::nothrow) int[4];
+        const AllocationCount after = threadAllocations();
+        REQUIRE(value != nullptr);
+        REQUIRE(values != nullptr);
+        CHECK(after.allocations - before.allocations == 2);
+        CHECK(after.bytes - before.bytes == 5 * sizeof(int));
+        delete value;
+        delete[] values;
+    }
+
+    SUBCASE("reset") {
+        voicing::search("C^7", {"E3", "D5"});
+        CHECK(findProbe(snapshot(), "voicing::searchMidi")->calls == 1);
+        reset();
+        const Snapshot stats = snapshot();
+        CHECK(findProbe(stats, "voicing::searchMidi")->calls == 0);
+        CHECK(stats.caches[0].hits + stats.caches[0].misses == 0);
+    }
+}
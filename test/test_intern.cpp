@@ -0,0 +1,127 @@
+#include "doctest.h"
+#include "tonalcpp/chord.h"
+#include "tonalcpp/intern.h"
+#include "tonalcpp/midi.h"
+#include "tonalcpp/note.h"
+#include "tonalcpp/pcset.h"
+#include "tonalcpp/pitch_note.h"
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+using namespace tonalcpp;
+using intern::Handle;
+
+static std::vector<std::string> names(const std::vector<Handle>& handles) {
+    std::vector<std::string> result;
+    for (const Handle handle : handles) {
+        result.push_back(handle.str());
+    }
+    return result;
+}
+
+TEST_CASE("intern") {
+    SUBCASE("equal names have the same handle") {
+        const Handle a = intern::intern("C#4");
+        const Handle b = intern::intern(std::string("C#") + "4");
+        CHECK(a == b);
+        CHECK(a != intern::intern("Db4"));
+        CHECK(a.str() == "C#4");
+        CHECK(a.view() == "C#4");
+        CHECK(!a.empty());
+    }
+
+    SUBCASE("the empty name") {
+        CHECK(Handle().empty());
+        CHECK(Handle().str().empty());
+        CHECK(intern::intern("") == Handle());
+        CHECK(Handle().id() == 0);
+    }
+
+    SUBCASE("stable references") {
+        const std::string& name = intern::intern("stable name").str();
+        for (int i = 0; i < 1000; i++) {
+            intern::intern("name " + std::to_string(i));
+        }
+        CHECK(&name == &intern::intern("stable name").str());
+        CHECK(name == "stable name");
+    }
+
+    SUBCASE("find doesn't intern") {
+        CHECK_FALSE(intern::find("never interned").has_value());
+        const std::size_t size = intern::size();
+        CHECK_FALSE(intern::find("never interned").has_value());
+        CHECK(intern::size() == size);
+        CHECK(intern::find("C#4") == intern::intern("C#4"));
+    }
+
+    SUBCASE("hash") {
+        std::unordered_set<Handle> set = {intern::intern("C"), intern::intern("E"), intern::intern("C")};
+        CHECK(set.size() == 2);
+        CHECK(set.count(intern::intern("E")) == 1);
+    }
+
+    SUBCASE("concurrent interning") {
+        std::vector<std::vector<Handle>> results(4);
+        std::vector<std::thread> threads;
+        for (std::size_t t = 0; t < results.size(); t++) {
+            threads.emplace_back([&results, t]() {
+                for (int i = 0; i < 500; i++) {
+                    results[t].push_back(intern::intern("concurrent " + std::to_string(i)));
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        for (std::size_t t = 1; t < results.size(); t++) {
+            CHECK(results[t] == results[0]);
+        }
+        CHECK(results[0][42].str() == "concurrent 42");
+    }
+}
+
+TEST_CASE("interned name variants") {
+    SUBCASE("midi::midiToNoteHandle") {
+        midi::ToNoteNameOptions options;
+        for (int m : {0, 61, 127, 128}) {
+            for (bool sharps : {false, true}) {
+                for (bool pitchClass : {false, true}) {
+                    options.sharps = sharps;
+                    options.pitchClass = pitchClass;
+                    CHECK(midi::midiToNoteHandle(m, options).str() == midi::midiToNoteName(m, options));
+                }
+            }
+        }
+    }
+
+    SUBCASE("note::fromMidiHandle") {
+        CHECK(note::fromMidiHandle(70).str() == "Bb4");
+        CHECK(note::fromMidiSharpsHandle(70).str() == "A#4");
+        CHECK(note::fromMidiHandle(70) == intern::intern(note::fromMidi(70)));
+    }
+
+    SUBCASE("pitch_note::pitchNameHandle") {
+        const pitch_note::Note n = pitch_note::note("F##5");
+        CHECK(pitch_note::pitchNameHandle(n).str() == "F##5");
+        CHECK(pitch_note::pitchNameHandle(pitch::Pitch{8, 0, std::nullopt, std::nullopt}).empty());
+    }
+
+    SUBCASE("pcset::noteHandles") {
+        for (const std::string chroma : {"101011010101", "111111111111", "010010100100", "000000000000"}) {
+            CHECK(names(pcset::noteHandles(chroma)) == pcset::notes(chroma));
+        }
+        CHECK(names(pcset::noteHandles(std::vector<std::string>{"D", "F#", "A"})) ==
+              std::vector<std::string>{"D", "Gb", "A"});
+        CHECK(pcset::noteHandles(2773) == pcset::noteHandles("101011010101"));
+        CHECK(pcset::noteHandles("x").empty());
+    }
+
+    SUBCASE("chord::symbolHandle") {
+        CHECK(chord::symbolHandle("Cmaj7/E").str() == chord::get("Cmaj7/E").symbol);
+        CHECK(chord::symbolHandle("C^7") != chord::symbolHandle("CM7"));
+        CHECK(chord::symbolHandle("Cmaj7") == intern::intern("Cmaj7"));
+        CHECK(chord::symbolHandle("X").empty());
+    }
+}
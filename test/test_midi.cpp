@@ -4,6 +4,8 @@
 #include <vector>
 #include <string>
 #include <optional>
+#include <limits>
+#include <cmath>
 
 using namespace tonalcpp;
 using namespace tonalcpp::midi;
@@ -62,6 +64,45 @@ TEST_CASE("MIDI") {
         CHECK(approxEqual(midiToFreq(69, 443), 443.0));
     }
 
+    SUBCASE("TuningTable") {
+        TuningTable standard;
+        for (int midi = 0; midi < 128; midi++) {
+            CHECK(standard[midi] == midiToFreq(midi));
+        }
+        TuningTable baroque(415.0);
+        CHECK(baroque.reference() == 415.0);
+        CHECK(approxEqual(midiToFreq(69, baroque), 415.0));
+        CHECK(approxEqual(midiToFreq(81, baroque), 830.0));
+        CHECK(approxEqual(midiToFreq(-12, baroque), midiToFreq(-12, 415.0)));
+    }
+
+    SUBCASE("batch midiToFreq and freqToMidi") {
+        std::vector<float> midi;
+        for (int i = 0; i < 1280; i++) {
+            midi.push_back(i / 10.0f);
+        }
+        std::vector<float> freqs(midi.size());
+        midiToFreq(midi.data(), midi.size(), freqs.data(), 442.0);
+        
+        std::vector<float> back(midi.size());
+        freqToMidi(freqs.data(), freqs.size(), back.data(), 442.0);
+        
+        for (size_t i = 0; i < midi.size(); i++) {
+            const double expected = 442.0 * std::pow(2.0, (midi[i] - 69.0) / 12.0);
+            CHECK(std::abs(freqs[i] - expected) / expected < 1e-6);
+            // Within a thousandth of a semitone
+            CHECK(approxEqual(back[i], midi[i], 0.001));
+        }
+        
+        std::vector<float> invalid = {0.0f, -10.0f, std::numeric_limits<float>::quiet_NaN(),
+                                      std::numeric_limits<float>::infinity()};
+        std::vector<float> out(invalid.size());
+        freqToMidi(invalid.data(), invalid.size(), out.data());
+        for (float v : out) {
+            CHECK(std::isnan(v));
+        }
+    }
+
     SUBCASE("midiToNoteName") {
         std::vector<int> notes = {60, 61, 62, 63, 64, 65, 66, 67, 68, 69, 70, 71, 72};
         std::vector<std::string> expected = {
@@ -183,4 +224,49 @@ TEST_CASE("MIDI") {
         // Test degree 0 (should be null)
         CHECK(!scale(0).has_value());
     }
-}
\ No newline at end of file
+    
+    SUBCASE("PcsetSteps") {
+        constexpr PcsetSteps wholeTone("101010101010", 60);
+        static_assert(wholeTone.size() == 6, "constexpr construction");
+        static_assert(wholeTone(0) == 60, "constexpr evaluation");
+        static_assert(wholeTone(7) == 74, "constexpr evaluation");
+        static_assert(wholeTone(-1) == 58, "constexpr evaluation");
+        
+        // Same results as the std::function version
+        auto fn = pcsetSteps("101011010101", 62);
+        PcsetSteps major("101011010101", 62);
+        for (int step = -20; step <= 20; step++) {
+            CHECK(major(step) == fn(step));
+        }
+        
+        PcsetSteps fromMidi(std::vector<int>{60, 64, 67}, 60);
+        CHECK(fromMidi(3) == 72);
+        CHECK(fromMidi(-1) == 55);
+        
+        // Batch version
+        std::vector<int> steps = {-2, -1, 0, 1, 2};
+        std::vector<int> out(steps.size());
+        fromMidi(steps.data(), steps.size(), out.data());
+        CHECK(out == std::vector<int>{52, 55, 60, 64, 67});
+        
+        // Empty set
+        PcsetSteps empty(std::string("000000000000"), 60);
+        CHECK(empty(3) == 60);
+    }
+    
+    SUBCASE("PcsetDegrees") {
+        constexpr PcsetDegrees degrees("101011010101", 60);
+        static_assert(degrees(1).value() == 60, "constexpr evaluation");
+        static_assert(!degrees(0).has_value(), "constexpr evaluation");
+        
+        auto fn = pcsetDegrees("101011010101", 60);
+        for (int degree = -20; degree <= 20; degree++) {
+            CHECK(degrees(degree) == fn(degree));
+        }
+        
+        std::vector<int> input = {-1, 0, 1, 8};
+        std::vector<int> out(input.size());
+        degrees(input.data(), input.size(), out.data());
+        CHECK(out == std::vector<int>{59, -1, 60, 72});
+    }
+}
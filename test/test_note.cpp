@@ -4,6 +4,8 @@
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <limits>
+#include <memory_resource>
 
 using namespace tonalcpp;
 
@@ -242,4 +244,55 @@ TEST_CASE("note module") {
         // We can't directly check NaN, but any invalid value should return ""
         CHECK(note::fromFreq(-1) == "");
     }
-}
\ No newline at end of file
+
+    SUBCASE("fromFreqId") {
+        auto a4 = note::fromFreqId(440);
+        CHECK(a4.midi == 69);
+        CHECK(approxEqual(a4.cents, 0.0));
+        
+        auto sharpA4 = note::fromFreqId(444);
+        CHECK(sharpA4.midi == 69);
+        CHECK(approxEqual(sharpA4.cents, 15.667, 0.01));
+        
+        auto flatC4 = note::fromFreqId(261.0);
+        CHECK(flatC4.midi == 60);
+        CHECK(flatC4.cents < 0);
+        
+        CHECK(note::fromFreqId(440, 415).midi == 70);
+        CHECK(note::fromFreqId(0).midi == -1);
+        CHECK(note::fromFreqId(-1).midi == -1);
+        CHECK(note::fromFreqId(std::numeric_limits<double>::infinity()).midi == -1);
+    }
+
+    SUBCASE("fromFreqIds") {
+        std::vector<float> freqs = {440.0f, 444.0f, 261.0f, 0.0f, 4186.01f};
+        std::vector<int> midi(freqs.size());
+        std::vector<float> cents(freqs.size());
+        note::fromFreqIds(freqs.data(), freqs.size(), midi.data(), cents.data());
+        
+        CHECK(midi == std::vector<int>{69, 69, 60, -1, 108});
+        for (size_t i = 0; i < freqs.size(); i++) {
+            if (midi[i] >= 0) {
+                CHECK(approxEqual(cents[i], note::fromFreqId(freqs[i]).cents, 0.01));
+            }
+        }
+        
+        // Not finite, as in fromFreqId
+        const float inf = std::numeric_limits<float>::infinity();
+        std::vector<float> invalid = {inf, -inf, std::numeric_limits<float>::quiet_NaN()};
+        note::fromFreqIds(invalid.data(), invalid.size(), midi.data(), cents.data());
+        for (size_t i = 0; i < invalid.size(); i++) {
+            CHECK(midi[i] == note::fromFreqId(invalid[i]).midi);
+        }
+    }
+}
+TEST_CASE("sortedNames with a memory resource") {
+    char buffer[4096];
+    std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+    const auto input = split("c f g a b h j");
+    const auto result = note::sortedNames(&arena, input);
+    CHECK(result.get_allocator().resource() == &arena);
+    CHECK(test::toStrings(result) == note::sortedNames(input));
+    CHECK(test::toStrings(note::sortedNames(&arena, input, note::descending)) ==
+          note::sortedNames(input, note::descending));
+}
@@ -1,6 +1,7 @@
 #include "doctest.h"
 #include "tonalcpp/pcset.h"
 #include "test_helpers.h"
+#include <memory_resource>
 #include <vector>
 
 using namespace tonalcpp;
@@ -166,4 +167,23 @@ TEST_CASE("Pcset modes") {
         auto chromaModes = modes("101010101010", true);
         CHECK(chromaModes.size() > 0);
     }
-}
\ No newline at end of file
+
+    SUBCASE("clearCache") {
+        CHECK(getPcset("101010101010").setNum == 2730);
+        clearCache();
+        CHECK(getPcset("101010101010").setNum == 2730);
+        CHECK(getPcset("000000000000").empty);
+    }
+}
+
+TEST_CASE("Pcset intervals with a memory resource") {
+    char buffer[4096];
+    std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+    const auto result = intervals(&arena, "101010101010");
+    CHECK(result.get_allocator().resource() == &arena);
+    CHECK(toStrings(result) == intervals("101010101010"));
+    CHECK(toStrings(intervals(&arena, 2741)) == intervals(2741));
+    CHECK(toStrings(intervals(&arena, split("C E G B"))) == intervals(split("C E G B")));
+    CHECK(intervals(&arena, "blah").empty());
+    CHECK(intervals(&arena, 5000).empty());
+}
@@ -2,6 +2,8 @@
 #include "tonalcpp/pitch.h"
 #include <vector>
 #include <limits>
+#include <stdexcept>
+#include <type_traits>
 
 using namespace tonalcpp;
 using namespace tonalcpp::pitch;
@@ -115,6 +117,20 @@ TEST_CASE("@tonaljs/pitch") {
         CHECK(coordinates(P5) == PitchCoordinates{1, 0});
         CHECK(coordinates(P_5) == PitchCoordinates{-1, -0});
     }
+
+    SUBCASE("coordinates are stored inline") {
+        static_assert(std::is_trivially_copyable_v<PitchCoordinates>, "copied with memcpy");
+        PitchCoordinates coord;
+        CHECK(coord.empty());
+        coord.push_back(2);
+        coord.push_back(-1);
+        CHECK(coord == PitchCoordinates{2, -1});
+        CHECK(coord != PitchCoordinates{2});
+        CHECK(std::vector<int>(coord.begin(), coord.end()) == std::vector<int>{2, -1});
+        coord.push_back(1);
+        CHECK(coord.size() == 3);
+        CHECK_THROWS_AS(coord.push_back(0), std::length_error);
+    }
     
     SUBCASE("pitch") {
         // Test using the function name in the TS test (pitch) which should map to pitchFromCoordinates
@@ -17,6 +17,28 @@ TEST_CASE("@tonaljs/pitch-interval") {
         auto tokens2 = tokenizeInterval("M-3");
         CHECK(tokens2.first == "-3");
         CHECK(tokens2.second == "M");
+
+        CHECK(tokenizeInterval("+11AAAA") == std::make_pair(std::string("+11"), std::string("AAAA")));
+        CHECK(tokenizeInterval("dd+4") == std::make_pair(std::string("+4"), std::string("dd")));
+        CHECK(tokenizeInterval("3AAAAA").first == "");
+        CHECK(tokenizeInterval("ddd4").first == "");
+        CHECK(tokenizeInterval("3M ").first == "");
+        CHECK(tokenizeInterval("-M").first == "");
+    }
+
+    SUBCASE("string_view slices") {
+        const std::string_view chord = "1P 3M 5P 7m 99999999999M";
+        CHECK(interval(chord.substr(3, 2)).semitones == 4);
+        CHECK(interval(chord.substr(9, 2), false).semitones == 10);
+        CHECK(interval(chord.substr(3, 3)).empty);
+        CHECK(interval(chord.substr(12)).empty);
+    }
+
+    SUBCASE("names are stored inline") {
+        // Up to 7 chars
+        CHECK(interval("-15dddd").name == "-15dddd");
+        CHECK(interval("-15dddd").q == "dddd");
+        CHECK(interval("-115dddd").empty);
     }
 
     SUBCASE("interval from string") {
@@ -154,4 +176,10 @@ TEST_CASE("@tonaljs/pitch-interval") {
             CHECK(interval(intervalPitchName(p10)).name == "1P");
         }
     }
-}
\ No newline at end of file
+
+    SUBCASE("clearCache") {
+        CHECK(interval("-3m").semitones == -3);
+        clearCache();
+        CHECK(interval("-3m").semitones == -3);
+    }
+}
@@ -1,8 +1,10 @@
 #include "doctest.h"
 #include "tonalcpp/pitch_note.h"
 #include "test_helpers.h"
-#include <vector>
 #include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
 
 using namespace tonalcpp;
 using namespace tonalcpp::pitch;
@@ -83,6 +85,39 @@ TEST_CASE("Pitch Note") {
         CHECK(std::get<1>(tokens7) == "");
         CHECK(std::get<2>(tokens7) == "");
         CHECK(std::get<3>(tokens7) == "");
+
+        CHECK(tokenizeNote("f#-1 \t") == std::make_tuple("F", "#", "-1", ""));
+        CHECK(tokenizeNote("Gxx4\nmaj") == std::make_tuple("G", "####", "4", "maj"));
+        CHECK(tokenizeNote("C4 ma\nj") == std::make_tuple("", "", "", ""));
+    }
+
+    SUBCASE("string_view slices") {
+        const std::string_view line = "Cmaj7 Eb4 f#-1|";
+        CHECK(note(line.substr(6, 3)).name == "Eb4");
+        CHECK(note(line.substr(10, 4)).name == "F#-1");
+        CHECK(note(line.substr(10, 5)).empty);
+        CHECK(getNames({"C-", "D1x", "E99999999999"}) == std::vector<std::string>{"", "", ""});
+
+        // Cached names are copied
+        std::string buffer = "Ab3";
+        CHECK(note(std::string_view(buffer)).midi == 56);
+        buffer = "A#3";
+        CHECK(note(std::string_view(buffer)).midi == 58);
+        CHECK(note("Ab3").midi == 56);
+    }
+
+    SUBCASE("names are stored inline") {
+        // Up to 7 chars
+        CHECK(note("Cbbbb-1").name == "Cbbbb-1");
+        CHECK(note("Cbbbb-10").empty);
+        CHECK(note(Pitch{0, 7, 4, std::nullopt}).empty);
+
+        const Note n = note("F#4");
+        std::string text = "Note " + n.name;
+        text += n.pc;
+        CHECK(text == "Note F#4F#");
+        CHECK(std::string(n.letter) == "F");
+        CHECK(n.acc.size() == 1);
     }
     
     SUBCASE("note properties from string") {
@@ -185,4 +220,10 @@ TEST_CASE("Pitch Note") {
         CHECK(note(Pitch{-1, 0, std::nullopt, std::nullopt}).name == "");
         CHECK(note(Pitch{8, 0, std::nullopt, std::nullopt}).name == "");
     }
-}
\ No newline at end of file
+    
+    SUBCASE("clearCache") {
+        CHECK(note("Eb4").midi == 63);
+        clearCache();
+        CHECK(note("Eb4").midi == 63);
+    }
+}
@@ -1,5 +1,6 @@
 #include "doctest.h"
 #include "tonalcpp/range.h"
+#include <memory_resource>
 #include <vector>
 #include <string>
 
@@ -41,4 +42,75 @@ TEST_CASE("Range chromatic") {
         std::vector<std::string> expected = {"C2", "C#2", "D2", "D#2", "E2", "F2", "F#2", "G2", "G#2", "A2", "A#2", "B2", "C3"};
         CHECK(chromatic({"C2", "C3"}, true) == expected);
     }
-}
\ No newline at end of file
+}
+TEST_CASE("Range views") {
+    SUBCASE("numericView") {
+        const auto view = numericView({"C2", "F2", "Bb1", "C2"});
+        CHECK(view.size() == 15);
+        CHECK(view.toVector() == numeric({"C2", "F2", "Bb1", "C2"}));
+        CHECK(std::vector<int>(view.begin(), view.end()) == view.toVector());
+        CHECK(view[0] == 36);
+        CHECK(view[5] == 41);
+        CHECK(view[12] == 34);
+        CHECK(view[14] == 36);
+
+        CHECK(numericView({}).empty());
+        CHECK(numericView({"C4", "blah"}).empty());
+        CHECK(numericView({"C4", "C4"}).toVector() == std::vector<int>{60});
+        CHECK(numericView({"C4"}).size() == 1);
+    }
+
+    SUBCASE("filter by pitch classes") {
+        const unsigned triad = (1u << 0) | (1u << 4) | (1u << 7);
+        const auto view = numericView({"C4", "C5", "A3"}).filter(triad);
+        const std::vector<int> expected = {60, 64, 67, 72, 67, 64, 60};
+        CHECK(view.toVector() == expected);
+        REQUIRE(view.size() == expected.size());
+        for (std::size_t i = 0; i < expected.size(); i++) {
+            CHECK(view[i] == expected[i]);
+        }
+        CHECK(view.filter(1u << 4).toVector() == std::vector<int>{64, 64});
+        CHECK(view.filter(1u << 2).empty());
+        CHECK(view.filter(1u << 2).begin() == view.filter(1u << 2).end());
+
+        // Same as filtering the materialized range
+        const auto wide = numericView({"C0", "G9", "D2", "A4"});
+        const unsigned mask = (1u << 1) | (1u << 6) | (1u << 11);
+        std::vector<int> filtered;
+        for (int m : wide.toVector()) {
+            if (mask & (1u << (m % 12))) filtered.push_back(m);
+        }
+        const auto view2 = wide.filter(mask);
+        CHECK(view2.toVector() == filtered);
+        REQUIRE(view2.size() == filtered.size());
+        for (std::size_t i = 0; i < filtered.size(); i++) {
+            CHECK(view2[i] == filtered[i]);
+        }
+    }
+
+    SUBCASE("chromaticView") {
+        const auto view = chromaticView({"C2", "E2", "D2"});
+        CHECK(view.toVector() == chromatic({"C2", "E2", "D2"}));
+        CHECK(view.size() == 7);
+        CHECK(view[1] == "Db2");
+        CHECK(view.begin()->size() == 2);
+        CHECK(&view[3] == &view[5]);
+        CHECK(chromaticView({"C2", "C3"}, true)[1] == "C#2");
+        CHECK(view.filter(1u << 3).toVector() == std::vector<std::string>{"Eb2", "Eb2"});
+        CHECK(chromaticView({"blah"}).empty());
+    }
+}
+
+TEST_CASE("Range with a memory resource") {
+    char buffer[8192];
+    std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+    const auto midi = numeric(&arena, {"C2", "F2", "Bb1", "C2"});
+    CHECK(midi.get_allocator().resource() == &arena);
+    CHECK(std::vector<int>(midi.begin(), midi.end()) == numeric({"C2", "F2", "Bb1", "C2"}));
+
+    const auto names = chromatic(&arena, {"C2", "C3"}, true);
+    REQUIRE(names.size() == 13);
+    CHECK(names[1] == "C#2");
+    CHECK(names[12].get_allocator().resource() == &arena);
+    CHECK(chromatic(&arena, {"C2", "blah"}).empty());
+}
@@ -4,6 +4,7 @@
 #include "tonalcpp/helpers.h"
 #include <vector>
 #include <string>
+#include <string_view>
 
 using namespace tonalcpp;
 
@@ -43,6 +44,11 @@ TEST_CASE("scale::get") {
     
     // Test case insensitivity
     CHECK(scale::get("C4 Major").notes == scale::get("C4 major").notes);
+
+    // Slices of a larger string
+    const std::string_view text = "D dorian, then G mixolydian";
+    CHECK(scale::get(text.substr(0, 8)).notes == split("D E F G A B C"));
+    CHECK(scale::get(text.substr(15)).name == "G mixolydian");
 }
 
 TEST_CASE("scale::tokenize") {
@@ -1,6 +1,7 @@
 #include "doctest.h"
 #include "tonalcpp/scale_type.h"
 #include "tonalcpp/pcset.h"
+#include <string_view>
 
 using namespace tonalcpp;
 
@@ -21,6 +22,11 @@ TEST_CASE("Scale Type - dictionary") {
         CHECK(major.aliases == std::vector<std::string>{"ionian"});
         CHECK(major.chroma == "101011010101");
         CHECK(major.normalized == "101010110101");
+
+        const std::string_view names = "ionian|aeolian";
+        CHECK(scale_type::get(names.substr(0, 6)).name == "major");
+        CHECK(scale_type::get(names.substr(7)).name == "minor");
+        CHECK(scale_type::get(names).empty);
     }
 
     SUBCASE("not valid get type") {
@@ -51,6 +57,25 @@ TEST_CASE("Scale Type - dictionary") {
         scale_type::initialize();
     }
 
+    SUBCASE("add many scale types") {
+        REQUIRE(scale_type::addAll({
+            {{"1P", "2M", "3M", "5P", "6m"}, "hindu pentatonic", {"hp"}},
+            {{"1P", "2M", "3M", "5P", "6m"}, "hindu pentatonic", {"hp", "hindu"}},
+        }));
+        CHECK(scale_type::all().size() == 93);
+        CHECK(scale_type::get("hindu").name == "hindu pentatonic");
+        CHECK(scale_type::get(scale_type::get("hp").setNum).name == "hindu pentatonic");
+        CHECK(scale_type::get("major").name == "major");
+
+        // Nothing is added if a definition is not valid
+        CHECK_FALSE(scale_type::addAll({{{"1P", "3M"}, "", {}}}));
+        CHECK_FALSE(scale_type::addAll({{{"1P", "9X"}, "wrong", {}}}));
+        CHECK(scale_type::all().size() == 93);
+
+        scale_type::initialize();
+        CHECK(scale_type::get("hp").empty);
+    }
+
     SUBCASE("major modes") {
         scale_type::ScaleType major = scale_type::get("major");
         std::vector<std::string> chromas = pcset::modes(major.intervals, true);
@@ -0,0 +1,247 @@
+#include "doctest.h"
+#include "tonalcpp/pcset.h"
+#include "tonalcpp/segmentation.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace tonalcpp;
+using segmentation::Segment;
+
+namespace {
+
+// A note: key played from start to end
+struct Note {
+    std::uint32_t start;
+    std::uint32_t end;
+    std::uint8_t key;
+    std::uint8_t channel;
+};
+
+smf::NoteEvents events(std::vector<Note> notes) {
+    smf::NoteEvents result;
+    std::vector<std::pair<std::uint32_t, std::size_t>> order;
+    for (std::size_t n = 0; n < notes.size(); n++) {
+        order.push_back({notes[n].start, n * 2});
+        order.push_back({notes[n].end, n * 2 + 1});
+    }
+    std::stable_sort(order.begin(), order.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+    for (const auto& [tick, index] : order) {
+        const Note& note = notes[index / 2];
+        result.push_back(tick, note.channel, note.key, index % 2 == 0 ? 100 : 0, 0);
+    }
+    return result;
+}
+
+smf::NoteEvents events(std::vector<Note> notes, std::uint8_t channel) {
+    for (Note& note : notes) {
+        note.channel = channel;
+    }
+    return events(notes);
+}
+
+std::vector<std::string> chords(const std::vector<Segment>& segments) {
+    std::vector<std::string> result;
+    for (const Segment& s : segments) {
+        result.push_back(s.chord.str());
+    }
+    return result;
+}
+
+std::vector<std::uint32_t> bounds(const std::vector<Segment>& segments) {
+    std::vector<std::uint32_t> result;
+    for (const Segment& s : segments) {
+        result.push_back(s.start);
+        result.push_back(s.end);
+    }
+    return result;
+}
+
+std::uint16_t mask(const std::vector<std::string>& notes) {
+    return static_cast<std::uint16_t>(pcset::num(notes));
+}
+
+// I - IV - V7 - I, half notes at 480 ticks per quarter
+std::vector<Note> cadence(std::uint32_t offset = 0) {
+    std::vector<Note> notes;
+    const std::vector<std::vector<std::uint8_t>> chords = {
+        {48, 64, 67, 72}, {53, 65, 69, 72}, {43, 65, 71, 74}, {48, 64, 67, 72}};
+    for (std::uint32_t c = 0; c < chords.size(); c++) {
+        for (std::uint8_t key : chords[c]) {
+            notes.push_back({offset + c * 960, offset + (c + 1) * 960, key, 0});
+        }
+    }
+    return notes;
+}
+
+} // namespace
+
+TEST_CASE("segmentation::ChordLabeler") {
+    segmentation::ChordLabeler labeler;
+    CHECK(labeler(mask({"C", "E", "G"}), 0).str() == "CM");
+    CHECK(labeler(mask({"G", "B", "D", "F"}), 7).str() == "G7");
+    CHECK(labeler(mask({"C", "E", "G"}), 0) == intern::intern("CM"));
+    CHECK(labeler.detections() == 2);
+
+    SUBCASE("the bass is the root of inversions") {
+        CHECK(labeler(mask({"C", "E", "G", "A"}), 9).str() == "Am7");
+        CHECK(labeler(mask({"C", "E", "G", "A"}), 0).str() == "C6");
+    }
+
+    SUBCASE("no chord") {
+        CHECK(labeler(0, 0).empty());
+        CHECK(labeler(mask({"C"}), 0).empty());
+        CHECK(labeler(mask({"C", "E", "G"}), 12).empty());
+    }
+}
+
+TEST_CASE("segmentation::segment") {
+    segmentation::ChordLabeler labeler;
+    segmentation::SegmentOptions options;
+
+    SUBCASE("by onsets") {
+        const auto segments = segmentation::segment(events(cadence()), options, labeler);
+        CHECK(chords(segments) == std::vector<std::string>{"CM", "FM", "G7", "CM"});
+        CHECK(bounds(segments) == std::vector<std::uint32_t>{0, 960, 960, 1920, 1920, 2880, 2880, 3840});
+        CHECK(segments[0].mask == mask({"C", "E", "G"}));
+        CHECK(segments[2].bass == 43);
+        CHECK(labeler.detections() == 3);
+    }
+
+    SUBCASE("the detector runs once per distinct chord") {
+        std::vector<Note> notes;
+        for (std::uint32_t i = 0; i < 50; i++) {
+            for (const Note& note : cadence(i * 3840)) {
+                notes.push_back(note);
+            }
+        }
+        const auto segments = segmentation::segment(events(notes), options, labeler);
+        // The last chord of a cadence is merged with the first one of the next
+        CHECK(segments.size() == 50 * 3 + 1);
+        CHECK(labeler.detections() == 3);
+    }
+
+    SUBCASE("adjacent equal chords are merged") {
+        // The bass moves an octave down, and a repeated note is struck again
+        const auto segments = segmentation::segment(events({
+            {0, 480, 48, 0}, {480, 960, 36, 0}, {0, 960, 64, 0},
+            {0, 480, 67, 0}, {480, 960, 67, 0},
+            {960, 1920, 41, 0}, {960, 1920, 69, 0}, {960, 1920, 72, 0},
+        }), options, labeler);
+        CHECK(chords(segments) == std::vector<std::string>{"CM", "FM"});
+        CHECK(bounds(segments) == std::vector<std::uint32_t>{0, 960, 960, 1920});
+        CHECK(segments[0].bass == 48);
+    }
+
+    SUBCASE("silence splits segments") {
+        const auto segments = segmentation::segment(events({
+            {0, 400, 48, 0}, {0, 400, 52, 0}, {0, 400, 55, 0},
+            {480, 900, 48, 0}, {480, 900, 52, 0}, {480, 900, 55, 0},
+        }), options, labeler);
+        CHECK(bounds(segments) == std::vector<std::uint32_t>{0, 400, 480, 900});
+    }
+
+    SUBCASE("notes played by many tracks") {
+        // The second C4 keeps sounding when the first one is released
+        const auto segments = segmentation::segment(events({
+            {0, 960, 60, 0}, {0, 480, 60, 1}, {0, 960, 64, 0}, {0, 960, 67, 0},
+        }), options, labeler);
+        CHECK(bounds(segments) == std::vector<std::uint32_t>{0, 960});
+    }
+
+    SUBCASE("drums are ignored") {
+        smf::NoteEvents drums = events({{0, 960, 36, 0}, {0, 960, 42, 0}, {0, 960, 46, 0}}, 9);
+        CHECK(segmentation::segment(drums, options, labeler).empty());
+        options.drums = true;
+        CHECK(segmentation::segment(drums, options, labeler).size() == 1);
+    }
+
+    SUBCASE("by beats") {
+        options.slicing = segmentation::Slicing::Beats;
+        options.step = 480;
+        // A C major arpeggio over two beats, then a G7 after a silent beat
+        const auto segments = segmentation::segment(events({
+            {0, 240, 48, 0}, {240, 480, 52, 0}, {480, 960, 55, 0}, {480, 960, 60, 0},
+            {1440, 1920, 43, 0}, {1440, 1920, 59, 0}, {1440, 1920, 62, 0}, {1440, 1920, 65, 0},
+        }), options, labeler);
+        REQUIRE(segments.size() == 3);
+        CHECK(segments[0].mask == mask({"C", "E"}));
+        CHECK(segments[0].bass == 48);
+        CHECK(segments[1].mask == mask({"C", "G"}));
+        CHECK(chords({segments[2]}) == std::vector<std::string>{"G7"});
+        CHECK(bounds(segments) == std::vector<std::uint32_t>{0, 480, 480, 960, 1440, 1920});
+
+        options.step = 960;
+        const auto halves = segmentation::segment(events(cadence()), options, labeler);
+        CHECK(chords(halves) == std::vector<std::string>{"CM", "FM", "G7", "CM"});
+
+        options.step = 0;
+        CHECK(segmentation::segment(events(cadence()), options, labeler).empty());
+    }
+
+    SUBCASE("no events") {
+        CHECK(segmentation::segment(smf::NoteEvents(), options, labeler).empty());
+    }
+}
+
+TEST_CASE("segmentation of files") {
+    smf::MidiFile file;
+    file.empty = false;
+    file.format = 0;
+    file.tracks = 1;
+    file.division = 480;
+    file.events = events(cadence());
+
+    SUBCASE("beats of the file division") {
+        segmentation::SegmentOptions options;
+        options.slicing = segmentation::Slicing::Beats;
+        const auto segments = segmentation::segment(file, options);
+        CHECK(chords(segments) == std::vector<std::string>{"CM", "FM", "G7", "CM"});
+        CHECK(bounds(segments).back() == 3840);
+
+        file.division = -(25 << 8) + 40;  // SMPTE time
+        CHECK(segmentation::segment(file, options).empty());
+    }
+
+    SUBCASE("segmentBatch") {
+        std::vector<smf::MidiFile> files(20, file);
+        for (std::size_t i = 0; i < files.size(); i += 3) {
+            files[i].events = events(cadence(static_cast<std::uint32_t>(i) * 100));
+        }
+        thread_pool::ThreadPool pool(3);
+        const auto result = segmentation::segmentBatch(files.data(), files.size(), {}, pool);
+        REQUIRE(result.size() == files.size());
+        for (std::size_t i = 0; i < files.size(); i++) {
+            const auto expected = segmentation::segment(files[i]);
+            CHECK(bounds(result[i]) == bounds(expected));
+            CHECK(chords(result[i]) == chords(expected));
+        }
+    }
+
+    SUBCASE("segmentFiles") {
+        // C major: note on C4, E4 and G4 with running status, off after 480 ticks
+        const std::vector<std::uint8_t> bytes = {
+            'M', 'T', 'h', 'd', 0, 0, 0, 6, 0, 0, 0, 1, 0x01, 0xE0,
+            'M', 'T', 'r', 'k', 0, 0, 0, 20,
+            0x00, 0x90, 60, 100, 0x00, 64, 100, 0x00, 67, 100,
+            0x83, 0x60, 60, 0, 0x00, 64, 0, 0x00, 67, 0};
+        const std::string path = "tonalcpp_test_segmentation.mid";
+        {
+            std::ofstream out(path, std::ios::binary);
+            out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        }
+        const std::vector<std::string> paths = {path, "does/not/exist.mid", path};
+        thread_pool::ThreadPool pool(2);
+        const auto result = segmentation::segmentFiles(paths.data(), paths.size(), {}, pool);
+        REQUIRE(result.size() == 3);
+        CHECK(chords(result[0]) == std::vector<std::string>{"CM"});
+        CHECK(bounds(result[0]) == std::vector<std::uint32_t>{0, 480});
+        CHECK(result[1].empty());
+        CHECK(chords(result[2]) == chords(result[0]));
+        std::remove(path.c_str());
+    }
+}
@@ -0,0 +1,371 @@
+#include "doctest.h"
+#include "tonalcpp/chord_detect.h"
+#include "tonalcpp/helpers.h"
+#include "tonalcpp/midi.h"
+#include "tonalcpp/smf.h"
+#include "tonalcpp/voicing.h"
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace tonalcpp;
+
+namespace {
+
+using Bytes = std::vector<std::uint8_t>;
+
+void append(Bytes& bytes, const Bytes& more) {
+    bytes.insert(bytes.end(), more.begin(), more.end());
+}
+
+void appendU32(Bytes& bytes, std::uint32_t value) {
+    append(bytes, {std::uint8_t(value >> 24), std::uint8_t(value >> 16), std::uint8_t(value >> 8),
+                   std::uint8_t(value)});
+}
+
+Bytes header(int format, int tracks, int division) {
+    Bytes bytes = {'M', 'T', 'h', 'd'};
+    appendU32(bytes, 6);
+    append(bytes, {std::uint8_t(format >> 8), std::uint8_t(format), std::uint8_t(tracks >> 8),
+                   std::uint8_t(tracks), std::uint8_t(division >> 8), std::uint8_t(division)});
+    return bytes;
+}
+
+Bytes chunk(const char* type, const Bytes& data) {
+    Bytes bytes(type, type + 4);
+    appendU32(bytes, static_cast<std::uint32_t>(data.size()));
+    append(bytes, data);
+    return bytes;
+}
+
+Bytes midiFile(int format, const std::vector<Bytes>& tracks, int division = 480) {
+    Bytes bytes = header(format, static_cast<int>(tracks.size()), division);
+    for (const Bytes& track : tracks) {
+        append(bytes, chunk("MTrk", track));
+    }
+    return bytes;
+}
+
+smf::MidiFile parse(const Bytes& bytes) {
+    return smf::parse(bytes.data(), bytes.size());
+}
+
+const Bytes END_OF_TRACK = {0x00, 0xFF, 0x2F, 0x00};
+
+} // namespace
+
+TEST_CASE("smf::parse") {
+    SUBCASE("format 0 with running status") {
+        Bytes track = {
+            0x00, 0x90, 60, 100,      // C4 on
+            0x00, 64, 90,             // E4 on (running status)
+            0x60, 60, 0,              // C4 off (note on with velocity 0)
+            0x00, 0x81, 64, 40,       // E4 off on channel 2
+        };
+        append(track, END_OF_TRACK);
+        const smf::MidiFile file = parse(midiFile(0, {track}, 96));
+
+        REQUIRE_FALSE(file.empty);
+        CHECK(file.format == 0);
+        CHECK(file.tracks == 1);
+        CHECK(file.division == 96);
+        REQUIRE(file.events.size() == 4);
+        CHECK(file.events.ticks == std::vector<std::uint32_t>{0, 0, 96, 96});
+        CHECK(file.events.keys == std::vector<std::uint8_t>{60, 64, 60, 64});
+        CHECK(file.events.velocities == std::vector<std::uint8_t>{100, 90, 0, 0});
+        CHECK(file.events.channels == std::vector<std::uint8_t>{0, 0, 0, 1});
+        CHECK(file.events.isNoteOn(0));
+        CHECK_FALSE(file.events.isNoteOn(2));
+    }
+
+    SUBCASE("variable length delta times") {
+        Bytes track = {
+            0x81, 0x00, 0x90, 60, 100,               // 128
+            0xFF, 0xFF, 0xFF, 0x7F, 0x80, 60, 0,     // + 0x0FFFFFFF
+        };
+        append(track, END_OF_TRACK);
+        const smf::MidiFile file = parse(midiFile(0, {track}));
+        REQUIRE(file.events.size() == 2);
+        CHECK(file.events.ticks[0] == 128);
+        CHECK(file.events.ticks[1] == 128 + 0x0FFFFFFF);
+
+        // More than 4 bytes
+        Bytes invalid = {0x81, 0x81, 0x81, 0x81, 0x00, 0x90, 60, 100};
+        CHECK(parse(midiFile(0, {invalid})).empty);
+    }
+
+    SUBCASE("other events are skipped") {
+        Bytes track = {
+            0x00, 0xFF, 0x51, 0x03, 0x07, 0xA1, 0x20,  // Tempo
+            0x00, 0xF0, 0x03, 0x43, 0x12, 0xF7,        // Sysex
+            0x00, 0xC0, 0x05,                          // Program change
+            0x00, 0xB0, 0x07, 0x64,                    // Control change
+            0x00, 0xE0, 0x00, 0x40,                    // Pitch bend
+            0x00, 0x90, 67, 80,
+            0x10, 0xD0, 0x10,                          // Channel pressure
+            0x00, 0x20,                                // Channel pressure (running status)
+            0x10, 0x80, 67, 0x40,
+        };
+        append(track, END_OF_TRACK);
+        append(track, {0x00, 0x90, 72, 100});  // After the end of track
+        const smf::MidiFile file = parse(midiFile(0, {track}));
+        REQUIRE_FALSE(file.empty);
+        CHECK(file.events.keys == std::vector<std::uint8_t>{67, 67});
+        CHECK(file.events.ticks == std::vector<std::uint32_t>{0, 32});
+    }
+
+    SUBCASE("format 1 tracks are merged by tick") {
+        Bytes tempo = {0x00, 0xFF, 0x51, 0x03, 0x07, 0xA1, 0x20};
+        Bytes bass = {0x00, 0x90, 36, 100, 0x83, 0x60, 0x80, 36, 0};
+        Bytes melody = {0x00, 0x91, 72, 100, 0x81, 0x70, 0x81, 72, 0, 0x00, 0x91, 74, 100};
+        append(tempo, END_OF_TRACK);
+        append(bass, END_OF_TRACK);
+        append(melody, END_OF_TRACK);
+        Bytes bytes = midiFile(1, {tempo, bass});
+        append(bytes, chunk("XFIH", {1, 2, 3}));  // Unknown chunks are skipped
+        append(bytes, chunk("MTrk", melody));
+        const smf::MidiFile file = parse(bytes);
+
+        REQUIRE_FALSE(file.empty);
+        CHECK(file.format == 1);
+        CHECK(file.tracks == 3);
+        CHECK(file.events.ticks == std::vector<std::uint32_t>{0, 0, 240, 240, 480});
+        CHECK(file.events.keys == std::vector<std::uint8_t>{36, 72, 72, 74, 36});
+        CHECK(file.events.tracks == std::vector<std::uint16_t>{1, 2, 2, 2, 1});
+        CHECK(file.events.channels == std::vector<std::uint8_t>{0, 1, 1, 1, 0});
+
+        // Merging keeps the memory reserved for the events
+        smf::MidiFile reused;
+        REQUIRE(smf::parse(bytes.data(), bytes.size(), reused));
+        const std::uint32_t* ticks = reused.events.ticks.data();
+        const std::uint16_t* tracks = reused.events.tracks.data();
+        REQUIRE(smf::parse(bytes.data(), bytes.size(), reused));
+        CHECK(reused.events.ticks.data() == ticks);
+        CHECK(reused.events.tracks.data() == tracks);
+        CHECK(reused.events.keys == file.events.keys);
+    }
+
+    SUBCASE("SMPTE division") {
+        const smf::MidiFile file = parse(midiFile(0, {END_OF_TRACK}, 0xE728));  // -25 fps, 40 ticks
+        REQUIRE_FALSE(file.empty);
+        CHECK(file.division < 0);
+        CHECK((file.division >> 8) == -25);
+        CHECK((file.division & 0xFF) == 40);
+        CHECK(file.events.empty());
+    }
+
+    SUBCASE("invalid files") {
+        CHECK(smf::parse(nullptr, 0).empty);
+        CHECK(parse({}).empty);
+        CHECK(parse({'M', 'T', 'h', 'd', 0, 0, 0, 6, 0}).empty);
+        CHECK(parse(chunk("MTrk", END_OF_TRACK)).empty);
+        // Format 2 (independent sequences) is not supported
+        CHECK(parse(midiFile(2, {END_OF_TRACK})).empty);
+        // Truncated chunk
+        Bytes truncated = midiFile(0, {{0x00, 0x90, 60, 100}});
+        truncated.pop_back();
+        CHECK(parse(truncated).empty);
+        // Truncated event
+        CHECK(parse(midiFile(0, {{0x00, 0x90, 60}})).empty);
+        // Data byte without running status
+        CHECK(parse(midiFile(0, {{0x00, 60, 100}})).empty);
+        // Running status is cancelled by meta events
+        CHECK(parse(midiFile(0, {{0x00, 0x90, 60, 100, 0x00, 0xFF, 0x01, 0x00, 0x00, 60, 0}})).empty);
+        // System common messages are not allowed in files
+        CHECK(parse(midiFile(0, {{0x00, 0xF2, 0x00, 0x00}})).empty);
+    }
+
+    SUBCASE("reuse a result") {
+        Bytes track = {0x00, 0x90, 60, 100, 0x10, 60, 0};
+        append(track, END_OF_TRACK);
+        const Bytes bytes = midiFile(0, {track});
+
+        smf::MidiFile file;
+        CHECK(smf::parse(bytes.data(), bytes.size(), file));
+        CHECK(file.events.size() == 2);
+        const std::uint32_t* ticks = file.events.ticks.data();
+        CHECK(smf::parse(bytes.data(), bytes.size(), file));
+        CHECK(file.events.size() == 2);
+        CHECK(file.events.ticks.data() == ticks);
+
+        CHECK_FALSE(smf::parse(bytes.data(), 10, file));
+        CHECK(file.empty);
+        CHECK(file.events.empty());
+    }
+
+    SUBCASE("detect the chords of the events") {
+        Bytes track = {0x00, 0x90, 62, 100, 0x00, 65, 100, 0x00, 69, 100, 0x00, 72, 100};
+        append(track, END_OF_TRACK);
+        const smf::MidiFile file = parse(midiFile(0, {track}));
+
+        std::vector<std::string> notes;
+        for (std::size_t i = 0; i < file.events.size(); i++) {
+            if (file.events.ticks[i] == 0 && file.events.isNoteOn(i)) {
+                notes.push_back(midi::midiToNoteName(file.events.keys[i]));
+            }
+        }
+        CHECK(notes == std::vector<std::string>{"D4", "F4", "A4", "C5"});
+        REQUIRE_FALSE(chord_detect::detect(notes).empty());
+        CHECK(chord_detect::detect(notes)[0] == "Dm7");
+    }
+}
+
+TEST_CASE("smf::load") {
+    Bytes track = {0x00, 0x90, 60, 100, 0x60, 0x80, 60, 64};
+    append(track, END_OF_TRACK);
+    const Bytes bytes = midiFile(0, {track});
+    const std::string path = "tonalcpp_test_smf.mid";
+    {
+        std::ofstream out(path, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    SUBCASE("mapped file") {
+        helpers::MappedFile mapped(path);
+        REQUIRE(mapped.isOpen());
+        REQUIRE(mapped.size() == bytes.size());
+        CHECK(Bytes(mapped.data(), mapped.data() + mapped.size()) == bytes);
+
+        helpers::MappedFile moved(std::move(mapped));
+        CHECK(moved.isOpen());
+        CHECK(moved.size() == bytes.size());
+        CHECK_FALSE(mapped.isOpen());
+
+        CHECK_FALSE(helpers::MappedFile("does/not/exist.mid").isOpen());
+    }
+
+    SUBCASE("load") {
+        const smf::MidiFile file = smf::load(path);
+        REQUIRE_FALSE(file.empty);
+        CHECK(file.events.keys == std::vector<std::uint8_t>{60, 60});
+        CHECK(file.events.ticks == std::vector<std::uint32_t>{0, 96});
+        CHECK(smf::load("does/not/exist.mid").empty);
+    }
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("smf::Writer") {
+    smf::Writer writer;
+
+    SUBCASE("bytes of a note") {
+        writer.note(0, 480, 60);
+        Bytes track = {0x00, 0x90, 60, 100, 0x83, 0x60, 60, 0};
+        append(track, END_OF_TRACK);
+        CHECK(writer.finish() == midiFile(0, {track}));
+    }
+
+    SUBCASE("long gaps keep the ticks") {
+        // Deltas have 28 bits: the gap is split with empty text events
+        writer.note(0, 10, 60);
+        writer.note(0x30000000, 10, 62);
+        const std::vector<std::uint8_t>& bytes = writer.finish();
+        const smf::MidiFile file = smf::parse(bytes.data(), bytes.size());
+
+        REQUIRE_FALSE(file.empty);
+        CHECK(file.events.ticks == std::vector<std::uint32_t>{0, 10, 0x30000000, 0x3000000A});
+        CHECK(file.events.keys == std::vector<std::uint8_t>{60, 60, 62, 62});
+        CHECK(file.events.velocities == std::vector<std::uint8_t>{100, 0, 100, 0});
+    }
+
+    SUBCASE("note offs are written in time order") {
+        writer.note(0, 960, 48, 80);
+        writer.note(0, 240, 64, 90, 1);
+        writer.note(240, 240, 65, 90, 1);
+        writer.note(960, 100, 48, 70);  // Played again when it's released
+        const std::vector<std::uint8_t>& bytes = writer.finish();
+        const smf::MidiFile file = smf::parse(bytes.data(), bytes.size());
+
+        REQUIRE_FALSE(file.empty);
+        CHECK(file.format == 0);
+        CHECK(file.division == 480);
+        CHECK(file.events.ticks == std::vector<std::uint32_t>{0, 0, 240, 240, 480, 960, 960, 1060});
+        CHECK(file.events.keys == std::vector<std::uint8_t>{48, 64, 64, 65, 65, 48, 48, 48});
+        CHECK(file.events.velocities == std::vector<std::uint8_t>{80, 90, 0, 90, 0, 0, 70, 0});
+        CHECK(file.events.channels == std::vector<std::uint8_t>{0, 1, 1, 1, 1, 0, 0, 0});
+    }
+
+    SUBCASE("events before the last one are moved to it") {
+        writer.note(480, 10, 60);
+        writer.note(0, 10, 62);
+        const smf::MidiFile file = parse(writer.finish());
+        CHECK(file.events.ticks == std::vector<std::uint32_t>{480, 480, 490, 490});
+    }
+
+    SUBCASE("tempo") {
+        writer.tempo(0, 500000);
+        writer.note(0, 480, 60);
+        writer.tempo(480, 250000);
+        writer.note(480, 480, 62);
+        Bytes track = {0x00, 0xFF, 0x51, 0x03, 0x07, 0xA1, 0x20, 0x00, 0x90, 60, 100,
+                       0x83, 0x60, 60, 0, 0x00, 0xFF, 0x51, 0x03, 0x03, 0xD0, 0x90,
+                       0x00, 0x90, 62, 100, 0x83, 0x60, 62, 0};
+        append(track, END_OF_TRACK);
+        CHECK(writer.finish() == midiFile(0, {track}));
+    }
+
+    SUBCASE("tracks") {
+        writer.note(0, 480, 36);
+        writer.beginTrack();
+        writer.note(240, 480, 72, 100, 1);
+        const smf::MidiFile file = parse(writer.finish());
+        CHECK(file.format == 1);
+        CHECK(file.tracks == 2);
+        CHECK(file.events.ticks == std::vector<std::uint32_t>{0, 240, 480, 720});
+        CHECK(file.events.tracks == std::vector<std::uint16_t>{0, 1, 0, 1});
+    }
+
+    SUBCASE("chords and progressions") {
+        writer.chord(0, 480, std::vector<std::string>{"C4", "E4", "x", "G4"});
+        const std::vector<voicing::Voicing> voicings = {
+            voicing::fromNames({"D3", "F3", "A3", "C4"}), voicing::Voicing(), voicing::fromNames({"G3", "B3", "F4"})};
+        CHECK(writer.progression(480, voicings.data(), voicings.size(), 960) == 480 + 3 * 960);
+        const smf::MidiFile file = parse(writer.finish());
+
+        std::vector<std::uint8_t> onsets;
+        for (std::size_t i = 0; i < file.events.size(); i++) {
+            if (file.events.isNoteOn(i)) {
+                onsets.push_back(file.events.keys[i]);
+            }
+        }
+        CHECK(onsets == std::vector<std::uint8_t>{60, 64, 67, 50, 53, 57, 60, 55, 59, 65});
+        CHECK(file.events.ticks.back() == 480 + 3 * 960);
+        CHECK(file.events.ticks[file.events.size() - 4] == 2400);
+    }
+
+    SUBCASE("clear keeps the memory") {
+        for (std::uint32_t i = 0; i < 64; i++) {
+            writer.note(i * 120, 120, static_cast<std::uint8_t>(60 + i % 12));
+        }
+        const Bytes first = writer.finish();
+        const std::uint8_t* data = writer.finish().data();
+        writer.clear();
+        for (std::uint32_t i = 0; i < 64; i++) {
+            writer.note(i * 120, 120, static_cast<std::uint8_t>(60 + i % 12));
+        }
+        CHECK(writer.finish() == first);
+        CHECK(writer.finish().data() == data);
+    }
+
+    SUBCASE("an empty file") {
+        const smf::MidiFile file = parse(writer.finish());
+        CHECK_FALSE(file.empty);
+        CHECK(file.tracks == 0);
+    }
+
+    SUBCASE("save") {
+        const std::string path = "tonalcpp_test_writer.mid";
+        const std::vector<voicing::Voicing> voicings = {
+            voicing::fromNames({"C3", "E3", "G3"}), voicing::fromNames({"F3", "A3", "C4"})};
+        REQUIRE(smf::saveProgression(path, voicings));
+        const smf::MidiFile file = smf::load(path);
+        REQUIRE_FALSE(file.empty);
+        CHECK(file.events.size() == 12);
+        CHECK(file.events.ticks.back() == 2 * 1920);
+        std::remove(path.c_str());
+
+        CHECK_FALSE(writer.save("does/not/exist.mid"));
+    }
+}
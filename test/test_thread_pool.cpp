@@ -0,0 +1,65 @@
+#include "doctest.h"
+#include "tonalcpp/thread_pool.h"
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+using namespace tonalcpp::thread_pool;
+
+TEST_CASE("ThreadPool parallelFor") {
+    SUBCASE("visits every index once") {
+        ThreadPool pool(4);
+        CHECK(pool.size() == 4);
+        std::vector<int> visits(1000, 0);
+        pool.parallelFor(visits.size(), [&](std::size_t begin, std::size_t end, std::size_t) {
+            for (std::size_t i = begin; i < end; i++) {
+                visits[i]++;
+            }
+        }, 7);
+        CHECK(std::count(visits.begin(), visits.end(), 1) == 1000);
+    }
+
+    SUBCASE("worker numbers") {
+        ThreadPool pool(3);
+        std::vector<std::size_t> sums(pool.size(), 0);
+        pool.parallelFor(100, [&](std::size_t begin, std::size_t end, std::size_t worker) {
+            REQUIRE(worker < 3);
+            for (std::size_t i = begin; i < end; i++) {
+                sums[worker] += i;
+            }
+        });
+        CHECK(std::accumulate(sums.begin(), sums.end(), std::size_t(0)) == 4950);
+    }
+
+    SUBCASE("several loops and empty loops") {
+        ThreadPool pool(2);
+        std::atomic<int> total{0};
+        for (int loop = 0; loop < 20; loop++) {
+            pool.parallelFor(10, [&](std::size_t begin, std::size_t end, std::size_t) {
+                total += static_cast<int>(end - begin);
+            });
+        }
+        pool.parallelFor(0, [&](std::size_t, std::size_t, std::size_t) { total = -1; });
+        CHECK(total == 200);
+    }
+
+    SUBCASE("exceptions") {
+        ThreadPool pool(2);
+        std::atomic<int> done{0};
+        CHECK_THROWS_AS(pool.parallelFor(10, [&](std::size_t begin, std::size_t, std::size_t) {
+            done++;
+            if (begin == 3) throw std::runtime_error("failed");
+        }), std::runtime_error);
+        // The other chunks are still run
+        CHECK(done == 10);
+        pool.parallelFor(1, [&](std::size_t, std::size_t, std::size_t) { done++; });
+        CHECK(done == 11);
+    }
+
+    SUBCASE("default size") {
+        ThreadPool pool;
+        CHECK(pool.size() >= 1);
+    }
+}
@@ -0,0 +1,128 @@
+#include "doctest.h"
+#include "tonalcpp/tuning.h"
+#include "test_helpers.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace tonalcpp;
+using namespace tonalcpp::tuning;
+
+static const std::string EDO12 =
+    "! 12edo.scl\n"
+    "!\n"
+    "12 tone equal temperament\n"
+    " 12\n"
+    "!\n"
+    " 100.0\n 200.0\n 300.0\n 400.0\n 500.0\n 600.0\n"
+    " 700.0\n 800.0\n 900.0\n 1000.0\n 1100.0\n 2/1\n";
+
+static const std::string JUST5 =
+    "! just.scl\n"
+    "5-limit major scale\n"
+    "7\n"
+    "9/8\n5/4\n4/3\n3/2\n5/3\n15/8\n2\n";
+
+TEST_CASE("tuning") {
+    SUBCASE("parseScl") {
+        auto scale = parseScl(EDO12);
+        CHECK(!scale.empty);
+        CHECK(scale.description == "12 tone equal temperament");
+        CHECK(scale.cents.size() == 12);
+        CHECK(approxEqual(scale.cents[0], 100.0));
+        CHECK(approxEqual(scale.cents[11], 1200.0));
+        
+        auto just = parseScl(JUST5);
+        CHECK(just.cents.size() == 7);
+        CHECK(approxEqual(just.cents[3], 701.955, 0.001));
+        
+        CHECK(parseScl("").empty);
+        CHECK(parseScl("desc\n3\n100.0\n").empty);
+        CHECK(parseScl("desc\n1\nabc\n").empty);
+    }
+
+    SUBCASE("parseKbm") {
+        auto kbm = parseKbm(
+            "! whites.kbm\n12\n0\n127\n60\n69\n440.0\n7\n"
+            "0\nx\n1\nx\n2\n3\nx\n4\nx\n5\nx\n6\n");
+        CHECK(!kbm.empty);
+        CHECK(kbm.size == 12);
+        CHECK(kbm.referenceNote == 69);
+        CHECK(kbm.octaveDegree == 7);
+        CHECK(kbm.mapping == std::vector<int>{0, -1, 1, -1, 2, 3, -1, 4, -1, 5, -1, 6});
+        
+        CHECK(parseKbm("12\n0\n").empty);
+    }
+
+    SUBCASE("12-TET from scl matches midiToFreq") {
+        Tuning edo(parseScl(EDO12));
+        CHECK(!edo.empty());
+        for (int midi = 0; midi < 128; midi++) {
+            CHECK(approxEqual(edo.midiToFreq(midi), midi::midiToFreq(midi), 1e-6));
+            CHECK(edo.degree(midi) == midi % 12);
+        }
+        CHECK(approxEqual(midi::midiToFreq(69, edo.frequencies()), 440.0, 1e-9));
+    }
+
+    SUBCASE("just intonation on white keys") {
+        auto kbm = parseKbm(
+            "12\n0\n127\n60\n60\n261.6255653005986\n7\n"
+            "0\nx\n1\nx\n2\n3\nx\n4\nx\n5\nx\n6\n");
+        Tuning just(parseScl(JUST5), kbm);
+        
+        const double c4 = 261.6255653005986;
+        CHECK(approxEqual(just.midiToFreq(60), c4));
+        CHECK(approxEqual(just.midiToFreq(64), c4 * 5 / 4));
+        CHECK(approxEqual(just.midiToFreq(67), c4 * 3 / 2));
+        CHECK(approxEqual(just.midiToFreq(72), c4 * 2));
+        CHECK(just.frequencies().reference() == c4);
+        CHECK(approxEqual(just.midiToFreq(59), c4 * 15 / 16));
+        CHECK(just.midiToFreq(61) == 0.0);
+        CHECK(just.degree(61) == -1);
+        CHECK(just.degree(67) == 4);
+        
+        std::vector<int> notes = {60, 62, 64};
+        std::vector<double> freqs(notes.size());
+        just.midiToFreq(notes.data(), notes.size(), freqs.data());
+        CHECK(approxEqual(freqs[1], c4 * 9 / 8));
+        
+        // Nearest lookups skip unmapped keys
+        auto nearest = just.freqToNearest(c4 * 5 / 4 * 1.01);
+        CHECK(nearest.midi == 64);
+        CHECK(nearest.degree == 2);
+        CHECK(approxEqual(nearest.cents, 17.226, 0.001));
+        CHECK(just.freqToNearest(277.18).midi != 61);
+        CHECK(just.freqToNearest(0).midi == -1);
+        
+        std::vector<float> input = {261.63f, 392.5f};
+        std::vector<int> midiOut(input.size());
+        std::vector<float> centsOut(input.size());
+        just.freqToNearest(input.data(), input.size(), midiOut.data(), centsOut.data());
+        CHECK(midiOut == std::vector<int>{60, 67});
+    }
+
+    SUBCASE("invalid tunings are empty") {
+        CHECK(Tuning(ScalaScale()).empty());
+        auto unmappedReference = parseKbm("12\n0\n127\n60\n61\n440\n12\n0\nx\n");
+        CHECK(Tuning(parseScl(EDO12), unmappedReference).empty());
+    }
+
+    SUBCASE("load") {
+        const auto dir = std::filesystem::temp_directory_path();
+        const std::string path = (dir / "tonalcpp_test_just.scl").string();
+        {
+            std::ofstream file(path);
+            file << JUST5;
+        }
+        Tuning loaded = load(path);
+        CHECK(!loaded.empty());
+        CHECK(approxEqual(loaded.midiToFreq(60), 261.6255653005986));
+        CHECK(approxEqual(loaded.midiToFreq(61), 261.6255653005986 * 9 / 8));
+        std::remove(path.c_str());
+        
+        CHECK(load(path).empty());
+        CHECK(loadScl("/non/existent.scl").empty);
+    }
+}
@@ -1,5 +1,6 @@
 #include "doctest.h"
 #include "tonalcpp/voice_leading.h"
+#include "tonalcpp/voicing.h"
 #include <vector>
 #include <string>
 
@@ -16,4 +17,56 @@ TEST_CASE("VoiceLeading topNoteDiff") {
     std::vector<std::string> expected = {"C4", "E4", "F4", "A4"};
     
     CHECK(topNoteDiff(voicings, lastVoicing) == expected);
-}
\ No newline at end of file
+}
+
+TEST_CASE("VoiceLeading metrics") {
+    using tonalcpp::voicing::fromNames;
+    const Voicing from = fromNames({"C4", "E4", "G4", "B4"});
+    const Voicing to = fromNames({"C4", "E4", "F4", "A4"});
+    const Voicing triad = fromNames({"D4", "F4", "A4"});
+
+    SUBCASE("top note and bass") {
+        CHECK(TopNote()(from, to) == 2);
+        CHECK(Bass()(from, triad) == 2);
+    }
+
+    SUBCASE("total motion") {
+        CHECK(TotalMotion()(from, to) == 4);
+        // B4 is paired with the top of the triad (A4)
+        CHECK(TotalMotion()(from, triad) == 2 + 1 + 2 + 2);
+    }
+
+    SUBCASE("minimal assignment") {
+        CHECK(MinimalAssignment()(from, to) == 4);
+        CHECK(MinimalAssignment()(to, from) == 4);
+        // E4 and F4 merge into F4
+        CHECK(MinimalAssignment()(to, triad) == 2 + 1 + 0 + 0);
+        CHECK(MinimalAssignment()(from, from) == 0);
+    }
+
+    SUBCASE("lost common tones") {
+        CHECK(LostCommonTones()(from, to) == 2);
+        CHECK(LostCommonTones()(to, triad) == 2);
+    }
+
+    SUBCASE("composition") {
+        CHECK(weighted(3, TopNote())(from, to) == 6);
+        CHECK(weighted<Bass>(0)(from, triad) == 0);
+        CHECK(sum(TopNote(), weighted(2, TotalMotion()))(from, to) == 2 + 8);
+        CHECK(sum()(from, to) == 0);
+    }
+
+    SUBCASE("score all candidates") {
+        const std::vector<Voicing> candidates = {from, to, triad};
+        int scores[3];
+        scoreAll<TopNote>(to, candidates.data(), candidates.size(), scores);
+        CHECK(scores[0] == 2);
+        CHECK(scores[1] == 0);
+        CHECK(scores[2] == 0);
+
+        CHECK(best<TopNote>(from, candidates.data(), candidates.size()) == 0);
+        CHECK(best(triad, candidates.data(), candidates.size(), sum(Bass(), TopNote())) == 2);
+        CHECK(best<TopNote>(Voicing(), candidates.data(), candidates.size()) == 0);
+        CHECK(best<TopNote>(from, candidates.data(), 0) == 0);
+    }
+}
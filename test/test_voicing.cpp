@@ -4,6 +4,10 @@
 #include "tonalcpp/voice_leading.h"
 #include <vector>
 #include <string>
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <memory_resource>
 
 using namespace tonalcpp::voicing;
 using namespace tonalcpp::voicing_dictionary;
@@ -50,6 +54,76 @@ TEST_CASE("Voicing search") {
     }
 }
 
+TEST_CASE("Voicing search with a memory resource") {
+    char buffer[16384];
+    std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+    const auto result = search(&arena, "Dm7", {"F3", "A4"}, lefthand);
+    const auto expected = search("Dm7", {"F3", "A4"}, lefthand);
+    REQUIRE(result.size() == expected.size());
+    CHECK(result.get_allocator().resource() == &arena);
+    for (std::size_t i = 0; i < result.size(); i++) {
+        CHECK(std::vector<std::string>(result[i].begin(), result[i].end()) == expected[i]);
+        CHECK(result[i].get_allocator().resource() == &arena);
+    }
+
+    // Custom dictionaries
+    const VoicingDictionary custom = {{"m7", {"3m 5P 7m"}}};
+    CHECK(search(&arena, "Dm7", {"F3", "A4"}, custom).size() == search("Dm7", {"F3", "A4"}, custom).size());
+    CHECK(search(&arena, "blah", {"F3", "A4"}).empty());
+}
+
+TEST_CASE("Voicing searchMidi") {
+    SUBCASE("C major triad inversions") {
+        auto result = searchMidi("C", {"C3", "C5"}, triads);
+        REQUIRE(result.size() == 5);
+        CHECK(result[0].size == 3);
+        CHECK(result[0][0] == 48);
+        CHECK(result[0][1] == 52);
+        CHECK(result[0][2] == 55);
+        CHECK(result[2].bass() == 52);
+        CHECK(result[2].top() == 60);
+        CHECK(result[2].names() == std::vector<std::string>{"E3", "G3", "C4"});
+    }
+
+    SUBCASE("keeps the spelling") {
+        auto result = searchMidi("Ebm", {"C3", "C4"}, triads);
+        REQUIRE_FALSE(result.empty());
+        CHECK(result[0].names() == std::vector<std::string>{"Eb3", "Gb3", "Bb3"});
+        CHECK(result[0].name(1) == "Gb3");
+    }
+
+    SUBCASE("same voicings as search") {
+        const std::vector<std::string> chords = {"C", "F#m", "Bb^7", "Dbm7", "E7", "Abo"};
+        for (const auto& chord : chords) {
+            std::vector<std::vector<std::string>> names;
+            for (const auto& v : searchMidi(chord, {"E2", "G5"}, all)) {
+                names.push_back(v.names());
+            }
+            CHECK(names == search(chord, {"E2", "G5"}, all));
+        }
+    }
+
+    SUBCASE("integer core") {
+        std::vector<Voicing> result;
+        const std::vector<VoicingPattern> patterns = {compilePattern("1P 3M 5P")};
+        searchMidi(2, patterns.data(), patterns.size(), {60, 72}, result);
+        REQUIRE(result.size() == 1);
+        CHECK(result[0].names() == std::vector<std::string>{"D4", "F#4", "A4"});
+    }
+
+    SUBCASE("compiled dictionary") {
+        const CompiledDictionary compiled(lefthand);
+        CHECK(search("Dm7", {"E3", "G5"}, compiled) == search("Dm7", {"E3", "G5"}, lefthand));
+        VoicingDictionary custom = lefthand;
+        CHECK(search("Dm7", {"E3", "G5"}, custom) == search("Dm7", {"E3", "G5"}, lefthand));
+    }
+
+    SUBCASE("invalid chord or range") {
+        CHECK(searchMidi("nonexistent", {"C3", "C5"}, triads).empty());
+        CHECK(searchMidi("C", {"C3", "blah"}, triads).empty());
+    }
+}
+
 TEST_CASE("Voicing get") {
     SUBCASE("get default") {
         std::vector<std::string> expected = {"F3", "A3", "C4", "E4"};
@@ -80,4 +154,161 @@ TEST_CASE("Voicing sequence") {
     
     auto result = sequence({"C", "F", "G"}, {"F3", "A4"}, triads, topNoteDiff);
     CHECK(result == expected);
-}
\ No newline at end of file
+}
+
+TEST_CASE("Voicing fromNames") {
+    auto voicing = fromNames({"C4", "Eb4", "G4"});
+    REQUIRE(voicing.size == 3);
+    CHECK(voicing.bass() == 60);
+    CHECK(voicing.top() == 67);
+    CHECK(voicing.names() == std::vector<std::string>{"C4", "Eb4", "G4"});
+    CHECK(fromNames({"C4", "blah"}).empty());
+    CHECK(fromNames({}).empty());
+}
+
+TEST_CASE("Voicing sequenceOptimal") {
+    SUBCASE("better than greedy") {
+        // Greedy picks the closest top note (E4) and then has to jump to C5
+        const std::vector<std::vector<Voicing>> candidates = {
+            {fromNames({"C4", "E4"}), fromNames({"G4", "B4"})},
+            {fromNames({"A4", "C5"})}
+        };
+        auto chosen = sequenceOptimal(candidates, SequenceWeights(), fromNames({"C4", "F4"}));
+        CHECK(chosen == std::vector<std::size_t>{1, 0});
+    }
+
+    SUBCASE("same as brute force") {
+        auto candidates = std::vector<std::vector<Voicing>>{
+            searchMidi("C^7", {"E3", "G5"}, all),
+            searchMidi("Am7", {"E3", "G5"}, all),
+            searchMidi("Dm7", {"E3", "G5"}, all),
+            searchMidi("G7", {"E3", "G5"}, all)
+        };
+        const SequenceWeights weights{1, 1, 2};
+        auto chosen = sequenceOptimal(candidates, weights);
+
+        // Total cost of a path using the single-transition cost
+        auto pathCost = [&](const std::vector<std::size_t>& path) {
+            int total = 0;
+            for (std::size_t i = 1; i < path.size(); i++) {
+                const Voicing& a = candidates[i - 1][path[i - 1]];
+                const Voicing& b = candidates[i][path[i]];
+                int motion = 0;
+                for (std::size_t v = 0; v < std::max(a.size, b.size); v++) {
+                    motion += std::abs(a.midi[std::min<std::size_t>(v, a.size - 1)] -
+                                       b.midi[std::min<std::size_t>(v, b.size - 1)]);
+                }
+                int lost = 0;
+                for (std::size_t v = 0; v < a.size; v++) {
+                    bool kept = false;
+                    for (std::size_t w = 0; w < b.size; w++) {
+                        kept = kept || a.midi[v] % 12 == b.midi[w] % 12;
+                    }
+                    lost += kept ? 0 : 1;
+                }
+                total += std::abs(a.top() - b.top()) + motion + 2 * lost;
+            }
+            return total;
+        };
+
+        int best = std::numeric_limits<int>::max();
+        std::vector<std::size_t> path(4);
+        for (path[0] = 0; path[0] < candidates[0].size(); path[0]++)
+        for (path[1] = 0; path[1] < candidates[1].size(); path[1]++)
+        for (path[2] = 0; path[2] < candidates[2].size(); path[2]++)
+        for (path[3] = 0; path[3] < candidates[3].size(); path[3]++) {
+            best = std::min(best, pathCost(path));
+        }
+        CHECK(pathCost(chosen) == best);
+    }
+
+    SUBCASE("custom cost") {
+        const std::vector<std::vector<Voicing>> candidates = {
+            {fromNames({"C4", "E4"}), fromNames({"G4", "B4"})},
+            {fromNames({"A4", "C5"}), fromNames({"A3", "C4"})}
+        };
+        // Prefer moving the bass as much as possible
+        const TransitionCost cost = [](const Voicing& a, const Voicing& b) {
+            return -std::abs(a.bass() - b.bass());
+        };
+        CHECK(sequenceOptimal(candidates, cost) == std::vector<std::size_t>{1, 1});
+    }
+
+    SUBCASE("voice leading metrics") {
+        const std::vector<std::vector<Voicing>> candidates = {
+            {fromNames({"C4", "E4"}), fromNames({"G4", "B4"})},
+            {fromNames({"A4", "C5"}), fromNames({"A3", "C4"})}
+        };
+        CHECK(sequenceOptimal(candidates, Bass()) == std::vector<std::size_t>{1, 0});
+        CHECK(sequenceOptimal(candidates, TopNote(), fromNames({"C5"})) == std::vector<std::size_t>{1, 0});
+        const SequenceWeights weights{1, 1, 2};
+        auto metric = sum(TopNote(), TotalMotion(), weighted(2, LostCommonTones()));
+        CHECK(sequenceOptimal(candidates, metric) == sequenceOptimal(candidates, weights));
+    }
+
+    SUBCASE("chords without voicings break the sequence") {
+        const std::vector<std::vector<Voicing>> candidates = {
+            {fromNames({"C4", "E4"}), fromNames({"G4", "B4"})},
+            {},
+            {fromNames({"A4", "C5"}), fromNames({"A3", "C4"})}
+        };
+        auto chosen = sequenceOptimal(candidates);
+        CHECK(chosen == std::vector<std::size_t>{0, NO_VOICING, 0});
+        CHECK(sequenceOptimal(std::vector<std::vector<Voicing>>()).empty());
+    }
+
+    SUBCASE("chord names") {
+        auto result = sequenceOptimal({"C", "F", "G"}, {"F3", "A4"}, triads,
+                                      SequenceWeights(), {"C4", "E4", "G4"});
+        REQUIRE(result.size() == 3);
+        CHECK(result[0] == std::vector<std::string>{"C4", "E4", "G4"});
+        CHECK(result[1] == std::vector<std::string>{"A3", "C4", "F4"});
+        CHECK(result[2] == std::vector<std::string>{"B3", "D4", "G4"});
+        CHECK(sequenceOptimal({"C", "blah"}, {"F3", "A4"}, triads)[1].empty());
+    }
+}
+
+TEST_CASE("Voicing batch") {
+    const std::vector<std::vector<std::string>> progressions = {
+        {"Dm7", "G7", "C^7"},
+        {"C", "F", "G", "C"},
+        {},
+        {"Am7", "blah", "D7", "Gm7", "C7", "F^7"},
+        {"Bb^7", "Ebm7", "Ab7", "Db^7"}
+    };
+    const CompiledDictionary dictionary(all);
+    const std::vector<std::string> range = {"E3", "G5"};
+
+    SUBCASE("same as sequence") {
+        tonalcpp::thread_pool::ThreadPool pool(3);
+        auto result = sequenceBatch(progressions.data(), progressions.size(), range, dictionary, pool);
+        REQUIRE(result.size() == progressions.size());
+        for (std::size_t i = 0; i < progressions.size(); i++) {
+            CHECK(result.names(i) == sequence(progressions[i], range, all, topNoteDiff));
+        }
+        CHECK(result.end(2) == result.begin(2));
+    }
+
+    SUBCASE("same as sequenceOptimal") {
+        tonalcpp::thread_pool::ThreadPool pool(2);
+        const SequenceWeights weights{1, 1, 2};
+        auto result = sequenceOptimalBatch(progressions.data(), progressions.size(), range,
+                                           dictionary, pool, weights);
+        for (std::size_t i = 0; i < progressions.size(); i++) {
+            CHECK(result.names(i) == sequenceOptimal(progressions[i], range, all, weights));
+        }
+    }
+
+    SUBCASE("deterministic") {
+        std::vector<std::vector<std::string>> many;
+        for (int i = 0; i < 50; i++) {
+            many.insert(many.end(), progressions.begin(), progressions.end());
+        }
+        tonalcpp::thread_pool::ThreadPool one(1);
+        tonalcpp::thread_pool::ThreadPool four(4);
+        auto a = sequenceOptimalBatch(many.data(), many.size(), range, dictionary, one);
+        auto b = sequenceOptimalBatch(many.data(), many.size(), range, dictionary, four);
+        CHECK(a.offsets == b.offsets);
+        CHECK(a.voicings == b.voicings);
+    }
+}
@@ -0,0 +1,139 @@
+#include "doctest.h"
+#include "tonalcpp/voicing_cache.h"
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace tonalcpp;
+using namespace tonalcpp::voicing_cache;
+
+TEST_CASE("VoicingCache searchMidi") {
+    SUBCASE("same results as voicing::searchMidi") {
+        VoicingCache cache;
+        for (const std::string chord : {"C^7", "Dm7", "G7", "F#m7b5", "Ebo7"}) {
+            const auto expected = voicing::searchMidi(chord, {"E3", "G5"}, voicing_dictionary::all);
+            CHECK(*cache.searchMidi(chord, {"E3", "G5"}, voicing_dictionary::all) == expected);
+            CHECK(*cache.searchMidi(chord, {"E3", "G5"}, voicing_dictionary::all) == expected);
+        }
+        const auto stats = cache.stats();
+        CHECK(stats.hits == 5);
+        CHECK(stats.misses == 5);
+        CHECK(stats.size == 5);
+        CHECK(stats.hitRate() == doctest::Approx(0.5));
+    }
+
+    SUBCASE("aliases share entries") {
+        VoicingCache cache;
+        auto a = cache.searchMidi("Cm7", {"C3", "C5"}, voicing_dictionary::lefthand);
+        auto b = cache.searchMidi("C-7", {"C3", "C5"}, voicing_dictionary::lefthand);
+        CHECK(a.get() == b.get());
+        CHECK(cache.stats().hits == 1);
+    }
+
+    SUBCASE("keys") {
+        VoicingCache cache;
+        cache.searchMidi("C", {"C3", "C5"}, voicing_dictionary::triads);
+        cache.searchMidi("B#", {"C3", "C5"}, voicing_dictionary::triads);
+        cache.searchMidi("C", {"C3", "C6"}, voicing_dictionary::triads);
+        cache.searchMidi("C", {"C3", "C5"}, voicing_dictionary::all);
+        CHECK(cache.stats().hits == 0);
+        CHECK(cache.stats().size == 4);
+    }
+
+    SUBCASE("not cached") {
+        VoicingCache cache;
+        CHECK(cache.searchMidi("blah", {"C3", "C5"})->empty());
+        CHECK(cache.searchMidi("C", {"C3", "blah"})->empty());
+        CHECK(*cache.searchMidi("C", {"C3", "C4", "C5"}) ==
+              voicing::searchMidi("C", {"C3", "C4", "C5"}));
+        CHECK(cache.stats().size == 0);
+        CHECK(cache.stats().misses == 3);
+    }
+
+    SUBCASE("least recently used are evicted") {
+        VoicingCache cache(2);
+        auto c = cache.searchMidi("C");
+        cache.searchMidi("D");
+        cache.searchMidi("C");
+        cache.searchMidi("E");
+        CHECK(cache.stats().evictions == 1);
+        CHECK(cache.stats().size == 2);
+        CHECK(cache.searchMidi("C").get() == c.get());
+        cache.searchMidi("D");
+        CHECK(cache.stats().hits == 2);
+        CHECK(cache.stats().evictions == 2);
+    }
+
+    SUBCASE("invalidate a dictionary") {
+        VoicingCache cache;
+        voicing_dictionary::VoicingDictionary custom = {{"M", {"1P 3M 5P"}}};
+        CHECK(cache.searchMidi("C", {"C3", "C5"}, custom)->size() == 2);
+        custom["M"] = {"5P 8P 10M"};
+        cache.invalidate(custom);
+        CHECK(cache.searchMidi("C", {"C3", "C5"}, custom)->size() == 1);
+        CHECK(cache.stats().hits == 0);
+    }
+
+    SUBCASE("dictionaries are found by address") {
+        VoicingCache cache(2);
+        std::optional<voicing_dictionary::VoicingDictionary> custom;
+        custom.emplace(voicing_dictionary::VoicingDictionary{{"M", {"1P 3M 5P"}}});
+        CHECK(cache.searchMidi("C", {"C3", "C5"}, *custom)->size() == 2);
+        CHECK(cache.searchMidi("C", {"C3", "C5"}, *custom)->size() == 2);
+        CHECK(cache.stats().hits == 1);
+
+        // A dictionary with another number of entries is compiled again
+        (*custom)["m"] = {"1P 3m 5P"};
+        CHECK(cache.searchMidi("C", {"C3", "C5"}, *custom)->size() == 2);
+        CHECK(cache.searchMidi("Cm", {"C3", "C5"}, *custom)->size() == 2);
+        CHECK(cache.stats().hits == 1);
+
+        // Another dictionary at the same address, after invalidate
+        cache.invalidate(*custom);
+        custom.reset();
+        custom.emplace(voicing_dictionary::VoicingDictionary{{"M", {"3M 5P 8P", "5P 8P 10M"}}});
+        CHECK(cache.searchMidi("C", {"C3", "C5"}, *custom)->size() == 3);
+        CHECK(cache.stats().size == 1);
+
+        // Evicting the candidates of a dictionary drops its compiled copy
+        cache.searchMidi("C", {"C3", "C5"}, voicing_dictionary::triads);
+        cache.searchMidi("D", {"C3", "C5"}, voicing_dictionary::triads);
+        CHECK(cache.searchMidi("C", {"C3", "C5"}, *custom)->size() == 3);
+        CHECK(cache.stats().hits == 1);
+    }
+
+    SUBCASE("clear and reset") {
+        VoicingCache cache;
+        cache.searchMidi("C");
+        cache.searchMidi("C");
+        cache.resetStats();
+        CHECK(cache.stats().hits == 0);
+        CHECK(cache.stats().size == 1);
+        cache.clear();
+        CHECK(cache.stats().size == 0);
+    }
+
+    SUBCASE("threads") {
+        VoicingCache cache(4);
+        const std::vector<std::string> chords = {"C^7", "Dm7", "G7", "Am7", "F^7", "E7"};
+        std::vector<std::thread> threads;
+        std::vector<int> mismatches(4, 0);
+        for (int t = 0; t < 4; t++) {
+            threads.emplace_back([&, t]() {
+                for (int i = 0; i < 200; i++) {
+                    const auto& chord = chords[(i + t) % chords.size()];
+                    const auto result = cache.searchMidi(chord, {"E3", "G5"}, voicing_dictionary::all);
+                    if (result->empty()) mismatches[t]++;
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        CHECK(mismatches == std::vector<int>(4, 0));
+        const auto stats = cache.stats();
+        CHECK(stats.hits + stats.misses == 800);
+        CHECK(stats.size <= 4);
+    }
+}
@@ -1,5 +1,6 @@
 #include "doctest.h"
 #include "tonalcpp/voicing_dictionary.h"
+#include "tonalcpp/chord_type.h"
 #include <vector>
 #include <string>
 
@@ -32,4 +33,125 @@ TEST_CASE("VoicingDictionary lookup") {
         auto result = lookup("nonexistent", triads);
         CHECK_FALSE(result.has_value());
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("VoicingDictionary compilePattern") {
+    SUBCASE("relative to the bottom note") {
+        auto pattern = compilePattern("3m 5P 7m 9M");
+        CHECK(pattern.size == 4);
+        CHECK(pattern.bottomSemitones == 3);
+        CHECK(pattern.bottomFifths == -3);
+        CHECK(pattern.semitones[0] == 0);
+        CHECK(pattern.semitones[1] == 4);
+        CHECK(pattern.semitones[3] == 11);
+        CHECK(pattern.fifths[1] == 4);
+        CHECK(pattern.fifths[3] == 5);
+    }
+
+    SUBCASE("invalid patterns") {
+        CHECK(compilePattern("").size == 0);
+        CHECK(compilePattern("1P blah").size == 0);
+        CHECK(compilePattern("1P 2M 3M 4P 5P 6M 7M 8P 9M").size == 0);
+    }
+}
+
+TEST_CASE("VoicingDictionary CompiledDictionary") {
+    const CompiledDictionary compiled(lefthand);
+
+    SUBCASE("find by symbol") {
+        auto patterns = compiled.find("m7");
+        REQUIRE(patterns.size() == 2);
+        CHECK(*patterns.begin() == compilePattern("3m 5P 7m 9M"));
+        CHECK(compiled.find("nonexistent").empty());
+    }
+
+    SUBCASE("find by alias") {
+        auto patterns = compiled.find("-7");
+        REQUIRE(patterns.size() == 2);
+        CHECK(*patterns.begin() == compilePattern("3m 5P 7m 9M"));
+    }
+
+    SUBCASE("find by chord type id") {
+        const int minor7 = tonalcpp::chord_type::getChordType("m7").setNum;
+        auto patterns = compiled.find(minor7);
+        REQUIRE(patterns.size() == 2);
+        CHECK(*patterns.begin() == compilePattern("3m 5P 7m 9M"));
+        CHECK(compiled.find(12345).empty());
+    }
+
+    SUBCASE("round trip") {
+        CHECK(compiled.size() == lefthand.size());
+        CHECK(compiled.toDictionary() == lefthand);
+        CHECK(CompiledDictionary(triads).symbols() == std::vector<std::string>{"M", "aug", "m", "o"});
+    }
+
+    SUBCASE("all merges triads and lefthand") {
+        CHECK(all.size() == triads.size() + lefthand.size());
+        CHECK(all.at("M") == triads.at("M"));
+        CHECK(all.at("m7") == lefthand.at("m7"));
+    }
+
+    SUBCASE("built-in dictionaries") {
+        REQUIRE(builtin(triads) != nullptr);
+        CHECK(builtin(triads) == builtin(triads));
+        CHECK(builtin(triads)->toDictionary() == triads);
+        VoicingDictionary custom = triads;
+        CHECK(builtin(custom) == nullptr);
+    }
+
+    SUBCASE("parse text") {
+        auto parsed = parseDictionary(
+            "# comment\n"
+            "m7 = 3m 5P 7m 9M | 7m 9M 10m 12P\n"
+            "\n"
+            "M = 1P 3M 5P\n");
+        REQUIRE(parsed.size() == 2);
+        CHECK(parsed.find("m7").size() == 2);
+        CHECK(parsed.toDictionary().at("M") == std::vector<std::string>{"1P 3M 5P"});
+    }
+
+    SUBCASE("parse invalid text") {
+        CHECK(parseDictionary("m7 3m 5P 7m 9M").empty());
+        CHECK(parseDictionary("m7 = 3m blah").empty());
+        CHECK(loadDictionary("/nonexistent/voicings.txt").empty());
+    }
+}
+
+TEST_CASE("VoicingDictionary alias resolution") {
+    const CompiledDictionary compiled(lefthand);
+
+    SUBCASE("resolution table") {
+        const auto& table = compiled.resolutions();
+        const int minor7 = compiled.indexOf("m7");
+        REQUIRE(minor7 >= 0);
+        REQUIRE(table.count("-7") == 1);
+        CHECK(table.at("-7") == static_cast<std::uint32_t>(minor7));
+        CHECK(table.at("minor seventh") == static_cast<std::uint32_t>(minor7));
+        CHECK(table.count("blah") == 0);
+    }
+
+    SUBCASE("bulk") {
+        const std::vector<std::string> symbols = {"m7", "-7", "blah", "maj7", "dim7"};
+        std::vector<int> indexes(symbols.size());
+        compiled.indexOf(symbols.data(), symbols.size(), indexes.data());
+        CHECK(indexes[0] == indexes[1]);
+        CHECK(indexes[2] == -1);
+        CHECK(compiled.symbols()[indexes[3]] == "^7");
+        CHECK(compiled.symbols()[indexes[4]] == "o7");
+    }
+
+    SUBCASE("same as lookup") {
+        // Copies are not built-in, so they use the lookup without table
+        for (const auto* dictionary : {&triads, &lefthand, &all}) {
+            const VoicingDictionary copy = *dictionary;
+            std::vector<std::string> symbols = {"", "blah", "M", "m7b5"};
+            for (const auto& type : tonalcpp::chord_type::all()) {
+                symbols.push_back(type.name);
+                symbols.insert(symbols.end(), type.aliases.begin(), type.aliases.end());
+            }
+            for (const auto& symbol : symbols) {
+                CHECK(lookup(symbol, *dictionary) == lookup(symbol, copy));
+            }
+        }
+    }
+}
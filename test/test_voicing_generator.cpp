@@ -0,0 +1,96 @@
+#include "doctest.h"
+#include "tonalcpp/voicing_generator.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace tonalcpp;
+using namespace tonalcpp::voicing_generator;
+using tonalcpp::voicing::Voicing;
+
+// Pitch classes of a voicing as a 12 bit mask
+static unsigned chromas(const Voicing& voicing) {
+    unsigned mask = 0;
+    for (std::size_t i = 0; i < voicing.size; i++) {
+        mask |= 1u << (voicing[i] % 12);
+    }
+    return mask;
+}
+
+TEST_CASE("VoicingGenerator generateMidi") {
+    SUBCASE("follows the constraints") {
+        const Constraints constraints;
+        const auto voicings = generateMidi("Cmaj7", {"C3", "C5"}, constraints);
+        REQUIRE_FALSE(voicings.empty());
+        for (const auto& v : voicings) {
+            CHECK(v.size >= 3);
+            CHECK(v.size <= 4);
+            CHECK(v.bass() >= 48);
+            CHECK(v.top() <= 72);
+            CHECK(v.top() - v.bass() <= 19);
+            // E and B are required, C and G can be left out
+            CHECK((chromas(v) & (1u << 4)) != 0);
+            CHECK((chromas(v) & (1u << 11)) != 0);
+            CHECK((chromas(v) & ~0x891u) == 0);
+            for (std::size_t i = 1; i < v.size; i++) {
+                CHECK(v[i] > v[i - 1]);
+                if (v[i - 1] < 52) CHECK(v[i] - v[i - 1] >= 5);
+            }
+        }
+        CHECK(voicings.front().names() == std::vector<std::string>{"C3", "G3", "B3", "E4"});
+    }
+
+    SUBCASE("required tones") {
+        Constraints constraints;
+        constraints.omittable = {};
+        for (const auto& v : generateMidi("Dm7", {"C3", "C5"}, constraints)) {
+            CHECK(chromas(v) == ((1u << 2) | (1u << 5) | (1u << 9) | (1u << 0)));
+        }
+    }
+
+    SUBCASE("spelling and slash chords") {
+        const auto voicings = generate("Ebm7/Gb", {"C3", "C5"});
+        REQUIRE_FALSE(voicings.empty());
+        for (const auto& v : voicings) {
+            CHECK(v[0].substr(0, 2) == "Gb");
+        }
+        CHECK(voicings[0] == std::vector<std::string>{"Gb3", "Bb3", "Db4"});
+    }
+
+    SUBCASE("tensions are not doubled") {
+        Constraints constraints;
+        constraints.maxVoices = 6;
+        for (const auto& v : generateMidi("C9", {"C3", "C6"}, constraints)) {
+            CHECK(std::count_if(v.midi.begin(), v.midi.begin() + v.size,
+                                [](int m) { return m % 12 == 2; }) == 1);
+        }
+        constraints.doubleTensions = true;
+        const auto doubled = generateMidi("C9", {"C3", "C6"}, constraints);
+        CHECK(std::any_of(doubled.begin(), doubled.end(), [](const Voicing& v) {
+            return std::count_if(v.midi.begin(), v.midi.begin() + v.size,
+                                 [](int m) { return m % 12 == 2; }) > 1;
+        }));
+    }
+
+    SUBCASE("limit keeps the narrowest voicings") {
+        Constraints constraints;
+        constraints.minVoices = 5;
+        constraints.maxVoices = 6;
+        auto all = generateMidi("C13#11", {"C3", "C5"}, constraints);
+        std::stable_sort(all.begin(), all.end(), [](const Voicing& a, const Voicing& b) {
+            return a.top() - a.bass() < b.top() - b.bass();
+        });
+        constraints.limit = 5;
+        const auto best = generateMidi("C13#11", {"C3", "C5"}, constraints);
+        REQUIRE(best.size() == 5);
+        CHECK(std::equal(best.begin(), best.end(), all.begin()));
+        CHECK(best[0].names() == std::vector<std::string>{"D4", "E4", "F#4", "G4", "A4", "Bb4"});
+    }
+
+    SUBCASE("invalid input") {
+        CHECK(generateMidi("blah").empty());
+        CHECK(generateMidi("C", {"C3", "blah"}).empty());
+        CHECK(generateMidi("C/blah").empty());
+        CHECK(generateMidi("C", {}).empty());
+    }
+}